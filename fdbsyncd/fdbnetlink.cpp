@@ -0,0 +1,264 @@
+#include <string.h>
+#include <errno.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+
+#include "logger.h"
+#include "macaddress.h"
+#include "fdbsyncd/fdbnetlink.h"
+
+using namespace std;
+using namespace swss;
+
+FdbNetlink::FdbNetlink() :
+    m_seq(0)
+{
+    int err = 0;
+
+    m_sock = nl_socket_alloc();
+    if (!m_sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket alloc failed");
+        return;
+    }
+
+    if ((err = nl_connect(m_sock, NETLINK_ROUTE)) < 0)
+    {
+        SWSS_LOG_ERROR("Netlink socket connect failed, error '%s'", nl_geterror(err));
+        nl_socket_free(m_sock);
+        m_sock = NULL;
+        return;
+    }
+
+    if ((err = nl_socket_set_buffer_size(m_sock, FDB_NETLINK_RCVBUF_SIZE, FDB_NETLINK_RCVBUF_SIZE)) < 0)
+    {
+        SWSS_LOG_WARN("Netlink socket buffer size set failed, error '%s'", nl_geterror(err));
+    }
+
+    m_batch.reserve(FDB_NETLINK_BATCH_SIZE);
+}
+
+FdbNetlink::~FdbNetlink()
+{
+    if (m_sock)
+    {
+        flush();
+        nl_socket_free(m_sock);
+    }
+}
+
+void FdbNetlink::replaceFdb(const string &mac, const string &port, const string &type, int vlan)
+{
+    queue(RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_REPLACE, mac, port, type, true, vlan, "");
+}
+
+void FdbNetlink::delFdb(const string &mac, const string &port, const string &type, int vlan)
+{
+    queue(RTM_DELNEIGH, 0, mac, port, type, true, vlan, "");
+}
+
+void FdbNetlink::delVxlanFdb(const string &mac, const string &ifname, const string &vtep, int vlan)
+{
+    queue(RTM_DELNEIGH, 0, mac, ifname, "", false, vlan, vtep);
+}
+
+struct nl_msg *FdbNetlink::buildMessage(int type, int flags, const string &mac, unsigned int ifindex,
+                                        const string &fdbType, bool master, int vlan,
+                                        const string &vtep, uint32_t seq)
+{
+    uint8_t binMac[ETHER_ADDR_LEN];
+    uint8_t dst[sizeof(struct in6_addr)];
+    size_t dstLen = 0;
+
+    if (vlan <= 0 || vlan > 4095)
+    {
+        SWSS_LOG_ERROR("Invalid vlan %d for FDB %s on ifindex %u", vlan, mac.c_str(), ifindex);
+        return NULL;
+    }
+
+    if (!MacAddress::parseMacString(mac, binMac))
+    {
+        SWSS_LOG_ERROR("Invalid MAC %s for FDB on ifindex %u vlan %d", mac.c_str(), ifindex, vlan);
+        return NULL;
+    }
+
+    /* NDA_DST holds the address of the VTEP family, as with the bridge command */
+    if (!vtep.empty())
+    {
+        if (inet_pton(AF_INET, vtep.c_str(), dst) == 1)
+        {
+            dstLen = sizeof(struct in_addr);
+        }
+        else if (inet_pton(AF_INET6, vtep.c_str(), dst) == 1)
+        {
+            dstLen = sizeof(struct in6_addr);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Invalid VTEP %s for FDB %s vlan %d", vtep.c_str(), mac.c_str(), vlan);
+            return NULL;
+        }
+    }
+
+    struct nl_msg *msg = nlmsg_alloc();
+    if (!msg)
+    {
+        SWSS_LOG_ERROR("Netlink message alloc failed for FDB %s vlan %d", mac.c_str(), vlan);
+        return NULL;
+    }
+
+    struct nlmsghdr *hdr = nlmsg_put(msg, NL_AUTO_PORT, seq, type, sizeof(struct ndmsg), NLM_F_REQUEST | flags);
+    if (!hdr)
+    {
+        SWSS_LOG_ERROR("Netlink message header alloc failed for FDB %s vlan %d", mac.c_str(), vlan);
+        nlmsg_free(msg);
+        return NULL;
+    }
+
+    /* Same ndmsg as the bridge fdb command */
+    struct ndmsg *ndm = static_cast<struct ndmsg *>(nlmsg_data(hdr));
+    memset(ndm, 0, sizeof(struct ndmsg));
+    ndm->ndm_family = PF_BRIDGE;
+    ndm->ndm_ifindex = ifindex;
+    ndm->ndm_flags = master ? NTF_MASTER : NTF_SELF;
+    ndm->ndm_state = NUD_NOARP;
+    if (fdbType == "static")
+    {
+        ndm->ndm_state |= NUD_REACHABLE;
+    }
+    else if (fdbType == "dynamic")
+    {
+        ndm->ndm_state = NUD_REACHABLE;
+    }
+
+    uint16_t vid = static_cast<uint16_t>(vlan);
+    if (nla_put(msg, NDA_LLADDR, ETHER_ADDR_LEN, binMac) < 0 ||
+        nla_put(msg, NDA_VLAN, sizeof(vid), &vid) < 0 ||
+        (dstLen && nla_put(msg, NDA_DST, static_cast<int>(dstLen), dst) < 0))
+    {
+        SWSS_LOG_ERROR("Netlink attribute put failed for FDB %s vlan %d", mac.c_str(), vlan);
+        nlmsg_free(msg);
+        return NULL;
+    }
+
+    return msg;
+}
+
+void FdbNetlink::queue(int type, int flags, const string &mac, const string &ifname,
+                       const string &fdbType, bool master, int vlan, const string &vtep)
+{
+    if (!m_sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket not available, FDB %s vlan %d on %s not programmed",
+                       mac.c_str(), vlan, ifname.c_str());
+        return;
+    }
+
+    unsigned int ifindex = if_nametoindex(ifname.c_str());
+    if (!ifindex)
+    {
+        SWSS_LOG_INFO("Failed to get ifindex of %s for FDB %s vlan %d", ifname.c_str(), mac.c_str(), vlan);
+        return;
+    }
+
+    struct nl_msg *msg = buildMessage(type, flags, mac, ifindex, fdbType, master, vlan, vtep, m_seq + 1);
+    if (!msg)
+    {
+        return;
+    }
+    m_seq++;
+
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+    if (m_batch.size() + hdr->nlmsg_len > FDB_NETLINK_BATCH_SIZE)
+    {
+        flush();
+    }
+
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(hdr);
+    m_batch.insert(m_batch.end(), data, data + NLMSG_ALIGN(hdr->nlmsg_len));
+
+    SWSS_LOG_INFO("Queued FDB %s %s dev %s vlan %d %s seq %u",
+                  type == RTM_NEWNEIGH ? "replace" : "del", mac.c_str(), ifname.c_str(), vlan,
+                  vtep.empty() ? fdbType.c_str() : vtep.c_str(), m_seq);
+
+    nlmsg_free(msg);
+}
+
+void FdbNetlink::flush()
+{
+    if (!m_sock)
+    {
+        return;
+    }
+
+    if (!m_batch.empty())
+    {
+        int err = nl_sendto(m_sock, m_batch.data(), m_batch.size());
+        if (err < 0)
+        {
+            SWSS_LOG_ERROR("Netlink send of %zu bytes of FDB requests failed, error '%s'",
+                           m_batch.size(), nl_geterror(err));
+        }
+        m_batch.clear();
+    }
+
+    readErrors();
+}
+
+void FdbNetlink::readErrors()
+{
+    vector<uint8_t> buf(FDB_NETLINK_BATCH_SIZE);
+
+    while (true)
+    {
+        ssize_t len = recv(nl_socket_get_fd(m_sock), buf.data(), buf.size(), MSG_DONTWAIT);
+        if (len < 0)
+        {
+            if (errno == ENOBUFS)
+            {
+                SWSS_LOG_WARN("Netlink receive buffer overrun, FDB request errors were lost");
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                SWSS_LOG_ERROR("Netlink receive failed, error '%s'", strerror(errno));
+            }
+            return;
+        }
+
+        int remaining = static_cast<int>(len);
+        for (struct nlmsghdr *hdr = reinterpret_cast<struct nlmsghdr *>(buf.data());
+             NLMSG_OK(hdr, remaining); hdr = NLMSG_NEXT(hdr, remaining))
+        {
+            if (hdr->nlmsg_type != NLMSG_ERROR ||
+                hdr->nlmsg_len < NLMSG_LENGTH(sizeof(struct nlmsgerr)))
+            {
+                continue;
+            }
+
+            const struct nlmsgerr *err = static_cast<const struct nlmsgerr *>(NLMSG_DATA(hdr));
+            if (!err->error)
+            {
+                continue;
+            }
+
+            /* The kernel echoes the failed request after the error */
+            int ifindex = 0;
+            if (hdr->nlmsg_len >= NLMSG_LENGTH(sizeof(struct nlmsgerr) + sizeof(struct ndmsg)))
+            {
+                const struct ndmsg *ndm = reinterpret_cast<const struct ndmsg *>(NLMSG_DATA(&err->msg));
+                ifindex = ndm->ndm_ifindex;
+            }
+
+            SWSS_LOG_INFO("Kernel FDB %s seq %u on ifindex %d failed, error '%s'",
+                          err->msg.nlmsg_type == RTM_NEWNEIGH ? "replace" : "del",
+                          err->msg.nlmsg_seq, ifindex, strerror(-err->error));
+        }
+    }
+}
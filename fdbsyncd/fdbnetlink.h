@@ -0,0 +1,64 @@
+#ifndef __FDBNETLINK__
+#define __FDBNETLINK__
+
+#include <string>
+#include <vector>
+#include <netlink/netlink.h>
+
+/*
+ * Size of the netlink requests sent in a single sendmsg, and of the receive
+ * buffer holding the errors returned by the kernel until they are read
+ */
+#define FDB_NETLINK_BATCH_SIZE  (64 * 1024)
+#define FDB_NETLINK_RCVBUF_SIZE (4 * 1024 * 1024)
+
+namespace swss {
+
+/*
+ * Programs the kernel FDB over a persistent NETLINK_ROUTE socket, with the
+ * RTM_NEWNEIGH/RTM_DELNEIGH requests the bridge fdb command would send.
+ *
+ * The requests are queued and sent together, many per sendmsg, when the
+ * batch is full or on flush(). They are sent without NLM_F_ACK: the kernel
+ * only answers the requests which failed, and these errors are read without
+ * blocking on the next flush() and logged, as a failed bridge command was.
+ */
+class FdbNetlink
+{
+public:
+    FdbNetlink();
+    ~FdbNetlink();
+
+    /* bridge fdb replace <mac> dev <port> master <type> vlan <vlan> */
+    void replaceFdb(const std::string &mac, const std::string &port, const std::string &type, int vlan);
+
+    /* bridge fdb del <mac> dev <port> master <type> vlan <vlan> */
+    void delFdb(const std::string &mac, const std::string &port, const std::string &type, int vlan);
+
+    /* bridge fdb del <mac> dev <vxlan interface> dst <vtep> vlan <vlan> */
+    void delVxlanFdb(const std::string &mac, const std::string &ifname, const std::string &vtep, int vlan);
+
+    void flush();
+
+    /*
+     * Builds the request for an FDB entry on the interface of index ifindex,
+     * null if the entry is invalid. The VTEP is an IPv4 or IPv6 address, or
+     * empty. The caller frees the message.
+     */
+    static struct nl_msg *buildMessage(int type, int flags, const std::string &mac, unsigned int ifindex,
+                                       const std::string &fdbType, bool master, int vlan,
+                                       const std::string &vtep, uint32_t seq);
+
+private:
+    struct nl_sock *m_sock;
+    std::vector<uint8_t> m_batch;
+    uint32_t m_seq;
+
+    void queue(int type, int flags, const std::string &mac, const std::string &ifname,
+               const std::string &fdbType, bool master, int vlan, const std::string &vtep);
+    void readErrors();
+};
+
+}
+
+#endif
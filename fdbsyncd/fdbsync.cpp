@@ -11,7 +11,6 @@
 #include "ipaddress.h"
 #include "netmsg.h"
 #include "macaddress.h"
-#include "exec.h"
 #include "fdbsync.h"
 #include "warm_restart.h"
 #include "errno.h"
@@ -277,20 +276,27 @@ void FdbSync::macDelVxlanEntry(string auxkey, struct m_fdb_info *info)
 {
     std::string vtep = m_mac[auxkey].vtep;
 
-    const std::string cmds = std::string("")
-        + " bridge fdb del " + info->mac + " dev " 
-        + m_mac[auxkey].ifname + " dst " + vtep + " vlan " + info->vid.substr(4);
+    m_fdbNetlink.delVxlanFdb(info->mac, m_mac[auxkey].ifname, vtep, atoi(info->vid.substr(4).c_str()));
 
-    std::string res;
-    int ret = swss::exec(cmds, res);
-    if (ret != 0)
+    return;
+}
+
+void FdbSync::kernelFdbUpdate(const string &op, const string &mac, const string &port_name,
+                              const string &type, int vlan)
+{
+    if (op == "del")
     {
-        SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        m_fdbNetlink.delFdb(mac, port_name, type, vlan);
     }
+    else
+    {
+        m_fdbNetlink.replaceFdb(mac, port_name, type, vlan);
+    }
+}
 
-    SWSS_LOG_INFO("Success cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-
-    return;
+void FdbSync::flushKernelFdb()
+{
+    m_fdbNetlink.flush();
 }
 
 void FdbSync::updateLocalMac (struct m_fdb_info *info)
@@ -338,14 +344,7 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
         type = "static";
     }
 
-    const std::string cmds = std::string("")
-        + " bridge fdb " + op + " " + info->mac + " dev " 
-        + port_name + " master " + type + " vlan " + info->vid.substr(4);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-
-    SWSS_LOG_INFO("cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+    kernelFdbUpdate(op, info->mac, port_name, type, atoi(info->vid.substr(4).c_str()));
 
     return;
 }
@@ -387,18 +386,9 @@ void FdbSync::addLocalMac(string key, string op)
             type = "static";
         }
 
-        const std::string cmds = std::string("")
-                + " bridge fdb " + op + " " + mac + " dev "
-                + port_name + " master " + type  + " vlan " + vlan;
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
-        {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-        }
-
-        SWSS_LOG_INFO("Config triggered cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        SWSS_LOG_INFO("Config triggered FDB %s MAC:%s port:%s type:%s vlan:%s",
+                      op.c_str(), mac.c_str(), port_name.c_str(), type, vlan.c_str());
+        kernelFdbUpdate(op, mac, port_name, type, atoi(vlan.c_str()));
     }
     return;
 }
@@ -435,14 +425,7 @@ void FdbSync::updateMclagRemoteMac (struct m_fdb_info *info)
         type = "static";
     }
 
-    const std::string cmds = std::string("")
-        + " bridge fdb " + op + " " + info->mac + " dev "
-        + port_name + " master " + type + " vlan " + info->vid.substr(4);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-
-    SWSS_LOG_INFO("cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+    kernelFdbUpdate(op, info->mac, port_name, type, atoi(info->vid.substr(4).c_str()));
 
     return;
 }
@@ -463,19 +446,8 @@ void FdbSync::updateMclagRemoteMacPort(int ifindex, int vlan, std::string mac)
 
         if (type == FDB_TYPE_STATIC)
         {
-            const std::string cmds = std::string("")
-                + " bridge fdb replace" + " " + mac + " dev "
-                + port_name + " master static vlan " + to_string(vlan);
-
-            std::string res;
-            int ret = swss::exec(cmds, res);
-            if (ret != 0)
-            {
-                SWSS_LOG_NOTICE("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-                return;
-            }
-
-            SWSS_LOG_NOTICE("Update cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+            SWSS_LOG_NOTICE("Update FDB MAC:%s port:%s static vlan:%d", mac.c_str(), port_name.c_str(), vlan);
+            m_fdbNetlink.replaceFdb(mac, port_name, "static", vlan);
         }
     }
     return;
@@ -514,18 +486,8 @@ void FdbSync::macRefreshStateDB(int vlan, string kmac)
             type = "static";
         }
 
-        const std::string cmds = std::string("")
-            + " bridge fdb " + "replace" + " " + kmac + " dev "
-            + port_name + " master " + type  + " vlan " + to_string(vlan);
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
-        {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-        }
-
-        SWSS_LOG_INFO("Refreshing cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        SWSS_LOG_INFO("Refreshing FDB MAC:%s port:%s type:%s vlan:%d", kmac.c_str(), port_name.c_str(), type, vlan);
+        m_fdbNetlink.replaceFdb(kmac, port_name, type, vlan);
     }
     return;
 }
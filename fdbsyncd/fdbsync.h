@@ -8,6 +8,7 @@
 #include "subscriberstatetable.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
+#include "fdbsyncd/fdbnetlink.h"
 
 /*
  * Default timer interval for fdbsyncd reconcillation 
@@ -80,6 +81,9 @@ public:
 
     void processCfgEvpnNvo();
 
+    /* Send the kernel FDB updates queued while processing the last events */
+    void flushKernelFdb();
+
     bool m_reconcileDone = false;
 
     bool m_isEvpnNvoExist = false;
@@ -91,6 +95,7 @@ private:
     SubscriberStateTable m_mclagRemoteFdbStateTable;
     AppRestartAssist  *m_AppRestartAssist;
     SubscriberStateTable m_cfgEvpnNvoTable;
+    FdbNetlink m_fdbNetlink;
 
     struct m_local_fdb_info
     {
@@ -113,6 +118,9 @@ private:
 
     void macRefreshStateDB(int vlan, std::string kmac);
 
+    void kernelFdbUpdate(const std::string &op, const std::string &mac, const std::string &port_name,
+                         const std::string &type, int vlan);
+
     void updateMclagRemoteMac(struct m_fdb_info *info);
 
     void updateMclagRemoteMacPort(int ifindex, int vlan, std::string mac);
@@ -148,6 +148,8 @@ int main(int argc, char **argv)
                         }
                     }
                 }
+
+                sync.flushKernelFdb();
             }
         }
         catch (const std::exception& e)
@@ -740,20 +740,20 @@ bool AclRule::validateAddMatch(string attr_name, string attr_value)
 
             for (auto alias : ports)
             {
-                Port port;
-                if (!gPortsOrch->getPort(alias, port))
+                const Port *port = gPortsOrch->findPort(alias);
+                if (!port)
                 {
                     SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
                     return false;
                 }
 
-                if (port.m_type != Port::PHY)
+                if (port->m_type != Port::PHY)
                 {
                     SWSS_LOG_ERROR("Cannot bind rule to %s: IN_PORTS can only match physical interfaces", alias.c_str());
                     return false;
                 }
 
-                inPorts.push_back(port.m_port_id);
+                inPorts.push_back(port->m_port_id);
             }
 
             matchData.data.objlist.count = static_cast<uint32_t>(inPorts.size());
@@ -770,20 +770,20 @@ bool AclRule::validateAddMatch(string attr_name, string attr_value)
 
             for (auto alias : ports)
             {
-                Port port;
-                if (!gPortsOrch->getPort(alias, port))
+                const Port *port = gPortsOrch->findPort(alias);
+                if (!port)
                 {
                     SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
                     return false;
                 }
 
-                if (port.m_type != Port::PHY)
+                if (port->m_type != Port::PHY)
                 {
                     SWSS_LOG_ERROR("Cannot bind rule to %s: OUT_PORTS can only match physical interfaces", alias.c_str());
                     return false;
                 }
 
-                outPorts.push_back(port.m_port_id);
+                outPorts.push_back(port->m_port_id);
             }
 
             matchData.data.objlist.count = static_cast<uint32_t>(outPorts.size());
@@ -1745,16 +1745,16 @@ sai_object_id_t AclRulePacket::getRedirectObjectId(const string& redirect_value)
     string target = redirect_value;
 
     // Try to parse physical port and LAG first
-    Port port;
-    if (gPortsOrch->getPort(target, port))
+    const Port *port = gPortsOrch->findPort(target);
+    if (port)
     {
-        if (port.m_type == Port::PHY)
+        if (port->m_type == Port::PHY)
         {
-            return port.m_port_id;
+            return port->m_port_id;
         }
-        else if (port.m_type == Port::LAG)
+        else if (port->m_type == Port::LAG)
         {
-            return port.m_lag_id;
+            return port->m_lag_id;
         }
         else
         {
@@ -2116,8 +2116,8 @@ bool AclTable::validateAddPorts(const unordered_set<string> &value)
 
     for (const auto &itAlias: value)
     {
-        Port port;
-        if (!gPortsOrch->getPort(itAlias, port))
+        const Port *port = gPortsOrch->findPort(itAlias);
+        if (!port)
         {
             SWSS_LOG_INFO(
                 "Add unready port %s to pending list for ACL table %s",
@@ -2128,7 +2128,7 @@ bool AclTable::validateAddPorts(const unordered_set<string> &value)
         }
 
         sai_object_id_t bindPortOid;
-        if (!AclOrch::getAclBindPortId(port, bindPortOid))
+        if (!AclOrch::getAclBindPortId(*port, bindPortOid))
         {
             SWSS_LOG_ERROR(
                 "Failed to get port %s bind port ID for ACL table %s",
@@ -3527,14 +3527,14 @@ bool AclOrch::updateAclTablePorts(AclTable &newTable, AclTable &curTable)
         }
         else if (curTable.portSet.find(p) != curTable.portSet.end())
         {
-            Port port;
-            if (!gPortsOrch->getPort(p, port))
+            const Port *port = gPortsOrch->findPort(p);
+            if (!port)
             {
                 SWSS_LOG_ERROR("Unable to retrieve OID for port %s", p.c_str());
                 continue;
             }
 
-            getAclBindPortId(port, port_oid);
+            getAclBindPortId(*port, port_oid);
             assert(port_oid != SAI_NULL_OBJECT_ID);
             assert(curTable.ports.find(port_oid) != curTable.ports.end());
             if (curTable.ports[port_oid] != SAI_NULL_OBJECT_ID)
@@ -3554,14 +3554,14 @@ bool AclOrch::updateAclTablePorts(AclTable &newTable, AclTable &curTable)
     {
         SWSS_LOG_NOTICE("Adding port %s to ACL list %s",
                         p.c_str(), curTable.id.c_str());
-        Port port;
-        if (!gPortsOrch->getPort(p, port))
+        const Port *port = gPortsOrch->findPort(p);
+        if (!port)
         {
             curTable.pendingPortSet.emplace(p);
             continue;
         }
 
-        if (!getAclBindPortId(port, port_oid))
+        if (!getAclBindPortId(*port, port_oid))
         {
             // We do NOT expect this to happen at all.
             // If at all happens, lets catch it here!
@@ -3621,6 +3621,7 @@ bool AclOrch::addAclTable(AclTable &newTable)
     {
         m_ctrlAclTables.emplace(table_id, newTable);
         SWSS_LOG_NOTICE("Created control plane ACL table %s", newTable.id.c_str());
+        wakeParkedTasks(table_id);
         return true;
     }
 
@@ -3690,6 +3691,7 @@ bool AclOrch::addAclTable(AclTable &newTable)
 
             SWSS_LOG_NOTICE("Created ACL table %s as a sibling of %s",
                     newTable.id.c_str(), orig_table_name.c_str());
+            wakeParkedTasks(table_id);
 
             return true;
         }
@@ -3711,6 +3713,9 @@ bool AclOrch::addAclTable(AclTable &newTable)
             m_mirrorV6TableId[table_stage] = table_id;
         }
 
+        /* Rules waiting for this table can be added now */
+        wakeParkedTasks(table_id);
+
         return true;
     }
     else
@@ -4278,7 +4283,7 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
                 }
 
                 SWSS_LOG_INFO("Wait for ACL table %s to be created", table_id.c_str());
-                it++;
+                it = consumer.park(it, table_id);
                 continue;
             }
 
@@ -4434,8 +4439,8 @@ bool AclOrch::processAclTablePorts(string portList, AclTable &aclTable)
 
     for (auto alias : ports)
     {
-        Port port;
-        if (!gPortsOrch->getPort(alias, port))
+        const Port *port = gPortsOrch->findPort(alias);
+        if (!port)
         {
             SWSS_LOG_INFO("Add unready port %s to pending list for ACL table %s",
                     alias.c_str(), aclTable.id.c_str());
@@ -4444,7 +4449,7 @@ bool AclOrch::processAclTablePorts(string portList, AclTable &aclTable)
         }
 
         sai_object_id_t bind_port_id;
-        if (!getAclBindPortId(port, bind_port_id))
+        if (!getAclBindPortId(*port, bind_port_id))
         {
             SWSS_LOG_ERROR("Failed to get port %s bind port ID for ACL table %s",
                     alias.c_str(), aclTable.id.c_str());
@@ -4705,7 +4710,7 @@ string AclOrch::generateAclRuleIdentifierInCountersDb(const AclRule& rule) const
     return rule.getTableId() + m_countersTable.getTableNameSeparator() + rule.getId();
 }
 
-bool AclOrch::getAclBindPortId(Port &port, sai_object_id_t &port_id)
+bool AclOrch::getAclBindPortId(const Port &port, sai_object_id_t &port_id)
 {
     SWSS_LOG_ENTER();
 
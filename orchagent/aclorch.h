@@ -497,7 +497,7 @@ public:
     void deregisterFlexCounter(const AclRule& rule);
 
     // Get the OID for the ACL bind point for a given port
-    static bool getAclBindPortId(Port& port, sai_object_id_t& port_id);
+    static bool getAclBindPortId(const Port& port, sai_object_id_t& port_id);
 
     using Orch::doTask;  // Allow access to the basic doTask
     map<sai_object_id_t, AclTable>  getAclTables()
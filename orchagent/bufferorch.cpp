@@ -36,6 +36,38 @@ type_map BufferOrch::m_buffer_type_maps = {
     {APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME, new object_reference_map()}
 };
 
+/*
+ * Buffers the writes of a producer table during its lifetime, they are sent
+ * to the DB in one pipeline flush when the scope is left, also by an exception.
+ */
+class ProducerTableBatch
+{
+public:
+    ProducerTableBatch(ProducerTable *table) : m_table(table)
+    {
+        m_table->setBuffered(true);
+    }
+
+    ~ProducerTableBatch()
+    {
+        m_table->setBuffered(false);
+        try
+        {
+            m_table->flush();
+        }
+        catch (const std::exception &e)
+        {
+            SWSS_LOG_ERROR("Failed to flush the writes of the flex counter table: %s", e.what());
+        }
+    }
+
+    ProducerTableBatch(const ProducerTableBatch&) = delete;
+    ProducerTableBatch& operator=(const ProducerTableBatch&) = delete;
+
+private:
+    ProducerTable *m_table;
+};
+
 map<string, string> buffer_to_ref_table_map = {
     {buffer_pool_field_name, APP_BUFFER_POOL_TABLE_NAME},
     {buffer_profile_field_name, APP_BUFFER_PROFILE_TABLE_NAME},
@@ -45,8 +77,9 @@ map<string, string> buffer_to_ref_table_map = {
 BufferOrch::BufferOrch(DBConnector *applDb, DBConnector *confDb, DBConnector *stateDb, vector<string> &tableNames) :
     Orch(applDb, tableNames),
     m_flexCounterDb(new DBConnector("FLEX_COUNTER_DB", 0)),
-    m_flexCounterTable(new ProducerTable(m_flexCounterDb.get(), FLEX_COUNTER_TABLE)),
-    m_flexCounterGroupTable(new ProducerTable(m_flexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE)),
+    m_flexCounterPipeline(new RedisPipeline(m_flexCounterDb.get())),
+    m_flexCounterTable(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE)),
+    m_flexCounterGroupTable(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_GROUP_TABLE)),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
     m_stateBufferMaximumValueTable(stateDb, STATE_BUFFER_MAXIMUM_VALUE_TABLE),
     m_ingressZeroBufferPool(SAI_NULL_OBJECT_ID),
@@ -276,7 +309,9 @@ void BufferOrch::generateBufferPoolWatermarkCounterIdList(void)
         m_flexCounterGroupTable->set(BUFFER_POOL_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, fvs);
     }
 
-    // Push buffer pool watermark COUNTER_ID_LIST to FLEX_COUNTER_TABLE on a per buffer pool basis
+    // Push buffer pool watermark COUNTER_ID_LIST to FLEX_COUNTER_TABLE on a per buffer pool basis,
+    // sent to the DB as one batch
+    ProducerTableBatch batch(m_flexCounterTable.get());
     vector<FieldValueTuple> fvTuples;
     fvTuples.emplace_back(BUFFER_POOL_COUNTER_ID_LIST, statList);
     bitMask = 1;
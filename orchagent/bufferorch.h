@@ -71,6 +71,7 @@ private:
     std::unordered_map<std::string, std::vector<std::string>> m_port_ready_list_ref;
 
     unique_ptr<DBConnector> m_flexCounterDb;
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
     unique_ptr<ProducerTable> m_flexCounterTable;
 
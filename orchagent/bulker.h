@@ -1,10 +1,12 @@
 #pragma once
 
 #include <assert.h>
+#include <numeric>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
+#include <tuple>
 #include <boost/functional/hash.hpp>
 #include <sairedis.h>
 #include "sai.h"
@@ -48,6 +50,40 @@ static inline bool operator==(const sai_inseg_entry_t& a, const sai_inseg_entry_
         ;
 }
 
+static inline bool operator==(const sai_ip_address_t& a, const sai_ip_address_t& b)
+{
+    if (a.addr_family != b.addr_family) return false;
+
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.addr.ip4 == b.addr.ip4;
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        return memcmp(a.addr.ip6, b.addr.ip6, sizeof(a.addr.ip6)) == 0;
+    }
+    else
+    {
+        throw std::invalid_argument("a has invalid addr_family");
+    }
+}
+
+static inline bool operator==(const sai_neighbor_entry_t& a, const sai_neighbor_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.rif_id == b.rif_id
+        && a.ip_address == b.ip_address
+        ;
+}
+
+static inline bool operator==(const sai_fdb_entry_t& a, const sai_fdb_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && memcmp(a.mac_address, b.mac_address, sizeof(a.mac_address)) == 0
+        && a.bv_id == b.bv_id
+        ;
+}
+
 static inline std::size_t hash_value(const sai_ip_prefix_t& a)
 {
     size_t seed = 0;
@@ -65,6 +101,21 @@ static inline std::size_t hash_value(const sai_ip_prefix_t& a)
     return seed;
 }
 
+static inline std::size_t hash_value(const sai_ip_address_t& a)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, a.addr_family);
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        boost::hash_combine(seed, a.addr.ip4);
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        boost::hash_combine(seed, a.addr.ip6);
+    }
+    return seed;
+}
+
 namespace std
 {
     template <>
@@ -104,6 +155,19 @@ namespace std
             return seed;
         }
     };
+
+    template <>
+    struct hash<sai_neighbor_entry_t>
+    {
+        size_t operator()(const sai_neighbor_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.rif_id);
+            boost::hash_combine(seed, a.ip_address);
+            return seed;
+        }
+    };
 }
 
 // SAI typedef which is not available in SAI 1.5
@@ -127,6 +191,29 @@ typedef sai_status_t (*sai_bulk_set_fdb_entry_attribute_fn)(
         _In_ sai_bulk_op_error_mode_t mode,
         _Out_ sai_status_t *object_statuses);
 
+/*
+ * Operations written to the sairedis pipeline by all the bulkers since
+ * startup, their size is estimated from the entries and attributes.
+ * The flush policy of OrchDaemon accounts what was queued since its last look.
+ */
+struct BulkerCounters
+{
+    uint64_t ops = 0;
+    uint64_t bytes = 0;
+
+    void add(size_t count, size_t entrySize, size_t attrCount)
+    {
+        ops += count;
+        bytes += count * entrySize + attrCount * sizeof(sai_attribute_t);
+    }
+};
+
+inline BulkerCounters &bulkerCounters()
+{
+    static BulkerCounters counters;
+    return counters;
+}
+
 template<typename T>
 struct SaiBulkerTraits { };
 
@@ -170,6 +257,62 @@ struct SaiBulkerTraits<sai_next_hop_group_api_t>
     //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_next_hop_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_next_hop_api_t;
+    using create_entry_fn = sai_create_next_hop_fn;
+    using remove_entry_fn = sai_remove_next_hop_fn;
+    using set_entry_attribute_fn = sai_set_next_hop_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    // TODO: wait until available in SAI
+    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_vlan_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_vlan_api_t;
+    using create_entry_fn = sai_create_vlan_member_fn;
+    using remove_entry_fn = sai_remove_vlan_member_fn;
+    using set_entry_attribute_fn = sai_set_vlan_member_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    // TODO: wait until available in SAI
+    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_lag_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_lag_api_t;
+    using create_entry_fn = sai_create_lag_member_fn;
+    using remove_entry_fn = sai_remove_lag_member_fn;
+    using set_entry_attribute_fn = sai_set_lag_member_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    // TODO: wait until available in SAI
+    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_bridge_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_bridge_api_t;
+    using create_entry_fn = sai_create_bridge_port_fn;
+    using remove_entry_fn = sai_remove_bridge_port_fn;
+    using set_entry_attribute_fn = sai_set_bridge_port_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    // TODO: wait until available in SAI
+    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_mpls_api_t>
 {
@@ -183,6 +326,19 @@ struct SaiBulkerTraits<sai_mpls_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_inseg_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_neighbor_api_t>
+{
+    using entry_t = sai_neighbor_entry_t;
+    using api_t = sai_neighbor_api_t;
+    using create_entry_fn = sai_create_neighbor_entry_fn;
+    using remove_entry_fn = sai_remove_neighbor_entry_fn;
+    using set_entry_attribute_fn = sai_set_neighbor_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_neighbor_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_neighbor_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_neighbor_entry_attribute_fn;
+};
+
 template <typename T>
 class EntityBulker
 {
@@ -449,6 +605,17 @@ private:
     typename Ts::bulk_remove_entry_fn                       remove_entries;
     typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
 
+    // Single entry functions used when the SAI does not support the bulk
+    // functions, left null to report the bulk status as is
+    typename Ts::create_entry_fn                            create_one_entry = nullptr;
+    typename Ts::remove_entry_fn                            remove_one_entry = nullptr;
+    typename Ts::set_entry_attribute_fn                     set_one_entry_attribute = nullptr;
+
+    static bool is_bulk_unsupported(sai_status_t status)
+    {
+        return status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED;
+    }
+
     sai_status_t flush_removing_entries(
         _Inout_ std::vector<Te> &rs)
     {
@@ -459,6 +626,15 @@ private:
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        if (is_bulk_unsupported(status) && remove_one_entry)
+        {
+            for (size_t ir = 0; ir < count; ir++)
+            {
+                statuses[ir] = (*remove_one_entry)(&rs[ir]);
+            }
+            status = SAI_STATUS_SUCCESS;
+        }
+        bulkerCounters().add(count, sizeof(Te), 0);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush removing_entries %zu\n", count);
@@ -497,6 +673,15 @@ private:
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*create_entries)((uint32_t)count, rs.data(), cs.data(), tss.data()
             , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        if (is_bulk_unsupported(status) && create_one_entry)
+        {
+            for (size_t ir = 0; ir < count; ir++)
+            {
+                statuses[ir] = (*create_one_entry)(&rs[ir], cs[ir], tss[ir]);
+            }
+            status = SAI_STATUS_SUCCESS;
+        }
+        bulkerCounters().add(count, sizeof(Te), std::accumulate(cs.begin(), cs.end(), size_t(0)));
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush creating_entries %zu\n", count);
@@ -537,6 +722,15 @@ private:
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
             , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        if (is_bulk_unsupported(status) && set_one_entry_attribute)
+        {
+            for (size_t ir = 0; ir < count; ir++)
+            {
+                statuses[ir] = (*set_one_entry_attribute)(&rs[ir], &ts[ir]);
+            }
+            status = SAI_STATUS_SUCCESS;
+        }
+        bulkerCounters().add(count, sizeof(Te), count);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush setting_entries, count %zu\n", count);
@@ -578,13 +772,14 @@ template <>
 inline EntityBulker<sai_fdb_api_t>::EntityBulker(sai_fdb_api_t *api, size_t max_bulk_size) :
     max_bulk_size(max_bulk_size)
 {
-    // TODO: implement after create_fdb_entries() is available in SAI
-    throw std::logic_error("Not implemented");
-    /*
     create_entries = api->create_fdb_entries;
     remove_entries = api->remove_fdb_entries;
     set_entries_attribute = api->set_fdb_entries_attribute;
-    */
+
+    // FDB bulk functions are not supported by every SAI
+    create_one_entry = api->create_fdb_entry;
+    remove_one_entry = api->remove_fdb_entry;
+    set_one_entry_attribute = api->set_fdb_entry_attribute;
 }
 
 template <>
@@ -596,6 +791,20 @@ inline EntityBulker<sai_mpls_api_t>::EntityBulker(sai_mpls_api_t *api, size_t ma
     set_entries_attribute = api->set_inseg_entries_attribute;
 }
 
+template <>
+inline EntityBulker<sai_neighbor_api_t>::EntityBulker(sai_neighbor_api_t *api, size_t max_bulk_size) :
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_neighbor_entries;
+    remove_entries = api->remove_neighbor_entries;
+    set_entries_attribute = api->set_neighbor_entries_attribute;
+
+    // Neighbor bulk functions are not supported by every SAI
+    create_one_entry = api->create_neighbor_entry;
+    remove_one_entry = api->remove_neighbor_entry;
+    set_one_entry_attribute = api->set_neighbor_entry_attribute;
+}
+
 template <typename T>
 class ObjectBulker
 {
@@ -611,14 +820,19 @@ public:
     sai_status_t create_entry(
         _Out_ sai_object_id_t *object_id,
         _In_ uint32_t attr_count,
-        _In_ const sai_attribute_t *attr_list)
+        _In_ const sai_attribute_t *attr_list,
+        _Out_ sai_status_t *object_status = nullptr)
     {
         assert(object_id);
         if (!object_id) throw std::invalid_argument("object_id is null");
         assert(attr_list);
         if (!attr_list) throw std::invalid_argument("attr_list is null");
 
-        creating_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(object_id), std::forward_as_tuple(attr_list, attr_list + attr_count));
+        creating_entries.emplace_back(object_id, std::vector<sai_attribute_t>(attr_list, attr_list + attr_count), object_status);
+        if (object_status)
+        {
+            *object_status = SAI_STATUS_NOT_EXECUTED;
+        }
 
         auto& last_attrs = std::get<1>(creating_entries.back());
         SWSS_LOG_INFO("ObjectBulker.create_entry %zu, %zu, %u\n", creating_entries.size(), last_attrs.size(), last_attrs[0].id);
@@ -702,6 +916,7 @@ public:
             std::vector<sai_object_id_t *> rs;
             std::vector<sai_attribute_t const*> tss;
             std::vector<uint32_t> cs;
+            std::vector<sai_status_t *> ss;
 
             for (auto const& i: creating_entries)
             {
@@ -712,14 +927,15 @@ public:
                     rs.push_back(pid);
                     tss.push_back(attrs.data());
                     cs.push_back((uint32_t)attrs.size());
+                    ss.push_back(std::get<2>(i));
 
                     if (rs.size() >= max_bulk_size)
                     {
-                        flush_creating_entries(rs, tss, cs);
+                        flush_creating_entries(rs, tss, cs, ss);
                     }
                 }
             }
-            flush_creating_entries(rs, tss, cs);
+            flush_creating_entries(rs, tss, cs, ss);
 
             creating_entries.clear();
         }
@@ -793,9 +1009,10 @@ private:
 
     size_t max_bulk_size;
 
-    std::vector<std::pair<                                  // A vector of pair of
+    std::vector<std::tuple<                                 // A vector of tuple of
             sai_object_id_t *,                              // - object_id
-            std::vector<sai_attribute_t>                    // - attrs
+            std::vector<sai_attribute_t>,                   // - attrs
+            sai_status_t *                                  // - OUT object_status, may be null
     >>                                                      creating_entries;
 
     std::unordered_map<                                     // A map of
@@ -810,11 +1027,22 @@ private:
                                                             // object_id -> object_status
     std::unordered_map<sai_object_id_t, sai_status_t *>     removing_entries;
 
-    typename Ts::bulk_create_entry_fn                       create_entries;
-    typename Ts::bulk_remove_entry_fn                       remove_entries;
+    // Left null when the SAI has no bulk function for the object type
+    typename Ts::bulk_create_entry_fn                       create_entries = nullptr;
+    typename Ts::bulk_remove_entry_fn                       remove_entries = nullptr;
     // TODO: wait until available in SAI
     //typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
 
+    // Single object functions used when the SAI does not support the bulk
+    // functions, left null to report the bulk status as is
+    typename Ts::create_entry_fn                            create_one_entry = nullptr;
+    typename Ts::remove_entry_fn                            remove_one_entry = nullptr;
+
+    static bool is_bulk_unsupported(sai_status_t status)
+    {
+        return status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED;
+    }
+
     sai_status_t flush_removing_entries(
         _Inout_ std::vector<sai_object_id_t> &rs)
     {
@@ -824,7 +1052,18 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
-        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        sai_status_t status = remove_entries ?
+            (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data()) :
+            SAI_STATUS_NOT_IMPLEMENTED;
+        if (is_bulk_unsupported(status) && remove_one_entry)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                statuses[i] = (*remove_one_entry)(rs[i]);
+            }
+            status = SAI_STATUS_SUCCESS;
+        }
+        bulkerCounters().add(count, sizeof(sai_object_id_t), 0);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush removing_entries %zu rc=%d statuses[0]=%d\n", removing_entries.size(), status, statuses[0]);
@@ -850,7 +1089,8 @@ private:
     sai_status_t flush_creating_entries(
         _Inout_ std::vector<sai_object_id_t *> &rs,
         _Inout_ std::vector<sai_attribute_t const*> &tss,
-        _Inout_ std::vector<uint32_t> &cs)
+        _Inout_ std::vector<uint32_t> &cs,
+        _Inout_ std::vector<sai_status_t *> &ss)
     {
         if (rs.empty())
         {
@@ -859,8 +1099,19 @@ private:
         size_t count = rs.size();
         std::vector<sai_object_id_t> object_ids(count);
         std::vector<sai_status_t> statuses(count);
-        sai_status_t status = (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+        sai_status_t status = create_entries ?
+            (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
+                , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data()) :
+            SAI_STATUS_NOT_IMPLEMENTED;
+        if (is_bulk_unsupported(status) && create_one_entry)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                statuses[i] = (*create_one_entry)(&object_ids[i], switch_id, cs[i], tss[i]);
+            }
+            status = SAI_STATUS_SUCCESS;
+        }
+        bulkerCounters().add(count, sizeof(sai_object_id_t), std::accumulate(cs.begin(), cs.end(), size_t(0)));
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush creating_entries %zu\n", count);
@@ -875,11 +1126,16 @@ private:
         {
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+            if (ss[i])
+            {
+                *ss[i] = statuses[i];
+            }
         }
 
         rs.clear();
         tss.clear();
         cs.clear();
+        ss.clear();
 
         return status;
     }
@@ -926,3 +1182,53 @@ inline ObjectBulker<sai_next_hop_group_api_t>::ObjectBulker(SaiBulkerTraits<sai_
     // TODO: wait until available in SAI
     //set_entries_attribute = ;
 }
+
+template <>
+inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(SaiBulkerTraits<sai_next_hop_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_next_hops;
+    remove_entries = api->remove_next_hops;
+
+    // Next hop bulk functions are not supported by every SAI
+    create_one_entry = api->create_next_hop;
+    remove_one_entry = api->remove_next_hop;
+}
+
+template <>
+inline ObjectBulker<sai_vlan_api_t>::ObjectBulker(SaiBulkerTraits<sai_vlan_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_vlan_members;
+    remove_entries = api->remove_vlan_members;
+
+    // VLAN member bulk functions are not supported by every SAI
+    create_one_entry = api->create_vlan_member;
+    remove_one_entry = api->remove_vlan_member;
+}
+
+template <>
+inline ObjectBulker<sai_lag_api_t>::ObjectBulker(SaiBulkerTraits<sai_lag_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_lag_members;
+    remove_entries = api->remove_lag_members;
+
+    // LAG member bulk functions are not supported by every SAI
+    create_one_entry = api->create_lag_member;
+    remove_one_entry = api->remove_lag_member;
+}
+
+template <>
+inline ObjectBulker<sai_bridge_api_t>::ObjectBulker(SaiBulkerTraits<sai_bridge_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The SAI has no bulk functions for bridge ports, they are created one
+    // by one when the bulker is flushed
+    create_one_entry = api->create_bridge_port;
+    remove_one_entry = api->remove_bridge_port;
+}
@@ -0,0 +1,109 @@
+#ifndef SWSS_CONSUMERSTATS_H
+#define SWSS_CONSUMERSTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "table.h"
+
+/*
+ * Histogram with decade buckets: <= 1, <= 10, ..., <= 10^7 and > 10^7.
+ * Counters are relaxed atomics so that they can be read from another
+ * thread while the main loop keeps updating them.
+ */
+class StatsHistogram
+{
+public:
+    static const size_t BUCKETS = 9;
+
+    void add(uint64_t value)
+    {
+        size_t i = 0;
+        uint64_t bound = 1;
+        while (i < BUCKETS - 1 && value > bound)
+        {
+            bound *= 10;
+            i++;
+        }
+
+        m_buckets[i].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t getSum() const { return m_sum.load(std::memory_order_relaxed); }
+
+    void toFieldValues(const std::string &name, std::vector<swss::FieldValueTuple> &fvs) const
+    {
+        uint64_t bound = 1;
+        for (size_t i = 0; i < BUCKETS; i++)
+        {
+            std::string field = i < BUCKETS - 1 ?
+                name + "_LE_" + std::to_string(bound) :
+                name + "_GT_" + std::to_string(bound / 10);
+            fvs.emplace_back(field, std::to_string(m_buckets[i].load(std::memory_order_relaxed)));
+            bound *= 10;
+        }
+        fvs.emplace_back(name + "_COUNT", std::to_string(getCount()));
+        fvs.emplace_back(name + "_SUM", std::to_string(getSum()));
+    }
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKETS] = {};
+    std::atomic<uint64_t> m_count { 0 };
+    std::atomic<uint64_t> m_sum { 0 };
+};
+
+/*
+ * Latency and backlog statistics of a Consumer:
+ * - POPS_PER_WAKEUP: entries popped from the table per select wake-up
+ * - TO_SYNC_DEPTH: m_toSync size after each doTask
+ * - DOTASK_USECS: time spent in doTask(Consumer&)
+ * - RETRIES: tasks handed to doTask again after it left them in m_toSync
+ *
+ * The age of the oldest pending task is computed from m_toSync by the Consumer.
+ */
+class ConsumerStats
+{
+public:
+    void onWakeup(size_t popped)
+    {
+        m_wakeups.fetch_add(1, std::memory_order_relaxed);
+        m_popsPerWakeup.add(popped);
+    }
+
+    void onDoTask(std::chrono::steady_clock::duration elapsed, size_t depth, size_t retries)
+    {
+        m_doTaskUsecs.add(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        m_toSyncDepth.add(depth);
+        m_retries.fetch_add(retries, std::memory_order_relaxed);
+        m_depth.store(depth, std::memory_order_relaxed);
+    }
+
+    uint64_t getRetries() const { return m_retries.load(std::memory_order_relaxed); }
+
+    void toFieldValues(std::vector<swss::FieldValueTuple> &fvs) const
+    {
+        fvs.emplace_back("WAKEUPS", std::to_string(m_wakeups.load(std::memory_order_relaxed)));
+        fvs.emplace_back("RETRIES", std::to_string(m_retries.load(std::memory_order_relaxed)));
+        fvs.emplace_back("TO_SYNC", std::to_string(m_depth.load(std::memory_order_relaxed)));
+        m_popsPerWakeup.toFieldValues("POPS_PER_WAKEUP", fvs);
+        m_toSyncDepth.toFieldValues("TO_SYNC_DEPTH", fvs);
+        m_doTaskUsecs.toFieldValues("DOTASK_USECS", fvs);
+    }
+
+private:
+    std::atomic<uint64_t> m_wakeups { 0 };
+    std::atomic<uint64_t> m_retries { 0 };
+    std::atomic<uint64_t> m_depth { 0 };
+
+    StatsHistogram m_popsPerWakeup;
+    StatsHistogram m_toSyncDepth;
+    StatsHistogram m_doTaskUsecs;
+};
+
+#endif /* SWSS_CONSUMERSTATS_H */
@@ -21,15 +21,71 @@ extern sai_object_id_t  gSwitchId;
 extern CrmOrch *        gCrmOrch;
 extern MlagOrch*        gMlagOrch;
 extern Directory<Orch*> gDirectory;
+extern size_t gMaxBulkSize;
 
 const int FdbOrch::fdborch_pri = 20;
 
+void FdbEntryTable::set(const FdbEntry& entry, const FdbData& data)
+{
+    auto it = m_entries.find(entry);
+    if (it == m_entries.end())
+    {
+        it = m_entries.emplace(entry, data).first;
+        addToIndex(m_entriesByBvId, entry.bv_id, &*it);
+    }
+    else
+    {
+        if (it->second.bridge_port_id != data.bridge_port_id)
+        {
+            removeFromIndex(m_entriesByBridgePort, it->second.bridge_port_id, &*it);
+        }
+        it->second = data;
+    }
+
+    addToIndex(m_entriesByBridgePort, data.bridge_port_id, &*it);
+}
+
+size_t FdbEntryTable::erase(const FdbEntry& entry)
+{
+    auto it = m_entries.find(entry);
+    if (it == m_entries.end())
+    {
+        return 0;
+    }
+
+    removeFromIndex(m_entriesByBridgePort, it->second.bridge_port_id, &*it);
+    removeFromIndex(m_entriesByBvId, it->first.bv_id, &*it);
+    m_entries.erase(it);
+    return 1;
+}
+
+void FdbEntryTable::addToIndex(EntryIndex& index, sai_object_id_t id, const value_type* entry)
+{
+    index[id].insert(entry);
+}
+
+void FdbEntryTable::removeFromIndex(EntryIndex& index, sai_object_id_t id, const value_type* entry)
+{
+    auto it = index.find(id);
+    if (it == index.end())
+    {
+        return;
+    }
+
+    it->second.erase(entry);
+    if (it->second.empty())
+    {
+        index.erase(it);
+    }
+}
+
 FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> appFdbTables,
     TableConnector stateDbFdbConnector, TableConnector stateDbMclagFdbConnector, PortsOrch *port) :
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
     m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
-    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second)
+    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second),
+    gFdbBulker(sai_fdb_api, gMaxBulkSize)
 {
     for(auto it: appFdbTables)
     {
@@ -114,11 +170,11 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         fdbdata.esi = "";
         fdbdata.vni = 0;
 
-        m_entries[entry] = fdbdata;
+        m_entries.set(entry, fdbdata);
         SWSS_LOG_INFO("FdbOrch notification: mac %s was inserted in port %s into bv_id 0x%" PRIx64,
                         entry.mac.to_string().c_str(), portName.c_str(), entry.bv_id);
         SWSS_LOG_INFO("m_entries size=%zu mac=%s port=0x%" PRIx64,
-            m_entries.size(), entry.mac.to_string().c_str(),  m_entries[entry].bridge_port_id);
+            m_entries.size(), entry.mac.to_string().c_str(),  fdbdata.bridge_port_id);
 
         if (mac_move && (oldFdbData.origin == FDB_ORIGIN_MCLAG_ADVERTIZED))
         {
@@ -198,7 +254,7 @@ void FdbOrch::clearFdbEntry(const MacAddress& mac,
 
     /* Remove the FdbEntry from the internal cache, update state DB and CRM counter */
     storeFdbEntryState(update);
-    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    notifyFdbChange(update);
 
     SWSS_LOG_INFO("FdbEntry removed from internal cache, MAC: %s , port: %s, BVID: 0x%" PRIx64,
                    mac.to_string().c_str(), port_alias.c_str(), bv_id);
@@ -227,51 +283,36 @@ void FdbOrch::handleSyncdFlushNotif(const sai_object_id_t& bv_id,
                 clearFdbEntry(curr->first.mac, curr->first.bv_id, curr->first.port_name);
             }
         }
+        return;
     }
-    else if (bv_id == SAI_NULL_OBJECT_ID)
+
+    /* FLUSH based on PORT, BV_ID or both, only the indexed entries are visited */
+    vector<FdbEntry> entries;
+    auto collect = [&](const FdbEntry& entry, const FdbData& data)
     {
-        /* FLUSH based on PORT */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
+        if (bv_id != SAI_NULL_OBJECT_ID && entry.bv_id != bv_id)
         {
-            auto curr = itr++;
-            if (curr->second.bridge_port_id == bridge_port_id)
-            {
-                if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac))
-                {
-                    clearFdbEntry(curr->first.mac, curr->first.bv_id, curr->first.port_name);
-                }
-            }
+            return;
         }
-    }
-    else if (bridge_port_id == SAI_NULL_OBJECT_ID)
-    {
-        /* FLUSH based on BV_ID */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
+
+        if (data.type != "static" && (entry.mac == mac || mac == flush_mac))
         {
-            auto curr = itr++;
-            if (curr->first.bv_id == bv_id)
-            {
-                if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac))
-                {
-                    clearFdbEntry(curr->first.mac, curr->first.bv_id, curr->first.port_name);
-                }
-            }
+            entries.push_back(entry);
         }
+    };
+
+    if (bridge_port_id == SAI_NULL_OBJECT_ID)
+    {
+        m_entries.forEachByBvId(bv_id, collect);
     }
     else
     {
-        /* FLUSH based on port and VLAN */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
-        {
-            auto curr = itr++;
-            if (curr->first.bv_id == bv_id && curr->second.bridge_port_id == bridge_port_id)
-            {
-                if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac))
-                {
-                    clearFdbEntry(curr->first.mac, curr->first.bv_id, curr->first.port_name);
-                }
-            }
-        }
+        m_entries.forEachByBridgePort(bridge_port_id, collect);
+    }
+
+    for (const auto& entry : entries)
+    {
+        clearFdbEntry(entry.mac, entry.bv_id, entry.port_name);
     }
 }
 
@@ -285,7 +326,6 @@ void FdbOrch::update(sai_fdb_event_t        type,
     update.entry.mac = entry->mac_address;
     update.entry.bv_id = entry->bv_id;
     update.type = "dynamic";
-    Port vlan;
 
     SWSS_LOG_INFO("FDB event:%d, MAC: %s , BVID: 0x%" PRIx64 " , \
                    bridge port ID: 0x%" PRIx64 ".",
@@ -311,12 +351,15 @@ void FdbOrch::update(sai_fdb_event_t        type,
         }
     }
 
-    if (entry->bv_id &&
-        !m_portsOrch->getPort(entry->bv_id, vlan))
+    /* The VLAN is only read, it is not copied out of PortsOrch */
+    static const Port noVlan;
+    const Port *vlanPort = entry->bv_id ? m_portsOrch->findPort(entry->bv_id) : &noVlan;
+    if (!vlanPort)
     {
         SWSS_LOG_NOTICE("FdbOrch notification type %d: Failed to locate vlan port from bv_id 0x%" PRIx64, type, entry->bv_id);
         return;
     }
+    const Port &vlan = *vlanPort;
 
     switch (type)
     {
@@ -333,20 +376,18 @@ void FdbOrch::update(sai_fdb_event_t        type,
                 // If the bp is different MOVE the MAC entry.
                 if (existing_entry->second.bridge_port_id != bridge_port_id)
                 {
-                    Port port;
                     SWSS_LOG_NOTICE("FdbOrch LEARN notification: mac %s is already in bv_id 0x%" PRIx64 "with different existing-bp 0x%" PRIx64 " new-bp:0x%" PRIx64,
                             update.entry.mac.to_string().c_str(), entry->bv_id, existing_entry->second.bridge_port_id, bridge_port_id);
-                    if (!m_portsOrch->getPortByBridgePortId(existing_entry->second.bridge_port_id, port))
+                    const Port *port = m_portsOrch->findPort(existing_entry->second.bridge_port_id);
+                    if (!port)
                     {
                         SWSS_LOG_NOTICE("FdbOrch LEARN notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->second.bridge_port_id);
                         return;
                     }
                     else
                     {
-                        port.m_fdb_count--;
-                        m_portsOrch->setPort(port.m_alias, port);
-                        vlan.m_fdb_count--;
-                        m_portsOrch->setPort(vlan.m_alias, vlan);
+                        m_portsOrch->decrFdbCount(port->m_alias, 1);
+                        m_portsOrch->decrFdbCount(vlan.m_alias, 1);
                     }
                     // Continue to add (update/move) the MAC
                 }
@@ -386,7 +427,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
                     update.add = true;
                     update.type = "dynamic";
                     storeFdbEntryState(update);
-                    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+                    notifyFdbChange(update);
 
                     return;
                 }
@@ -404,12 +445,11 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.entry.port_name = update.port.m_alias;
         update.type = "dynamic";
         update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->incrFdbCount(update.port.m_alias, 1);
+        m_portsOrch->incrFdbCount(vlan.m_alias, 1);
 
         storeFdbEntryState(update);
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         break;
     }
@@ -529,16 +569,15 @@ void FdbOrch::update(sai_fdb_event_t        type,
         if (!update.port.m_alias.empty())
         {
             update.port.m_fdb_count--;
-            m_portsOrch->setPort(update.port.m_alias, update.port);
+            m_portsOrch->decrFdbCount(update.port.m_alias, 1);
         }
         if (!vlan.m_alias.empty())
         {
-            vlan.m_fdb_count--;
-            m_portsOrch->setPort(vlan.m_alias, vlan);
+            m_portsOrch->decrFdbCount(vlan.m_alias, 1);
         }
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         notifyTunnelOrch(update.port);
         break;
@@ -568,13 +607,13 @@ void FdbOrch::update(sai_fdb_event_t        type,
         if (!port_old.m_alias.empty())
         {
             port_old.m_fdb_count--;
-            m_portsOrch->setPort(port_old.m_alias, port_old);
+            m_portsOrch->decrFdbCount(port_old.m_alias, 1);
         }
         update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
+        m_portsOrch->incrFdbCount(update.port.m_alias, 1);
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         notifyTunnelOrch(port_old);
 
@@ -693,186 +732,246 @@ void FdbOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
-
-        /* format: <VLAN_name>:<MAC_address> */
-        vector<string> keys = tokenize(kfvKey(t), ':', 1);
-        string op = kfvOp(t);
-
-        Port vlan;
-        if (!m_portsOrch->getPort(keys[0], vlan))
+        // FDB bulk results will be stored in a map
+        std::map<
+                std::pair<
+                        std::string,            // Key
+                        std::string             // Op
+                >,
+                FdbBulkContext
+        >                                       toBulk;
+
+        // Add, update or remove FDB entries with the FDB bulker
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
-            if(op == DEL_COMMAND)
-            {
-                /* Delete if it is in saved_fdb_entry */
-                unsigned short vlan_id;
-                try {
-                    vlan_id = (unsigned short) stoi(keys[0].substr(4));
-                } catch(exception &e) {
-                    it = consumer.m_toSync.erase(it);
-                    continue;
-                }
-                deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
+            KeyOpFieldsValuesTuple t = it->second;
 
-                it = consumer.m_toSync.erase(it);
-            }
-            else
+            /* format: <VLAN_name>:<MAC_address> */
+            string key = kfvKey(t);
+            vector<string> keys = tokenize(key, ':', 1);
+            string op = kfvOp(t);
+
+            /* Flush the queued operation of an entry before processing its next one */
+            if (toBulk.find(make_pair(key, SET_COMMAND)) != toBulk.end() ||
+                toBulk.find(make_pair(key, DEL_COMMAND)) != toBulk.end())
             {
-                it++;
+                break;
             }
-            continue;
-        }
-
-        FdbEntry entry;
-        entry.mac = MacAddress(keys[1]);
-        entry.bv_id = vlan.m_vlan_info.vlan_oid;
 
-        if (op == SET_COMMAND)
-        {
-            string port = "";
-            string type = "dynamic";
-            string remote_ip = "";
-            string esi = "";
-            unsigned int vni = 0;
-            string sticky = "";
-
-            for (auto i : kfvFieldsValues(t))
+            Port vlan;
+            if (!m_portsOrch->getPort(keys[0], vlan))
             {
-                if (fvField(i) == "port")
+                SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
+                if(op == DEL_COMMAND)
                 {
-                    port = fvValue(i);
-                }
+                    /* Delete if it is in saved_fdb_entry */
+                    unsigned short vlan_id;
+                    try {
+                        vlan_id = (unsigned short) stoi(keys[0].substr(4));
+                    } catch(exception &e) {
+                        it = consumer.m_toSync.erase(it);
+                        continue;
+                    }
+                    deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
 
-                if (fvField(i) == "type")
+                    it = consumer.m_toSync.erase(it);
+                }
+                else
                 {
-                    type = fvValue(i);
+                    it++;
                 }
+                continue;
+            }
 
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+            FdbEntry entry;
+            entry.mac = MacAddress(keys[1]);
+            entry.bv_id = vlan.m_vlan_info.vlan_oid;
+
+            if (op == SET_COMMAND)
+            {
+                string port = "";
+                string type = "dynamic";
+                string remote_ip = "";
+                string esi = "";
+                unsigned int vni = 0;
+                string sticky = "";
+
+                for (auto i : kfvFieldsValues(t))
                 {
-                    if (fvField(i) == "remote_vtep")
+                    if (fvField(i) == "port")
                     {
-                        remote_ip = fvValue(i);
-                        // Creating an IpAddress object to validate if remote_ip is valid
-                        // if invalid it will throw the exception and we will ignore the
-                        // event
-                        try {
-                            IpAddress valid_ip = IpAddress(remote_ip);
-                            (void)valid_ip; // To avoid g++ warning
-                        } catch(exception &e) {
-                            SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
-                            remote_ip = "";
-                            break;
-                        }
+                        port = fvValue(i);
                     }
 
-                    if (fvField(i) == "esi")
+                    if (fvField(i) == "type")
                     {
-                        esi = fvValue(i);
+                        type = fvValue(i);
                     }
 
-                    if (fvField(i) == "vni")
+                    if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                     {
-                        try {
-                            vni = (unsigned int) stoi(fvValue(i));
-                        } catch(exception &e) {
-                            SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
-                            vni = 0;
-                            break;
+                        if (fvField(i) == "remote_vtep")
+                        {
+                            remote_ip = fvValue(i);
+                            // Creating an IpAddress object to validate if remote_ip is valid
+                            // if invalid it will throw the exception and we will ignore the
+                            // event
+                            try {
+                                IpAddress valid_ip = IpAddress(remote_ip);
+                                (void)valid_ip; // To avoid g++ warning
+                            } catch(exception &e) {
+                                SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
+                                remote_ip = "";
+                                break;
+                            }
+                        }
+
+                        if (fvField(i) == "esi")
+                        {
+                            esi = fvValue(i);
+                        }
+
+                        if (fvField(i) == "vni")
+                        {
+                            try {
+                                vni = (unsigned int) stoi(fvValue(i));
+                            } catch(exception &e) {
+                                SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
+                                vni = 0;
+                                break;
+                            }
                         }
                     }
                 }
-            }
 
-            /* FDB type is either dynamic or static */
-            assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
-
-            if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-            {
-                VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+                /* FDB type is either dynamic or static */
+                assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
 
-                if (tunnel_orch->isDipTunnelsSupported())
+                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                 {
-                    if(!remote_ip.length())
+                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+
+                    if (tunnel_orch->isDipTunnelsSupported())
                     {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
+                        if(!remote_ip.length())
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(remote_ip);
                     }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
-                }
-                else
-                {
-                    EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
-                    VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
-                    if (sip_tunnel == NULL)
+                    else
                     {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
+                        EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
+                        VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
+                        if (sip_tunnel == NULL)
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
                     }
-                    port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
                 }
-            }
 
 
-            FdbData fdbData;
-            fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
-            fdbData.type = type;
-            fdbData.origin = origin;
-            fdbData.remote_ip = remote_ip;
-            fdbData.esi = esi;
-            fdbData.vni = vni;
-            if (addFdbEntry(entry, port, fdbData))
-            {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
+                FdbData fdbData;
+                fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
+                fdbData.type = type;
+                fdbData.origin = origin;
+                fdbData.remote_ip = remote_ip;
+                fdbData.esi = esi;
+                fdbData.vni = vni;
+
+                auto& ctx = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(key, op),
+                        std::forward_as_tuple(entry, port, fdbData)).first->second;
+
+                if (addFdbEntry(ctx))
                 {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    if (type == "dynamic_local")
-                    {
-                        m_mclagFdbStateTable.del(key);
-                    }
+                    updateMclagFdbState(ctx, vlan, op);
+                    it = consumer.m_toSync.erase(it);
                 }
+                else
+                    it++;
+            }
+            else if (op == DEL_COMMAND)
+            {
+                auto& ctx = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(key, op),
+                        std::forward_as_tuple(entry, origin)).first->second;
 
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+                if (removeFdbEntry(ctx))
                 {
-                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
-
-                    if(!remote_ip.length())
-                    {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
-                    }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
+                    updateMclagFdbState(ctx, vlan, op);
+                    it = consumer.m_toSync.erase(it);
                 }
-                it = consumer.m_toSync.erase(it);
+                else
+                    it++;
+
             }
             else
-                it++;
+            {
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+                it = consumer.m_toSync.erase(it);
+            }
         }
-        else if (op == DEL_COMMAND)
+
+        gFdbBulker.flush();
+
+        // Go through the bulker results, m_entries, the saved FDB entries and
+        // STATE_DB are updated for all the entries of the bulk in this pass
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
         {
-            if (removeFdbEntry(entry, origin))
+            string key = kfvKey(it_prev->second);
+            string op = kfvOp(it_prev->second);
+            auto found = toBulk.find(make_pair(key, op));
+            if (found == toBulk.end() || found->second.object_statuses.empty())
+            {
+                it_prev++;
+                continue;
+            }
+
+            const auto& ctx = found->second;
+            bool done = (op == SET_COMMAND) ? addFdbEntryPost(ctx) : removeFdbEntryPost(ctx);
+            if (done)
             {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
+                Port vlan;
+                if (m_portsOrch->getPort(ctx.entry.bv_id, vlan))
                 {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    m_mclagFdbStateTable.del(key);
-                    SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
-                            "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
+                    updateMclagFdbState(ctx, vlan, op);
                 }
-
-                it = consumer.m_toSync.erase(it);
+                it_prev = consumer.m_toSync.erase(it_prev);
             }
             else
-                it++;
-
+                it_prev++;
         }
-        else
+    }
+}
+
+/* Update STATE_DB MCLAG remote FDB table once an APP_MCLAG_FDB_TABLE entry is done */
+void FdbOrch::updateMclagFdbState(const FdbBulkContext& ctx, const Port& vlan, const string& op)
+{
+    if (ctx.origin != FDB_ORIGIN_MCLAG_ADVERTIZED)
+    {
+        return;
+    }
+
+    const FdbEntry& entry = ctx.entry;
+    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    if (op == SET_COMMAND)
+    {
+        if (ctx.fdbData.type == "dynamic_local")
         {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            m_mclagFdbStateTable.del(key);
         }
     }
+    else
+    {
+        m_mclagFdbStateTable.del(key);
+        SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
+                "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
+    }
 }
 
 void FdbOrch::doTask(NotificationConsumer& consumer)
@@ -999,23 +1098,204 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
 
         sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
 
-        for (uint32_t i = 0; i < count; ++i)
+        handleFdbEvents(fdbevent, count);
+
+        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+    }
+}
+
+/*
+ * Collects the FDB updates of a notification in batch and buffers the writes
+ * of the state tables until end(), or until the scope is left by an exception.
+ */
+class FdbBatchScope
+{
+public:
+    FdbBatchScope(FdbBatchUpdate *&current, FdbBatchUpdate &batch, std::initializer_list<Table *> tables) :
+        m_current(current),
+        m_tables(tables)
+    {
+        m_current = &batch;
+        for (auto table : m_tables)
+        {
+            table->setBuffered(true);
+        }
+    }
+
+    ~FdbBatchScope()
+    {
+        try
+        {
+            end();
+        }
+        catch (const std::exception &e)
+        {
+            SWSS_LOG_ERROR("Failed to flush the FDB state tables: %s", e.what());
+        }
+    }
+
+    FdbBatchScope(const FdbBatchScope&) = delete;
+    FdbBatchScope& operator=(const FdbBatchScope&) = delete;
+
+    void end()
+    {
+        if (m_ended)
+        {
+            return;
+        }
+        m_ended = true;
+
+        m_current = nullptr;
+        for (auto table : m_tables)
+        {
+            table->setBuffered(false);
+        }
+        for (auto table : m_tables)
         {
-            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+            table->flush();
+        }
+    }
+
+private:
+    FdbBatchUpdate *&m_current;
+    vector<Table *> m_tables;
+    bool m_ended = false;
+};
+
+/*
+ * Name: handleFdbEvents
+ * Params:
+ *     fdbevent - FDB events of one fdb_event notification
+ *     count - number of events
+ * Description:
+ *     Processes the events of a notification as one batch. The bridge port of
+ *     each OID is resolved once, the events made redundant by a later event of
+ *     the same FDB entry are dropped, the STATE_DB writes are pipelined and the
+ *     observers get a single SUBJECT_TYPE_FDB_BATCH_CHANGE at the end.
+ *
+ *     Only the following sequences of events of an FDB entry are coalesced,
+ *     when both bridge ports are known non tunnel ports:
+ *     - LEARN, LEARN on the same bridge port: the second learn is a duplicate.
+ *     - LEARN, AGE on the same bridge port of an unknown entry: both dropped.
+ *     - MOVE, MOVE: only the last move is applied.
+ *     A FLUSHED event may remove any entry, no event is coalesced across it.
+ */
+void FdbOrch::handleFdbEvents(const sai_fdb_event_notification_data_t *fdbevent, uint32_t count)
+{
+    SWSS_LOG_ENTER();
 
-            for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+    vector<sai_object_id_t> bridgePortIds(count, SAI_NULL_OBJECT_ID);
+    /* Whether the bridge port OID is a known non tunnel port */
+    unordered_map<sai_object_id_t, bool> coalescable;
+    /* Index of the next event of the same FDB entry, count if none */
+    vector<uint32_t> next(count, count);
+    map<FdbEntry, uint32_t> last;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+        {
+            if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
             {
-                if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
-                {
-                    oid = fdbevent[i].attr[j].value.oid;
-                    break;
-                }
+                bridgePortIds[i] = fdbevent[i].attr[j].value.oid;
+                break;
             }
+        }
 
-            this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid);
+        sai_object_id_t oid = bridgePortIds[i];
+        if (oid != SAI_NULL_OBJECT_ID && coalescable.find(oid) == coalescable.end())
+        {
+            const Port *port = m_portsOrch->findPort(oid);
+            coalescable[oid] = port && port->m_type != Port::TUNNEL;
         }
 
-        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+        if (fdbevent[i].event_type == SAI_FDB_EVENT_FLUSHED)
+        {
+            last.clear();
+            continue;
+        }
+
+        FdbEntry entry;
+        entry.mac = fdbevent[i].fdb_entry.mac_address;
+        entry.bv_id = fdbevent[i].fdb_entry.bv_id;
+
+        auto it = last.find(entry);
+        if (it != last.end())
+        {
+            next[it->second] = i;
+            it->second = i;
+        }
+        else
+        {
+            last[entry] = i;
+        }
+    }
+
+    auto isCoalescable = [&coalescable](sai_object_id_t oid)
+    {
+        auto it = coalescable.find(oid);
+        return it != coalescable.end() && it->second;
+    };
+
+    FdbBatchUpdate batch;
+    vector<bool> skip(count, false);
+
+    FdbBatchScope scope(m_fdbBatch, batch, { &m_fdbStateTable, &m_mclagFdbStateTable });
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (skip[i])
+        {
+            continue;
+        }
+
+        const auto& event = fdbevent[i];
+        sai_object_id_t oid = bridgePortIds[i];
+        uint32_t n = next[i];
+
+        if (n < count && isCoalescable(oid) && isCoalescable(bridgePortIds[n]))
+        {
+            FdbEntry entry;
+            entry.mac = event.fdb_entry.mac_address;
+            entry.bv_id = event.fdb_entry.bv_id;
+            auto existing_entry = m_entries.find(entry);
+
+            sai_fdb_event_t nextType = fdbevent[n].event_type;
+
+            if (event.event_type == SAI_FDB_EVENT_LEARNED &&
+                nextType == SAI_FDB_EVENT_LEARNED && bridgePortIds[n] == oid)
+            {
+                SWSS_LOG_INFO("FdbOrch notification: coalesce duplicate LEARN of mac %s in bv_id 0x%" PRIx64,
+                              entry.mac.to_string().c_str(), entry.bv_id);
+                skip[n] = true;
+            }
+            else if (event.event_type == SAI_FDB_EVENT_LEARNED &&
+                     nextType == SAI_FDB_EVENT_AGED && bridgePortIds[n] == oid &&
+                     existing_entry == m_entries.end())
+            {
+                SWSS_LOG_INFO("FdbOrch notification: coalesce LEARN and AGE of mac %s in bv_id 0x%" PRIx64,
+                              entry.mac.to_string().c_str(), entry.bv_id);
+                skip[n] = true;
+                continue;
+            }
+            else if (event.event_type == SAI_FDB_EVENT_MOVE &&
+                     nextType == SAI_FDB_EVENT_MOVE && bridgePortIds[n] != oid &&
+                     (existing_entry == m_entries.end() || existing_entry->second.bridge_port_id != oid))
+            {
+                SWSS_LOG_INFO("FdbOrch notification: coalesce MOVE of mac %s in bv_id 0x%" PRIx64,
+                              entry.mac.to_string().c_str(), entry.bv_id);
+                continue;
+            }
+        }
+
+        this->update(event.event_type, &event.fdb_entry, oid);
+    }
+
+    scope.end();
+
+    if (!batch.updates.empty())
+    {
+        notify(SUBJECT_TYPE_FDB_BATCH_CHANGE, &batch);
     }
 }
 
@@ -1081,19 +1361,18 @@ void FdbOrch::notifyObserversFDBFlush(Port &port, sai_object_id_t& bvid)
     FdbFlushUpdate flushUpdate;
     flushUpdate.port = port;
 
-    for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    m_entries.forEachByBvId(bvid, [&](const FdbEntry& fdbEntry, const FdbData&)
     {
-        if ((itr->first.port_name == port.m_alias) &&
-            (itr->first.bv_id == bvid))
+        if (fdbEntry.port_name == port.m_alias)
         {
             SWSS_LOG_INFO("Adding MAC learnt on [ port:%s , bvid:0x%" PRIx64 "]\
                            to ARP flush", port.m_alias.c_str(), bvid);
             FdbEntry entry;
-            entry.mac = itr->first.mac;
-            entry.bv_id = itr->first.bv_id;
+            entry.mac = fdbEntry.mac;
+            entry.bv_id = fdbEntry.bv_id;
             flushUpdate.entries.push_back(entry);
         }
-    }
+    });
 
     if (!flushUpdate.entries.empty())
     {
@@ -1169,6 +1448,27 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         FdbData fdbData)
 {
+    SWSS_LOG_ENTER();
+
+    FdbBulkContext ctx(entry, port_name, fdbData);
+    if (addFdbEntry(ctx))
+    {
+        return true;
+    }
+    if (ctx.object_statuses.empty())
+    {
+        return false;
+    }
+
+    gFdbBulker.flush();
+    return addFdbEntryPost(ctx);
+}
+
+bool FdbOrch::addFdbEntry(FdbBulkContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    const FdbData& fdbData = ctx.fdbData;
     Port vlan;
     Port port;
     string end_point_ip = "";
@@ -1210,17 +1510,16 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         return true;
     }
 
-    sai_status_t status;
-    sai_fdb_entry_t fdb_entry;
+    sai_fdb_entry_t &fdb_entry = ctx.fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
     Port oldPort;
-    string oldType;
+    string &oldType = ctx.oldType;
     string oldRemoteIp;
-    FdbOrigin oldOrigin = FDB_ORIGIN_INVALID ;
-    bool macUpdate = false;
+    FdbOrigin &oldOrigin = ctx.oldOrigin;
+    bool &macUpdate = ctx.macUpdate;
 
     auto it = m_entries.find(entry);
     if (it != m_entries.end())
@@ -1308,6 +1607,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         }
 
         macUpdate = true;
+        ctx.oldPortName = oldPort.m_alias;
     }
 
     sai_attribute_t attr;
@@ -1391,13 +1691,55 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 entry.mac.to_string().c_str(), vlan.m_alias.c_str(), oldPort.m_alias.c_str(),
                 port_name.c_str(), oldType.c_str(), fdbData.type.c_str(),
                 oldOrigin, fdbData.origin);
-        for (auto itr : attrs)
+        for (const auto& itr : attrs)
         {
-            status = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
+            ctx.object_statuses.emplace_back();
+            gFdbBulker.set_entry_attribute(&ctx.object_statuses.back(), &fdb_entry, &itr);
+        }
+    }
+    else
+    {
+        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
+
+        ctx.object_statuses.emplace_back();
+        gFdbBulker.create_entry(&ctx.object_statuses.back(), &fdb_entry, (uint32_t)attrs.size(), attrs.data());
+    }
+
+    return false;
+}
+
+bool FdbOrch::addFdbEntryPost(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    const FdbData& fdbData = ctx.fdbData;
+    FdbOrigin oldOrigin = ctx.oldOrigin;
+    bool macUpdate = ctx.macUpdate;
+
+    /* Ports are read again, the counters may have been updated by the entries of the same bulk */
+    const Port *vlanPort = m_portsOrch->findPort(entry.bv_id);
+    Port port;
+    if (!vlanPort || !m_portsOrch->getPort(port_name, port))
+    {
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port %s of FDB %s",
+                entry.bv_id, port_name.c_str(), entry.mac.to_string().c_str());
+        return false;
+    }
+    const Port &vlan = *vlanPort;
+
+    sai_status_t status;
+    if (macUpdate)
+    {
+        auto it_status = ctx.object_statuses.begin();
+        for (; it_status != ctx.object_statuses.end(); it_status++)
+        {
+            status = *it_status;
             if (status != SAI_STATUS_SUCCESS)
             {
-                SWSS_LOG_ERROR("macUpdate-Failed for attr.id=0x%x for FDB %s in %s on %s, rv:%d",
-                            itr.id, entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
+                SWSS_LOG_ERROR("macUpdate-Failed for FDB %s in %s on %s, rv:%d",
+                            entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
                 task_process_status handle_status = handleSaiSetStatus(SAI_API_FDB, status);
                 if (handle_status != task_success)
                 {
@@ -1405,19 +1747,18 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 }
             }
         }
-        if (oldPort.m_bridge_port_id != port.m_bridge_port_id)
+
+        const Port *oldPort = m_portsOrch->findPort(ctx.oldPortName);
+        if (oldPort && oldPort->m_bridge_port_id != port.m_bridge_port_id)
         {
-            oldPort.m_fdb_count--;
-            m_portsOrch->setPort(oldPort.m_alias, oldPort);
+            m_portsOrch->decrFdbCount(oldPort->m_alias, 1);
             port.m_fdb_count++;
-            m_portsOrch->setPort(port.m_alias, port);
+            m_portsOrch->incrFdbCount(port.m_alias, 1);
         }
     }
     else
     {
-        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
-
-        status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        status = ctx.object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
@@ -1430,9 +1771,8 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
             }
         }
         port.m_fdb_count++;
-        m_portsOrch->setPort(port.m_alias, port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->incrFdbCount(port.m_alias, 1);
+        m_portsOrch->incrFdbCount(vlan.m_alias, 1);
     }
 
     FdbData storeFdbData = fdbData;
@@ -1446,7 +1786,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         storeFdbData.type = "dynamic";
     }
 
-    m_entries[entry] = storeFdbData;
+    m_entries.set(entry, storeFdbData);
 
     string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
 
@@ -1512,6 +1852,26 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
 bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
 {
+    SWSS_LOG_ENTER();
+
+    FdbBulkContext ctx(entry, origin);
+    if (removeFdbEntry(ctx))
+    {
+        return true;
+    }
+    if (ctx.object_statuses.empty())
+    {
+        return false;
+    }
+
+    gFdbBulker.flush();
+    return removeFdbEntryPost(ctx);
+}
+
+bool FdbOrch::removeFdbEntry(FdbBulkContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    FdbOrigin origin = ctx.origin;
     Port vlan;
     Port port;
 
@@ -1535,7 +1895,7 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         return true;
     }
 
-    FdbData fdbData = it->second;
+    const FdbData& fdbData = it->second;
     if (!m_portsOrch->getPortByBridgePortId(fdbData.bridge_port_id, port))
     {
         SWSS_LOG_NOTICE("FdbOrch RemoveFDBEntry: Failed to locate port from bridge_port_id 0x%" PRIx64, fdbData.bridge_port_id);
@@ -1572,15 +1932,41 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    ctx.fdbData = fdbData;
+    ctx.port_name = port.m_alias;
 
-    sai_status_t status;
-    sai_fdb_entry_t fdb_entry;
+    sai_fdb_entry_t &fdb_entry = ctx.fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    status = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    ctx.object_statuses.emplace_back();
+    gFdbBulker.remove_entry(&ctx.object_statuses.back(), &fdb_entry);
+
+    return false;
+}
+
+bool FdbOrch::removeFdbEntryPost(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+
+    /* Ports are read again, the counters may have been updated by the entries of the same bulk */
+    const Port *vlanPort = m_portsOrch->findPort(entry.bv_id);
+    Port port;
+    if (!vlanPort || !m_portsOrch->getPort(ctx.port_name, port))
+    {
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port %s of FDB %s",
+                entry.bv_id, ctx.port_name.c_str(), entry.mac.to_string().c_str());
+        return false;
+    }
+    const Port &vlan = *vlanPort;
+
+    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+
+    sai_status_t status = ctx.object_statuses.front();
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64,
@@ -1596,9 +1982,8 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
             entry.mac.to_string().c_str(), entry.bv_id, port.m_alias.c_str());
 
     port.m_fdb_count--;
-    m_portsOrch->setPort(port.m_alias, port);
-    vlan.m_fdb_count--;
-    m_portsOrch->setPort(vlan.m_alias, vlan);
+    m_portsOrch->decrFdbCount(port.m_alias, 1);
+    m_portsOrch->decrFdbCount(vlan.m_alias, 1);
     (void)m_entries.erase(entry);
 
     // Remove in StateDb
@@ -1670,6 +2055,18 @@ void FdbOrch::deleteFdbEntryFromSavedFDB(const MacAddress &mac,
     }
 }
 
+// Notify the observers, or queue the update while a notification batch is processed
+void FdbOrch::notifyFdbChange(FdbUpdate& update)
+{
+    if (m_fdbBatch)
+    {
+        m_fdbBatch->updates.push_back(update);
+        return;
+    }
+
+    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+}
+
 // Notify Tunnel Orch when the number of MAC entries
 void FdbOrch::notifyTunnelOrch(Port& port)
 {
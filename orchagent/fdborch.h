@@ -1,9 +1,13 @@
 #ifndef SWSS_FDBORCH_H
 #define SWSS_FDBORCH_H
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 enum FdbOrigin
 {
@@ -38,6 +42,12 @@ struct FdbUpdate
     bool add;
 };
 
+/* The FDB changes of one fdb_event notification, in order */
+struct FdbBatchUpdate
+{
+    vector<FdbUpdate> updates;
+};
+
 struct FdbFlushUpdate
 {
     vector<FdbEntry> entries;
@@ -64,6 +74,84 @@ struct FdbData
     unsigned int vni;
 };
 
+struct FdbEntryHash
+{
+    size_t operator()(const FdbEntry& entry) const noexcept
+    {
+        size_t seed = boost::hash_range(entry.mac.getMac(), entry.mac.getMac() + sizeof(sai_mac_t));
+        boost::hash_combine(seed, entry.bv_id);
+        return seed;
+    }
+};
+
+/*
+ * FDB entries known by FdbOrch, indexed by MAC and bv_id, with secondary
+ * indices by bridge port and by bv_id so that a flush only visits the
+ * entries it removes.
+ *
+ * The data of an entry is only changed through set(), which keeps the
+ * indices in sync. As with std::map::operator[], setting the data of an
+ * existing entry keeps its key, including its port_name.
+ */
+class FdbEntryTable
+{
+public:
+    typedef unordered_map<FdbEntry, FdbData, FdbEntryHash>::value_type value_type;
+    typedef unordered_map<FdbEntry, FdbData, FdbEntryHash>::const_iterator const_iterator;
+
+    const_iterator begin() const { return m_entries.begin(); }
+    const_iterator end() const { return m_entries.end(); }
+    const_iterator find(const FdbEntry& entry) const { return m_entries.find(entry); }
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    void set(const FdbEntry& entry, const FdbData& data);
+    size_t erase(const FdbEntry& entry);
+
+    /*
+     * Call visitor(entry, data) on each entry of a bridge port or of a bv_id.
+     * The visitor must not modify the table, entries to remove are collected
+     * and removed after the walk.
+     */
+    template <typename Visitor>
+    void forEachByBridgePort(sai_object_id_t bridge_port_id, Visitor visitor) const
+    {
+        forEachIndexed(m_entriesByBridgePort, bridge_port_id, visitor);
+    }
+
+    template <typename Visitor>
+    void forEachByBvId(sai_object_id_t bv_id, Visitor visitor) const
+    {
+        forEachIndexed(m_entriesByBvId, bv_id, visitor);
+    }
+
+private:
+    /* The elements of an unordered_map keep their address until erased */
+    typedef unordered_map<sai_object_id_t, unordered_set<const value_type*>> EntryIndex;
+
+    unordered_map<FdbEntry, FdbData, FdbEntryHash> m_entries;
+    EntryIndex m_entriesByBridgePort;
+    EntryIndex m_entriesByBvId;
+
+    static void addToIndex(EntryIndex& index, sai_object_id_t id, const value_type* entry);
+    static void removeFromIndex(EntryIndex& index, sai_object_id_t id, const value_type* entry);
+
+    template <typename Visitor>
+    static void forEachIndexed(const EntryIndex& index, sai_object_id_t id, Visitor& visitor)
+    {
+        auto it = index.find(id);
+        if (it == index.end())
+        {
+            return;
+        }
+
+        for (const auto *entry : it->second)
+        {
+            visitor(entry->first, entry->second);
+        }
+    }
+};
+
 struct SavedFdbEntry
 {
     MacAddress mac;
@@ -77,6 +165,35 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+struct FdbBulkContext
+{
+    std::deque<sai_status_t>            object_statuses;    // Bulk statuses
+    FdbEntry                            entry;
+    string                              port_name;
+    FdbData                             fdbData;            // Data to add, or data of the removed entry
+    FdbOrigin                           origin;             // Origin of the removal
+    sai_fdb_entry_t                     fdb_entry;          // SAI entry queued in the bulker
+    bool                                macUpdate;          // Existing entry updated, else created
+    string                              oldPortName;
+    string                              oldType;
+    FdbOrigin                           oldOrigin;
+
+    FdbBulkContext(const FdbEntry& entry, const string& port_name, const FdbData& fdbData)
+        : entry(entry), port_name(port_name), fdbData(fdbData), origin(fdbData.origin),
+          macUpdate(false), oldOrigin(FDB_ORIGIN_INVALID)
+    {
+    }
+
+    FdbBulkContext(const FdbEntry& entry, FdbOrigin origin)
+        : entry(entry), origin(origin), macUpdate(false), oldOrigin(FDB_ORIGIN_INVALID)
+    {
+    }
+
+    // Disable any copy constructors
+    FdbBulkContext(const FdbBulkContext&) = delete;
+    FdbBulkContext(FdbBulkContext&&) = delete;
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -103,7 +220,7 @@ public:
 
 private:
     PortsOrch *m_portsOrch;
-    map<FdbEntry, FdbData> m_entries;
+    FdbEntryTable m_entries;
     fdb_entries_by_port_t saved_fdb_entries;
     vector<Table*> m_appTables;
     Table m_fdbStateTable;
@@ -111,17 +228,29 @@ private:
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
 
+    EntityBulker<sai_fdb_api_t> gFdbBulker;
+
+    /* Collects the FDB changes while a notification batch is processed */
+    FdbBatchUpdate *m_fdbBatch = nullptr;
+
     void doTask(Consumer& consumer);
     void doTask(NotificationConsumer& consumer);
+    void handleFdbEvents(const sai_fdb_event_notification_data_t *fdbevent, uint32_t count);
 
     void updateVlanMember(const VlanMemberUpdate&);
     void updatePortOperState(const PortOperStateUpdate&);
 
     bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    bool addFdbEntry(FdbBulkContext& ctx);
+    bool addFdbEntryPost(const FdbBulkContext& ctx);
+    bool removeFdbEntry(FdbBulkContext& ctx);
+    bool removeFdbEntryPost(const FdbBulkContext& ctx);
+    void updateMclagFdbState(const FdbBulkContext& ctx, const Port& vlan, const string& op);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
     bool storeFdbEntryState(const FdbUpdate& update);
     void notifyTunnelOrch(Port& port);
+    void notifyFdbChange(FdbUpdate& update);
 
     void clearFdbEntry(const MacAddress&, const sai_object_id_t&, const string&);
     void handleSyncdFlushNotif(const sai_object_id_t&, const sai_object_id_t&, const MacAddress& );
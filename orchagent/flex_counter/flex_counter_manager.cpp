@@ -17,6 +17,7 @@ using std::vector;
 using swss::DBConnector;
 using swss::FieldValueTuple;
 using swss::ProducerTable;
+using swss::RedisPipeline;
 
 const string FLEX_COUNTER_ENABLE("enable");
 const string FLEX_COUNTER_DISABLE("disable");
@@ -106,10 +107,10 @@ FlexCounterManager::FlexCounterManager(
     polling_interval(polling_interval),
     enabled(enabled),
     fv_plugin(fv_plugin),
-    flex_counter_db(new DBConnector(db_name, 0)),
-    flex_counter_group_table(new ProducerTable(flex_counter_db.get(),
+    flex_counter_pipeline(getPipeline(db_name)),
+    flex_counter_group_table(new ProducerTable(flex_counter_pipeline.get(),
                 FLEX_COUNTER_GROUP_TABLE)),
-    flex_counter_table(new ProducerTable(flex_counter_db.get(),
+    flex_counter_table(new ProducerTable(flex_counter_pipeline.get(),
                 FLEX_COUNTER_TABLE))
 {
     SWSS_LOG_ENTER();
@@ -152,6 +153,21 @@ void FlexCounterManager::applyGroupConfiguration()
     flex_counter_group_table->set(group_name, field_values);
 }
 
+// reapplyGroupConfiguration applies the group configuration again, once per
+// batch.
+void FlexCounterManager::reapplyGroupConfiguration()
+{
+    SWSS_LOG_ENTER();
+
+    if (batch_depth)
+    {
+        group_configuration_pending = true;
+        return;
+    }
+
+    applyGroupConfiguration();
+}
+
 void FlexCounterManager::updateGroupPollingInterval(
         const uint polling_interval)
 {
@@ -263,6 +279,82 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
             group_name.c_str());
 }
 
+// beginBatch buffers the writes to the flex counter DB until the matching
+// commitBatch.
+void FlexCounterManager::beginBatch()
+{
+    SWSS_LOG_ENTER();
+
+    if (batch_depth++ == 0)
+    {
+        flex_counter_group_table->setBuffered(true);
+        flex_counter_table->setBuffered(true);
+    }
+}
+
+// commitBatch sends the writes buffered since the outermost beginBatch, along
+// with those the other managers of the DB buffered in the shared pipeline.
+void FlexCounterManager::commitBatch()
+{
+    SWSS_LOG_ENTER();
+
+    if (batch_depth == 0)
+    {
+        SWSS_LOG_WARN("No batch to commit for flex counter group '%s'.",
+                group_name.c_str());
+        return;
+    }
+
+    if (--batch_depth)
+    {
+        return;
+    }
+
+    if (group_configuration_pending)
+    {
+        applyGroupConfiguration();
+        group_configuration_pending = false;
+    }
+
+    flex_counter_pipeline->flush();
+    flex_counter_group_table->setBuffered(false);
+    flex_counter_table->setBuffered(false);
+
+    SWSS_LOG_DEBUG("Committed flex counter batch for group '%s'.",
+            group_name.c_str());
+}
+
+// getPipeline returns the pipeline shared by the managers of a DB, so that
+// they use one connection. It is released with the last of these managers.
+shared_ptr<RedisPipeline> FlexCounterManager::getPipeline(const string& db_name)
+{
+    SWSS_LOG_ENTER();
+
+    struct DbPipeline
+    {
+        DBConnector db;
+        RedisPipeline pipeline;
+
+        DbPipeline(const string& db_name) :
+            db(db_name, 0),
+            pipeline(&db)
+        {
+        }
+    };
+
+    static unordered_map<string, std::weak_ptr<RedisPipeline>> pipelines;
+
+    auto pipeline = pipelines[db_name].lock();
+    if (!pipeline)
+    {
+        auto db_pipeline = std::make_shared<DbPipeline>(db_name);
+        pipeline = shared_ptr<RedisPipeline>(db_pipeline, &db_pipeline->pipeline);
+        pipelines[db_name] = pipeline;
+    }
+
+    return pipeline;
+}
+
 string FlexCounterManager::getFlexCounterTableKey(
         const string& group_name,
         const sai_object_id_t object_id) const
@@ -293,3 +385,24 @@ string FlexCounterManager::serializeCounterStats(
 
     return stats_string;
 }
+
+FlexCounterBatch::FlexCounterBatch(std::initializer_list<FlexCounterManager*> managers) :
+    managers(managers)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto manager : this->managers)
+    {
+        manager->beginBatch();
+    }
+}
+
+FlexCounterBatch::~FlexCounterBatch()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto manager : managers)
+    {
+        manager->commitBatch();
+    }
+}
@@ -5,7 +5,11 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
+#include <initializer_list>
+#include <memory>
 #include "dbconnector.h"
+#include "redispipeline.h"
 #include "producertable.h"
 #include "table.h"
 #include <inttypes.h>
@@ -74,6 +78,12 @@ class FlexCounterManager
                 const std::unordered_set<std::string>& counter_stats);
         void clearCounterIdList(const sai_object_id_t object_id);
 
+        // Writes between beginBatch() and commitBatch() are sent to the flex
+        // counter DB in one pipeline. Batches may be nested, the outermost
+        // commitBatch() sends them.
+        void beginBatch();
+        void commitBatch();
+
         const std::string& getGroupName() const
         {
             return group_name;
@@ -96,6 +106,7 @@ class FlexCounterManager
 
     protected:
         void applyGroupConfiguration();
+        void reapplyGroupConfiguration();
 
     private:
         std::string getFlexCounterTableKey(
@@ -103,6 +114,7 @@ class FlexCounterManager
                 const sai_object_id_t object_id) const;
         std::string serializeCounterStats(
                 const std::unordered_set<std::string>& counter_stats) const;
+        static std::shared_ptr<swss::RedisPipeline> getPipeline(const std::string& db_name);
 
         std::string group_name;
         StatsMode stats_mode;
@@ -111,7 +123,10 @@ class FlexCounterManager
         swss::FieldValueTuple fv_plugin;
         std::unordered_set<sai_object_id_t> installed_counters;
 
-        std::shared_ptr<swss::DBConnector> flex_counter_db = nullptr;
+        uint batch_depth = 0;
+        bool group_configuration_pending = false;
+
+        std::shared_ptr<swss::RedisPipeline> flex_counter_pipeline = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_group_table = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_table = nullptr;
 
@@ -120,6 +135,21 @@ class FlexCounterManager
         static const std::unordered_map<CounterType, std::string> counter_id_field_lookup;
 };
 
+// FlexCounterBatch batches the writes of the given managers during its
+// lifetime.
+class FlexCounterBatch
+{
+    public:
+        FlexCounterBatch(std::initializer_list<FlexCounterManager*> managers);
+        ~FlexCounterBatch();
+
+        FlexCounterBatch(const FlexCounterBatch&) = delete;
+        FlexCounterBatch& operator=(const FlexCounterBatch&) = delete;
+
+    private:
+        std::vector<FlexCounterManager*> managers;
+};
+
 class FlexManagerDirectory
 {
     public:
@@ -48,7 +48,7 @@ void FlexCounterStatManager::addFlexCounterStat(
     // stats are removed from a flex counter group. This will be fixed once
     // syncd flex counters are refactored. For now, we can workaround this
     // by re-applying the group configuration when we set the counter id list.
-    FlexCounterManager::applyGroupConfiguration();
+    FlexCounterManager::reapplyGroupConfiguration();
 
     FlexCounterManager::setCounterIdList(object_id, counter_type, counter_stats->second);
 
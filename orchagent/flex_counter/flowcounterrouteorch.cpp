@@ -105,6 +105,9 @@ void FlowCounterRouteOrch::doTask(SelectableTimer &timer)
     std::string pattern;
     vector<FieldValueTuple> prefixToCounterMap;
     vector<FieldValueTuple> prefixToPatternMap;
+    std::unordered_set<std::string> counter_stats;
+    FlowCounterHandler::getGenericCounterStatIdList(counter_stats);
+    FlexCounterBatch batch({ &mRouteFlowCounterMgr });
     for (auto it = mPendingAddToFlexCntr.begin(); it != mPendingAddToFlexCntr.end(); )
     {
         const auto& route_pattern = it->first;
@@ -118,8 +121,6 @@ void FlowCounterRouteOrch::doTask(SelectableTimer &timer)
                 auto ip_prefix = inner_iter->first;
                 SWSS_LOG_INFO("Registering %s, id %s", ip_prefix.to_string().c_str(), id.c_str());
 
-                std::unordered_set<std::string> counter_stats;
-                FlowCounterHandler::getGenericCounterStatIdList(counter_stats);
                 mRouteFlowCounterMgr.setCounterIdList(inner_iter->second, CounterType::ROUTE, counter_stats);
 
                 getRouteFlowCounterNameMapKey(vrf_id, ip_prefix, nameMapKey);
@@ -197,6 +198,7 @@ void FlowCounterRouteOrch::clearRouteFlowStats()
     SWSS_LOG_ENTER();
     if (!mBoundRouteCounters.empty() || !mPendingAddToFlexCntr.empty())
     {
+        FlexCounterBatch batch({ &mRouteFlowCounterMgr });
         for (auto &entry : mBoundRouteCounters)
         {
             const auto& route_pattern = entry.first;
@@ -283,6 +285,7 @@ void FlowCounterRouteOrch::removeRoutePattern(const RoutePattern &route_pattern)
     auto cache_iter = mBoundRouteCounters.find(route_pattern);
     if (cache_iter != mBoundRouteCounters.end())
     {
+        FlexCounterBatch batch({ &mRouteFlowCounterMgr });
         for (auto &entry : cache_iter->second)
         {
             removeRouteFlowCounterFromDB(route_pattern.vrf_id, entry.first, entry.second);
@@ -771,6 +774,7 @@ void FlowCounterRouteOrch::reapRouteFlowCounterByPattern(const RoutePattern &rou
     // Remove from bound cache
     if (iter != mBoundRouteCounters.end())
     {
+        FlexCounterBatch batch({ &mRouteFlowCounterMgr });
         while(current_bound_count > route_pattern.max_match_count)
         {
             auto bound_iter = iter->second.begin();
@@ -0,0 +1,263 @@
+#include <algorithm>
+
+#include "flushpolicyorch.h"
+#include "bulker.h"
+#include "converter.h"
+
+using namespace std;
+using namespace swss;
+
+#define FLUSH_POLICY_KEY                "global"
+#define FLUSH_POLICY_MAX_OPS            "max_ops"
+#define FLUSH_POLICY_MAX_BYTES          "max_bytes"
+#define FLUSH_POLICY_MAX_AGE_MS         "max_age_ms"
+#define FLUSH_POLICY_FLUSH_ON_IDLE      "flush_on_idle"
+
+#define FLUSH_POLICY_MAX_OPS_DEFAULT        1000
+#define FLUSH_POLICY_MAX_BYTES_DEFAULT      (1024 * 1024)
+#define FLUSH_POLICY_MAX_AGE_MS_DEFAULT     50
+#define FLUSH_POLICY_FLUSH_ON_IDLE_DEFAULT  false
+
+#define FLUSH_STATS_KEY                 "STATS"
+#define FLUSH_STATS_INTERVAL            10
+
+static const char *flushReasonNames[] = { "OPS", "BYTES", "AGE", "IDLE", "FORCED" };
+
+/* Upper bounds of the batch size buckets, the last bucket is unbounded */
+static const size_t batchSizeBounds[] = { 1, 10, 100, 1000 };
+
+FlushPolicyOrch::FlushPolicyOrch(DBConnector *configDb, const string &tableName) :
+    Orch(configDb, tableName),
+    m_maxOps(FLUSH_POLICY_MAX_OPS_DEFAULT),
+    m_maxBytes(FLUSH_POLICY_MAX_BYTES_DEFAULT),
+    m_maxAgeMs(FLUSH_POLICY_MAX_AGE_MS_DEFAULT),
+    m_flushOnIdle(FLUSH_POLICY_FLUSH_ON_IDLE_DEFAULT),
+    m_bulkerOps(bulkerCounters().ops),
+    m_bulkerBytes(bulkerCounters().bytes)
+{
+    SWSS_LOG_ENTER();
+
+    m_countersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
+    m_countersTable = unique_ptr<Table>(new Table(m_countersDb.get(), COUNTERS_SAIREDIS_FLUSH_TABLE_NAME));
+
+    auto interv = timespec { .tv_sec = FLUSH_STATS_INTERVAL, .tv_nsec = 0 };
+    m_statsTimer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(m_statsTimer, this, "SAIREDIS_FLUSH_STATS_TIMER");
+    Orch::addExecutor(executor);
+    m_statsTimer->start();
+}
+
+void FlushPolicyOrch::addOperations(size_t ops, size_t bytes)
+{
+    if (ops == 0)
+    {
+        return;
+    }
+
+    if (m_pendingOps == 0)
+    {
+        m_oldestPending = chrono::steady_clock::now();
+    }
+
+    m_pendingOps += ops;
+    m_pendingBytes += bytes;
+}
+
+void FlushPolicyOrch::addBulkerOperations()
+{
+    const auto &counters = bulkerCounters();
+
+    addOperations(static_cast<size_t>(counters.ops - m_bulkerOps),
+                  static_cast<size_t>(counters.bytes - m_bulkerBytes));
+
+    m_bulkerOps = counters.ops;
+    m_bulkerBytes = counters.bytes;
+}
+
+bool FlushPolicyOrch::needFlush(FlushReason &reason) const
+{
+    if (m_pendingOps == 0)
+    {
+        return false;
+    }
+
+    if (m_pendingOps >= m_maxOps)
+    {
+        reason = FlushReason::OPS;
+        return true;
+    }
+
+    if (m_pendingBytes >= m_maxBytes)
+    {
+        reason = FlushReason::BYTES;
+        return true;
+    }
+
+    auto age = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - m_oldestPending);
+    if (age.count() >= m_maxAgeMs)
+    {
+        reason = FlushReason::AGE;
+        return true;
+    }
+
+    return false;
+}
+
+int FlushPolicyOrch::getSelectTimeout(int timeout) const
+{
+    if (m_pendingOps == 0)
+    {
+        return timeout;
+    }
+
+    auto age = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - m_oldestPending);
+    auto left = static_cast<int64_t>(m_maxAgeMs) - age.count();
+
+    return static_cast<int>(max<int64_t>(0, min<int64_t>(timeout, left)));
+}
+
+void FlushPolicyOrch::onFlush(FlushReason reason)
+{
+    m_flushCount[static_cast<size_t>(reason)]++;
+
+    if (m_pendingOps != 0)
+    {
+        size_t bucket = 0;
+        while (bucket < sizeof(batchSizeBounds) / sizeof(batchSizeBounds[0]) && m_pendingOps > batchSizeBounds[bucket])
+        {
+            bucket++;
+        }
+        m_batchSizeBuckets[bucket]++;
+
+        m_totalOps += m_pendingOps;
+        m_totalBytes += m_pendingBytes;
+        m_lastBatchOps = m_pendingOps;
+        m_lastBatchBytes = m_pendingBytes;
+        m_maxBatchOps = max(m_maxBatchOps, m_pendingOps);
+    }
+
+    SWSS_LOG_DEBUG("Flushed %zu ops %zu bytes on %s", m_pendingOps, m_pendingBytes,
+                   flushReasonNames[static_cast<size_t>(reason)]);
+
+    m_pendingOps = 0;
+    m_pendingBytes = 0;
+    m_statsChanged = true;
+}
+
+void FlushPolicyOrch::doTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        KeyOpFieldsValuesTuple t = it->second;
+
+        const string &key = kfvKey(t);
+        const string &op = kfvOp(t);
+
+        if (key != FLUSH_POLICY_KEY)
+        {
+            SWSS_LOG_ERROR("Unknown flush policy key %s", key.c_str());
+        }
+        else if (op == SET_COMMAND)
+        {
+            for (const auto &i : kfvFieldsValues(t))
+            {
+                const auto &field = fvField(i);
+                const auto &value = fvValue(i);
+
+                try
+                {
+                    if (field == FLUSH_POLICY_MAX_OPS)
+                    {
+                        m_maxOps = to_uint<uint32_t>(value, 1);
+                    }
+                    else if (field == FLUSH_POLICY_MAX_BYTES)
+                    {
+                        m_maxBytes = to_uint<uint32_t>(value, 1);
+                    }
+                    else if (field == FLUSH_POLICY_MAX_AGE_MS)
+                    {
+                        m_maxAgeMs = to_uint<uint32_t>(value);
+                    }
+                    else if (field == FLUSH_POLICY_FLUSH_ON_IDLE)
+                    {
+                        if (value != "true" && value != "false")
+                        {
+                            throw invalid_argument("expected true or false");
+                        }
+                        m_flushOnIdle = value == "true";
+                    }
+                    else
+                    {
+                        SWSS_LOG_ERROR("Unknown flush policy attribute %s", field.c_str());
+                    }
+                }
+                catch (const exception &e)
+                {
+                    SWSS_LOG_ERROR("Failed to parse flush policy attribute %s value %s: %s",
+                                   field.c_str(), value.c_str(), e.what());
+                }
+            }
+
+            SWSS_LOG_NOTICE("Flush policy: max_ops %zu max_bytes %zu max_age_ms %u flush_on_idle %s",
+                            m_maxOps, m_maxBytes, m_maxAgeMs, m_flushOnIdle ? "true" : "false");
+        }
+        else if (op == DEL_COMMAND)
+        {
+            m_maxOps = FLUSH_POLICY_MAX_OPS_DEFAULT;
+            m_maxBytes = FLUSH_POLICY_MAX_BYTES_DEFAULT;
+            m_maxAgeMs = FLUSH_POLICY_MAX_AGE_MS_DEFAULT;
+            m_flushOnIdle = FLUSH_POLICY_FLUSH_ON_IDLE_DEFAULT;
+
+            SWSS_LOG_NOTICE("Flush policy reset to defaults");
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+        }
+
+        it = consumer.m_toSync.erase(it);
+    }
+}
+
+void FlushPolicyOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_statsChanged)
+    {
+        publishStats();
+        m_statsChanged = false;
+    }
+}
+
+void FlushPolicyOrch::publishStats()
+{
+    vector<FieldValueTuple> fvs;
+    uint64_t flushes = 0;
+
+    for (size_t i = 0; i < sizeof(flushReasonNames) / sizeof(flushReasonNames[0]); i++)
+    {
+        fvs.emplace_back(string("FLUSH_ON_") + flushReasonNames[i], to_string(m_flushCount[i]));
+        flushes += m_flushCount[i];
+    }
+    fvs.emplace_back("FLUSH_COUNT", to_string(flushes));
+
+    for (size_t i = 0; i < sizeof(m_batchSizeBuckets) / sizeof(m_batchSizeBuckets[0]); i++)
+    {
+        string name = i < sizeof(batchSizeBounds) / sizeof(batchSizeBounds[0]) ?
+            "BATCH_OPS_LE_" + to_string(batchSizeBounds[i]) :
+            "BATCH_OPS_GT_" + to_string(batchSizeBounds[i - 1]);
+        fvs.emplace_back(name, to_string(m_batchSizeBuckets[i]));
+    }
+
+    fvs.emplace_back("TOTAL_OPS", to_string(m_totalOps));
+    fvs.emplace_back("TOTAL_BYTES", to_string(m_totalBytes));
+    fvs.emplace_back("LAST_BATCH_OPS", to_string(m_lastBatchOps));
+    fvs.emplace_back("LAST_BATCH_BYTES", to_string(m_lastBatchBytes));
+    fvs.emplace_back("MAX_BATCH_OPS", to_string(m_maxBatchOps));
+
+    m_countersTable->set(FLUSH_STATS_KEY, fvs);
+}
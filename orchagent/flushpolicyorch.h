@@ -0,0 +1,97 @@
+#ifndef SWSS_FLUSHPOLICYORCH_H
+#define SWSS_FLUSHPOLICYORCH_H
+
+#include <chrono>
+#include <memory>
+
+#include "orch.h"
+#include "timer.h"
+
+#define CFG_SAIREDIS_FLUSH_POLICY_TABLE_NAME "SAIREDIS_FLUSH_POLICY"
+#define COUNTERS_SAIREDIS_FLUSH_TABLE_NAME "SAIREDIS_FLUSH"
+
+enum class FlushReason
+{
+    OPS,
+    BYTES,
+    AGE,
+    IDLE,
+    FORCED
+};
+
+/*
+ * Decide when OrchDaemon flushes the sairedis pipeline.
+ *
+ * The work queued since the last flush is accounted where it is written to
+ * the pipeline: the number and estimated size of the operations flushed by
+ * the bulkers (routes, next hops, neighbors, FDB entries, VLAN and LAG
+ * members...). The pipeline is flushed when the queued operations reach
+ * max_ops or max_bytes, when the oldest queued operation is older than
+ * max_age_ms, or as soon as all consumers are idle when flush_on_idle is set.
+ * Operations issued one by one are not accounted, they are flushed on the
+ * select() timeout and once per SELECT_TIMEOUT as before.
+ *
+ * By default max_age_ms bounds the delay of a small update (e.g. a single
+ * route) to a fraction of SELECT_TIMEOUT, while max_ops lets a full table
+ * download be written in large batches.
+ *
+ * The thresholds are configured in CONFIG_DB SAIREDIS_FLUSH_POLICY|global,
+ * the flush counts and batch sizes are published in COUNTERS_DB
+ * SAIREDIS_FLUSH:STATS.
+ */
+class FlushPolicyOrch : public Orch
+{
+public:
+    FlushPolicyOrch(swss::DBConnector *configDb, const std::string &tableName);
+
+    /* Account the operations queued to the pipeline */
+    void addOperations(size_t ops, size_t bytes);
+
+    /* Account the operations written by the bulkers since the last call */
+    void addBulkerOperations();
+
+    bool hasPendingOperations() const { return m_pendingOps != 0; }
+    bool getFlushOnIdle() const { return m_flushOnIdle; }
+
+    /* Return true if a threshold is reached, 'reason' tells which one */
+    bool needFlush(FlushReason &reason) const;
+
+    /* Shorten the select timeout so that the age threshold is honored */
+    int getSelectTimeout(int timeout) const;
+
+    /* Account a flush of the pipeline */
+    void onFlush(FlushReason reason);
+
+private:
+    size_t m_maxOps;
+    size_t m_maxBytes;
+    uint32_t m_maxAgeMs;
+    bool m_flushOnIdle;
+
+    size_t m_pendingOps = 0;
+    size_t m_pendingBytes = 0;
+    uint64_t m_bulkerOps;
+    uint64_t m_bulkerBytes;
+    std::chrono::steady_clock::time_point m_oldestPending;
+
+    /* Statistics */
+    uint64_t m_flushCount[static_cast<size_t>(FlushReason::FORCED) + 1] = {};
+    uint64_t m_batchSizeBuckets[5] = {};
+    uint64_t m_totalOps = 0;
+    uint64_t m_totalBytes = 0;
+    size_t m_lastBatchOps = 0;
+    size_t m_lastBatchBytes = 0;
+    size_t m_maxBatchOps = 0;
+    bool m_statsChanged = false;
+
+    std::shared_ptr<swss::DBConnector> m_countersDb;
+    std::unique_ptr<swss::Table> m_countersTable;
+    swss::SelectableTimer *m_statsTimer;
+
+    void doTask(Consumer &consumer) override;
+    void doTask(swss::SelectableTimer &timer) override;
+
+    void publishStats();
+};
+
+#endif /* SWSS_FLUSHPOLICYORCH_H */
@@ -114,9 +114,8 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
 
 sai_object_id_t IntfsOrch::getRouterIntfsId(const string &alias)
 {
-    Port port;
-    gPortsOrch->getPort(alias, port);
-    return port.m_rif_id;
+    const Port *port = gPortsOrch->findPort(alias);
+    return port ? port->m_rif_id : SAI_NULL_OBJECT_ID;
 }
 
 bool IntfsOrch::isPrefixSubnet(const IpPrefix &ip_prefix, const string &alias)
@@ -1183,6 +1182,8 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port)
 
     SWSS_LOG_NOTICE("Create router interface %s MTU %u", port.m_alias.c_str(), port.m_mtu);
 
+    m_dependencySubject.publish(port.m_alias);
+
     if(gMySwitchType == "voq")
     {
         // Sync the interface of local port/LAG to the SYSTEM_INTERFACE table of CHASSIS_APP_DB
@@ -1532,15 +1533,15 @@ void IntfsOrch::doTask(SelectableTimer &timer)
 
 bool IntfsOrch::isRemoteSystemPortIntf(string alias)
 {
-    Port port;
-    if(gPortsOrch->getPort(alias, port))
+    const Port *port = gPortsOrch->findPort(alias);
+    if (port)
     {
-        if (port.m_type == Port::LAG)
+        if (port->m_type == Port::LAG)
         {
-            return(port.m_system_lag_info.switch_id != gVoqMySwitchId);
+            return(port->m_system_lag_info.switch_id != gVoqMySwitchId);
         }
 
-        return(port.m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE);
+        return(port->m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE);
     }
     //Given alias is system port alias of the local port/LAG
     return false;
@@ -1550,24 +1551,24 @@ void IntfsOrch::voqSyncAddIntf(string &alias)
 {
     //Sync only local interface. Confirm for the local interface and
     //get the system port alias for key for syncing to CHASSIS_APP_DB
-    Port port;
-    if(gPortsOrch->getPort(alias, port))
+    const Port *port = gPortsOrch->findPort(alias);
+    if (port)
     {
-        if (port.m_type == Port::LAG)
+        if (port->m_type == Port::LAG)
         {
-            if (port.m_system_lag_info.switch_id != gVoqMySwitchId)
+            if (port->m_system_lag_info.switch_id != gVoqMySwitchId)
             {
                 return;
             }
-            alias = port.m_system_lag_info.alias;
+            alias = port->m_system_lag_info.alias;
         }
         else
         {
-            if(port.m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
+            if(port->m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
             {
                 return;
             }
-            alias = port.m_system_port_info.alias;
+            alias = port->m_system_port_info.alias;
         }
     }
     else
@@ -1587,24 +1588,24 @@ void IntfsOrch::voqSyncDelIntf(string &alias)
 {
     //Sync only local interface. Confirm for the local interface and
     //get the system port alias for key for syncing to CHASSIS_APP_DB
-    Port port;
-    if(gPortsOrch->getPort(alias, port))
+    const Port *port = gPortsOrch->findPort(alias);
+    if (port)
     {
-        if (port.m_type == Port::LAG)
+        if (port->m_type == Port::LAG)
         {
-            if (port.m_system_lag_info.switch_id != gVoqMySwitchId)
+            if (port->m_system_lag_info.switch_id != gVoqMySwitchId)
             {
                 return;
             }
-            alias = port.m_system_lag_info.alias;
+            alias = port->m_system_lag_info.alias;
         }
         else
         {
-            if(port.m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
+            if(port->m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
             {
                 return;
             }
-            alias = port.m_system_port_info.alias;
+            alias = port->m_system_port_info.alias;
         }
     }
     else
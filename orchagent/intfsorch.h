@@ -5,6 +5,7 @@
 #include "portsorch.h"
 #include "vrforch.h"
 #include "timer.h"
+#include "taskdependency.h"
 
 #include "ipaddresses.h"
 #include "ipprefix.h"
@@ -69,7 +70,14 @@ public:
 
     bool isRemoteSystemPortIntf(string alias);
 
+    /* Publishes the alias of each router interface being created */
+    DependencySubject& getDependencySubject()
+    {
+        return m_dependencySubject;
+    }
+
 private:
+    DependencySubject m_dependencySubject;
 
     SelectableTimer* m_updateMapsTimer = nullptr;
     std::vector<Port> m_rifsToAdd;
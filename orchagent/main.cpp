@@ -50,6 +50,10 @@ MacAddress gMacAddress;
 MacAddress gVxlanMacAddress;
 
 extern size_t gMaxBulkSize;
+extern uint32_t gConsumerTimeBudgetMsecs;
+extern uint32_t gParseThreads;
+extern bool gNhgInPlaceUpdate;
+extern bool gRoutePic;
 
 #define DEFAULT_BATCH_SIZE  128
 int gBatchSize = DEFAULT_BATCH_SIZE;
@@ -84,7 +88,7 @@ string gMyAsicName = "";
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-t time_budget] [-p parse_threads] [-e] [-c]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    Bit 0: sairedis.rec, Bit 1: swss.rec, Bit 2: responsepublisher.rec. For example:" << endl;
@@ -102,6 +106,11 @@ void usage()
     cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec')" << endl;
     cout << "    -j sairedis_rec_filename: sairedis record log filename(default sairedis.rec)" << endl;
     cout << "    -k max bulk size in bulk mode (default 1000)" << endl;
+    cout << "    -t time_budget: max time in ms a consumer table is processed before yielding to others, 0 to disable (default 0)" << endl;
+    cout << "                   PORT_TABLE, NEIGH_TABLE and BFD_SESSION_TABLE are always processed in full" << endl;
+    cout << "    -p parse_threads: number of threads pre-parsing route entries, 0 to parse them on the main thread (default 0)" << endl;
+    cout << "    -e update the members of a next hop group in place when a single route uses it" << endl;
+    cout << "    -c share a next hop group per MUX neighbor among its single path routes, a MUX switchover is then one update per neighbor" << endl;
 }
 
 void sighup_handler(int signo)
@@ -337,7 +346,7 @@ int main(int argc, char **argv)
     string responsepublisher_rec_filename = "responsepublisher.rec";
     int record_type = 3; // Only swss and sairedis recordings enabled by default.
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:t:p:ec")) != -1)
     {
         switch (opt)
         {
@@ -415,6 +424,42 @@ int main(int argc, char **argv)
                 }
             }
             break;
+        case 't':
+            {
+                auto budget = atoi(optarg);
+                if (budget >= 0)
+                {
+                    gConsumerTimeBudgetMsecs = static_cast<uint32_t>(budget);
+                    SWSS_LOG_NOTICE("Setting consumer time budget as %u ms", gConsumerTimeBudgetMsecs);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for consumer time budget: %d. Ignoring.", budget);
+                }
+            }
+            break;
+        case 'p':
+            {
+                auto threads = atoi(optarg);
+                if (threads >= 0)
+                {
+                    gParseThreads = static_cast<uint32_t>(threads);
+                    SWSS_LOG_NOTICE("Setting route parse threads as %u", gParseThreads);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for route parse threads: %d. Ignoring.", threads);
+                }
+            }
+            break;
+        case 'e':
+            gNhgInPlaceUpdate = true;
+            SWSS_LOG_NOTICE("Enabling in place next hop group updates");
+            break;
+        case 'c':
+            gRoutePic = true;
+            SWSS_LOG_NOTICE("Enabling shared next hop groups for the single path routes of MUX neighbors");
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
@@ -180,6 +180,15 @@ void MirrorOrch::update(SubjectType type, void *cntx)
         updateFdb(*update);
         break;
     }
+    case SUBJECT_TYPE_FDB_BATCH_CHANGE:
+    {
+        FdbBatchUpdate *batch = static_cast<FdbBatchUpdate *>(cntx);
+        for (const auto& update : batch->updates)
+        {
+            updateFdb(update);
+        }
+        break;
+    }
     case SUBJECT_TYPE_LAG_MEMBER_CHANGE:
     {
         LagMemberUpdate *update = static_cast<LagMemberUpdate *>(cntx);
@@ -271,13 +280,13 @@ bool MirrorOrch::decreaseRefCount(const string& name)
 
 bool MirrorOrch::validateDstPort(const string& dstPort)
 {
-    Port port;
-    if (!m_portsOrch->getPort(dstPort, port))
+    const Port *port = m_portsOrch->findPort(dstPort);
+    if (!port)
     {
-        SWSS_LOG_ERROR("Not supported port %s type %d", dstPort.c_str(), port.m_type);
+        SWSS_LOG_ERROR("Failed to locate port %s", dstPort.c_str());
         return false;
     }
-    if (port.m_type != Port::PHY)
+    if (port->m_type != Port::PHY)
     {
         SWSS_LOG_ERROR("Not supported port %s", dstPort.c_str());
         return false;
@@ -310,31 +319,31 @@ bool MirrorOrch::validateSrcPortList(const string& srcPortList)
     {
         for (auto alias : ports)
         {
-            Port port;
-            if (!gPortsOrch->getPort(alias, port))
+            const Port *port = gPortsOrch->findPort(alias);
+            if (!port)
             {
                 SWSS_LOG_ERROR("Failed to locate Port/LAG %s", alias.c_str());
                 return false;
             }
 
-            if(!(port.m_type == Port::PHY || port.m_type == Port::LAG))
+            if(!(port->m_type == Port::PHY || port->m_type == Port::LAG))
             {
                 SWSS_LOG_ERROR("Not supported port %s", alias.c_str());
                 return false;
             }
 
             // Check if the ports in LAG are part of source port list
-            if (port.m_type == Port::LAG)
+            if (port->m_type == Port::LAG)
             {
                 vector<Port> portv;
                 int portCount = 0;
-                m_portsOrch->getLagMember(port, portv);
+                m_portsOrch->getLagMember(*port, portv);
                 for (const auto p : portv)
                 {
                     if (checkPortExistsInSrcPortList(p.m_alias, srcPortList))
                     {
                         SWSS_LOG_ERROR("Port %s in LAG %s is also part of src_port config %s",
-                                  p.m_alias.c_str(), port.m_alias.c_str(), srcPortList.c_str());
+                                  p.m_alias.c_str(), port->m_alias.c_str(), srcPortList.c_str());
                         return false;
                     }
                     portCount++;
@@ -342,7 +351,7 @@ bool MirrorOrch::validateSrcPortList(const string& srcPortList)
                 if (!portCount)
                 {
                     SWSS_LOG_ERROR("Source LAG %s is empty. set mirror session to inactive",
-                             port.m_alias.c_str());;
+                             port->m_alias.c_str());;
                     return false;
                 }
             }
@@ -904,15 +913,15 @@ bool MirrorOrch::activateSession(const string& name, MirrorEntry& session)
 
     if (session.type == MIRROR_SESSION_SPAN)
     {
-        Port dst_port;
-        if (!m_portsOrch->getPort(session.dst_port, dst_port))
+        const Port *dst_port = m_portsOrch->findPort(session.dst_port);
+        if (!dst_port)
         {
             SWSS_LOG_ERROR("Failed to locate Port/LAG %s", session.dst_port.c_str());
             return false;
         }
 
         attr.id = SAI_MIRROR_SESSION_ATTR_MONITOR_PORT;
-        attr.value.oid = dst_port.m_port_id;
+        attr.value.oid = dst_port->m_port_id;
         attrs.push_back(attr);
 
         attr.id = SAI_MIRROR_SESSION_ATTR_TYPE;
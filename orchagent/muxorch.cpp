@@ -1179,6 +1179,15 @@ void MuxOrch::update(SubjectType type, void *cntx)
             updateFdb(*update);
             break;
         }
+        case SUBJECT_TYPE_FDB_BATCH_CHANGE:
+        {
+            FdbBatchUpdate *batch = static_cast<FdbBatchUpdate *>(cntx);
+            for (const auto& update : batch->updates)
+            {
+                updateFdb(update);
+            }
+            break;
+        }
         default:
             /* Received update in which we are not interested
              * Ignore it
@@ -21,6 +21,7 @@ extern FgNhgOrch *gFgNhgOrch;
 extern Directory<Orch*> gDirectory;
 extern string gMySwitchType;
 extern int32_t gVoqMySwitchId;
+extern size_t gMaxBulkSize;
 
 const int neighorch_pri = 30;
 
@@ -29,7 +30,9 @@ NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch,
         m_intfsOrch(intfsOrch),
         m_fdbOrch(fdbOrch),
         m_portsOrch(portsOrch),
-        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME)
+        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME),
+        gNeighBulker(sai_neighbor_api, gMaxBulkSize),
+        gNextHopBulker(sai_next_hop_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -113,22 +116,22 @@ void NeighOrch::processFDBFlushUpdate(const FdbFlushUpdate& update)
     for (auto entry : update.entries)
     {
         // Get Vlan object
-        Port vlan;
-        if (!m_portsOrch->getPort(entry.bv_id, vlan))
+        const Port *vlan = m_portsOrch->findPort(entry.bv_id);
+        if (!vlan)
         {
             SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port \
                              from bv_id 0x%" PRIx64 ".", entry.bv_id);
             continue;
         }
         SWSS_LOG_INFO("Flushing ARP for port: %s, VLAN: %s",
-                      vlan.m_alias.c_str(), update.port.m_alias.c_str());
+                      vlan->m_alias.c_str(), update.port.m_alias.c_str());
 
         // If the FDB entry MAC matches with neighbor/ARP entry MAC,
         // and ARP entry incoming interface matches with VLAN name,
         // flush neighbor/arp entry.
         for (const auto &neighborEntry : m_syncdNeighbors)
         {
-            if (neighborEntry.first.alias == vlan.m_alias &&
+            if (neighborEntry.first.alias == vlan->m_alias &&
                 neighborEntry.second.mac == entry.mac)
             {
                 resolveNeighborEntry(neighborEntry.first, neighborEntry.second.mac);
@@ -185,16 +188,73 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
 {
     SWSS_LOG_ENTER();
 
-    Port p;
-    if (!gPortsOrch->getPort(nh.alias, p))
+    /* Complete the queued next hops first, the bulker is flushed below */
+    flushNextHops();
+
+    NextHopBulkContext ctx(nh);
+    if (!addNextHop(ctx))
+    {
+        return false;
+    }
+
+    gNextHopBulker.flush();
+    return addNextHopPost(ctx);
+}
+
+bool NeighOrch::queueNextHop(const NextHopKey &nh)
+{
+    SWSS_LOG_ENTER();
+
+    auto rc = m_bulkNextHops.emplace(std::piecewise_construct,
+            std::forward_as_tuple(nh),
+            std::forward_as_tuple(nh));
+    if (!rc.second)
+    {
+        return true;
+    }
+
+    if (!addNextHop(rc.first->second))
+    {
+        m_bulkNextHops.erase(rc.first);
+        return false;
+    }
+
+    return true;
+}
+
+void NeighOrch::flushNextHops()
+{
+    SWSS_LOG_ENTER();
+
+    gNextHopBulker.flush();
+
+    /* Next hops may be added synchronously while going through the results */
+    map<NextHopKey, NextHopBulkContext> bulkNextHops;
+    bulkNextHops.swap(m_bulkNextHops);
+
+    for (auto &it : bulkNextHops)
+    {
+        addNextHopPost(it.second);
+    }
+}
+
+bool NeighOrch::addNextHop(NextHopBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NextHopKey &nh = ctx.nh;
+
+    const Port *p = gPortsOrch->findPort(nh.alias);
+    if (!p)
     {
         SWSS_LOG_ERROR("Neighbor %s seen on port %s which doesn't exist",
                         nh.ip_address.to_string().c_str(), nh.alias.c_str());
         return false;
     }
-    if (p.m_type == Port::SUBPORT)
+    if (p->m_type == Port::SUBPORT)
     {
-        if (!gPortsOrch->getPort(p.m_parent_port_id, p))
+        p = gPortsOrch->findPort(p->m_parent_port_id);
+        if (!p)
         {
             SWSS_LOG_ERROR("Neighbor %s seen on sub interface %s whose parent port doesn't exist",
                             nh.ip_address.to_string().c_str(), nh.alias.c_str());
@@ -202,7 +262,7 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
         }
     }
 
-    NextHopKey nexthop(nh);
+    NextHopKey &nexthop = ctx.nexthop;
     if (m_intfsOrch->isRemoteSystemPortIntf(nh.alias))
     {
         //For remote system ports kernel nexthops are always on inband. Change the key
@@ -218,7 +278,6 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
 
     vector<sai_attribute_t> next_hop_attrs;
 
-    vector<Label> label_stack;
     sai_attribute_t next_hop_attr;
     if (nexthop.isMplsNextHop())
     {
@@ -230,9 +289,10 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
         next_hop_attr.value.s32 = nexthop.label_stack.m_outseg_type;
         next_hop_attrs.push_back(next_hop_attr);
 
+        /* The label list is read when the bulker is flushed */
         next_hop_attr.id = SAI_NEXT_HOP_ATTR_LABELSTACK;
-        label_stack = nexthop.label_stack.getLabelStack();
-        next_hop_attr.value.u32list.list = label_stack.data();
+        ctx.label_stack = nexthop.label_stack.getLabelStack();
+        next_hop_attr.value.u32list.list = ctx.label_stack.data();
         next_hop_attr.value.u32list.count = static_cast<uint32_t>(nexthop.label_stack.getSize());
         next_hop_attrs.push_back(next_hop_attr);
     }
@@ -251,8 +311,21 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
     next_hop_attr.value.oid = rif_id;
     next_hop_attrs.push_back(next_hop_attr);
 
-    sai_object_id_t next_hop_id;
-    sai_status_t status = sai_next_hop_api->create_next_hop(&next_hop_id, gSwitchId, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+    ctx.ifdown = (p->m_oper_status == SAI_PORT_OPER_STATUS_DOWN);
+
+    gNextHopBulker.create_entry(&ctx.next_hop_id, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data(), &ctx.object_status);
+
+    return true;
+}
+
+bool NeighOrch::addNextHopPost(const NextHopBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NextHopKey &nh = ctx.nh;
+    const NextHopKey &nexthop = ctx.nexthop;
+
+    sai_status_t status = ctx.object_status;
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
@@ -260,6 +333,8 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
         task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP, status);
         if (handle_status != task_success)
         {
+            /* Wake the routes waiting on the next hop, they queue it again or fail on their own */
+            m_dependencySubject.publish(nh.to_string());
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
@@ -274,7 +349,7 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
     }
 
     NextHopEntry next_hop_entry;
-    next_hop_entry.next_hop_id = next_hop_id;
+    next_hop_entry.next_hop_id = ctx.next_hop_id;
     next_hop_entry.ref_count = 0;
     next_hop_entry.nh_flags = 0;
     m_syncdNextHops[nexthop] = next_hop_entry;
@@ -299,11 +374,13 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
 
     gFgNhgOrch->validNextHopInNextHopGroup(nexthop);
 
+    m_dependencySubject.publish(nh.to_string());
+
     // For nexthop with incoming port which has down oper status, NHFLAGS_IFDOWN
     // flag should be set on it.
     // This scenario may happen under race condition where buffered neighbor event
     // is processed after incoming port is down.
-    if (p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
+    if (ctx.ifdown)
     {
         if (setNextHopFlag(nexthop, NHFLAGS_IFDOWN) == false)
         {
@@ -627,6 +704,20 @@ bool NeighOrch::getNeighborEntry(const IpAddress &ipAddress, NeighborEntry &neig
     return getNeighborEntry(nexthop, neighborEntry, macAddress);
 }
 
+/* Remove remaining DEL operation in m_toSync for the same neighbor.
+ * Since DEL operation is supposed to be executed before SET for the same neighbor
+ * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
+ */
+static void removePendingDel(Consumer &consumer, SyncMap::iterator it, const string &key)
+{
+    auto rit = make_reverse_iterator(it);
+    while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+    {
+        consumer.m_toSync.erase(next(rit).base());
+        SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+    }
+}
+
 void NeighOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -646,123 +737,196 @@ void NeighOrch::doTask(Consumer &consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
-
-        string key = kfvKey(t);
-        string op = kfvOp(t);
-
-        size_t found = key.find(':');
-        if (found == string::npos)
+        // Neighbor bulk results will be stored in a map
+        std::map<
+                std::pair<
+                        std::string,            // Key
+                        std::string             // Op
+                >,
+                NeighborBulkContext
+        >                                       toBulk;
+
+        // Add, update or remove neighbors with a neighbor bulker
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_ERROR("Failed to parse key %s", key.c_str());
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            KeyOpFieldsValuesTuple t = it->second;
 
-        string alias = key.substr(0, found);
+            string key = kfvKey(t);
+            string op = kfvOp(t);
 
-        if (alias == "eth0" || alias == "lo" || alias == "docker0"
-            || ((op == SET_COMMAND) && m_intfsOrch->isInbandIntfInMgmtVrf(alias)))
-        {
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            /* Flush the queued operation of a neighbor before processing its next one */
+            if (toBulk.find(make_pair(key, SET_COMMAND)) != toBulk.end() ||
+                toBulk.find(make_pair(key, DEL_COMMAND)) != toBulk.end())
+            {
+                break;
+            }
 
-        if(gPortsOrch->isInbandPort(alias))
-        {
-            Port ibport;
-            gPortsOrch->getInbandPort(ibport);
-            if(ibport.m_type != Port::VLAN)
+            size_t found = key.find(':');
+            if (found == string::npos)
             {
-                //For "port" type Inband, the neighbors are only remote neighbors.
-                //Hence, this is the neigh learned due to the kernel entry added on
-                //Inband interface for the remote system port neighbors. Skip
+                SWSS_LOG_ERROR("Failed to parse key %s", key.c_str());
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
-            //For "vlan" type inband, may identify the remote neighbors and skip
-        }
-
-        IpAddress ip_address(key.substr(found+1));
 
-        NeighborEntry neighbor_entry = { ip_address, alias };
+            string alias = key.substr(0, found);
 
-        if (op == SET_COMMAND)
-        {
-            Port p;
-            if (!gPortsOrch->getPort(alias, p))
+            if (alias == "eth0" || alias == "lo" || alias == "docker0"
+                || ((op == SET_COMMAND) && m_intfsOrch->isInbandIntfInMgmtVrf(alias)))
             {
-                SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
-                it++;
+                it = consumer.m_toSync.erase(it);
                 continue;
             }
 
-            if (!p.m_rif_id)
+            if(gPortsOrch->isInbandPort(alias))
             {
-                SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
-                it++;
-                continue;
+                Port ibport;
+                gPortsOrch->getInbandPort(ibport);
+                if(ibport.m_type != Port::VLAN)
+                {
+                    //For "port" type Inband, the neighbors are only remote neighbors.
+                    //Hence, this is the neigh learned due to the kernel entry added on
+                    //Inband interface for the remote system port neighbors. Skip
+                    it = consumer.m_toSync.erase(it);
+                    continue;
+                }
+                //For "vlan" type inband, may identify the remote neighbors and skip
             }
 
-            MacAddress mac_address;
-            for (auto i = kfvFieldsValues(t).begin();
-                 i  != kfvFieldsValues(t).end(); i++)
-            {
-                if (fvField(*i) == "neigh")
-                    mac_address = MacAddress(fvValue(*i));
-            }
+            IpAddress ip_address(key.substr(found+1));
+
+            NeighborEntry neighbor_entry = { ip_address, alias };
 
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
-                    || m_syncdNeighbors[neighbor_entry].mac != mac_address)
+            if (op == SET_COMMAND)
             {
-                if (addNeighbor(neighbor_entry, mac_address))
+                const Port *p = gPortsOrch->findPort(alias);
+                if (!p)
                 {
-                    it = consumer.m_toSync.erase(it);
+                    SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
+                    it++;
+                    continue;
                 }
-                else
+
+                if (!p->m_rif_id)
                 {
+                    SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
                     it++;
                     continue;
                 }
+
+                MacAddress mac_address;
+                for (auto i = kfvFieldsValues(t).begin();
+                     i  != kfvFieldsValues(t).end(); i++)
+                {
+                    if (fvField(*i) == "neigh")
+                        mac_address = MacAddress(fvValue(*i));
+                }
+
+                if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
+                        || m_syncdNeighbors[neighbor_entry].mac != mac_address)
+                {
+                    auto& ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key, op),
+                            std::forward_as_tuple(neighbor_entry, mac_address)).first->second;
+
+                    if (addNeighbor(ctx))
+                    {
+                        it = consumer.m_toSync.erase(it);
+                    }
+                    else
+                    {
+                        it++;
+                        continue;
+                    }
+                }
+                else
+                {
+                    /* Duplicate entry */
+                    it = consumer.m_toSync.erase(it);
+                }
+
+                removePendingDel(consumer, it, key);
+            }
+            else if (op == DEL_COMMAND)
+            {
+                if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
+                {
+                    auto& ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key, op),
+                            std::forward_as_tuple(neighbor_entry, MacAddress())).first->second;
+
+                    if (removeNeighbor(ctx))
+                    {
+                        it = consumer.m_toSync.erase(it);
+                    }
+                    else
+                    {
+                        it++;
+                    }
+                }
+                else
+                    /* Cannot locate the neighbor */
+                    it = consumer.m_toSync.erase(it);
             }
             else
             {
-                /* Duplicate entry */
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
                 it = consumer.m_toSync.erase(it);
             }
+        }
 
-            /* Remove remaining DEL operation in m_toSync for the same neighbor.
-             * Since DEL operation is supposed to be executed before SET for the same neighbor
-             * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
-             */
-            auto rit = make_reverse_iterator(it);
-            while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+        gNeighBulker.flush();
+
+        // Create the next hops of the created neighbors in one bulk
+        for (auto& it_bulk : toBulk)
+        {
+            auto& ctx = it_bulk.second;
+            if (ctx.create && !ctx.object_statuses.empty() && ctx.object_statuses.front() == SAI_STATUS_SUCCESS)
             {
-                consumer.m_toSync.erase(next(rit).base());
-                SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+                ctx.nexthop_queued = addNextHop(ctx.nexthop);
             }
         }
-        else if (op == DEL_COMMAND)
+        flushNextHops();
+        for (auto& it_bulk : toBulk)
         {
-            if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
+            auto& ctx = it_bulk.second;
+            if (ctx.nexthop_queued)
             {
-                if (removeNeighbor(neighbor_entry))
+                ctx.nexthop_added = addNextHopPost(ctx.nexthop);
+            }
+        }
+
+        // Go through the bulker results
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
+        {
+            string key = kfvKey(it_prev->second);
+            string op = kfvOp(it_prev->second);
+            auto found = toBulk.find(make_pair(key, op));
+            if (found == toBulk.end() || found->second.object_statuses.empty())
+            {
+                it_prev++;
+                continue;
+            }
+
+            const auto& ctx = found->second;
+            if (op == SET_COMMAND)
+            {
+                if (addNeighborPost(ctx))
                 {
-                    it = consumer.m_toSync.erase(it);
+                    it_prev = consumer.m_toSync.erase(it_prev);
+                    removePendingDel(consumer, it_prev, key);
                 }
                 else
-                {
-                    it++;
-                }
+                    it_prev++;
             }
             else
-                /* Cannot locate the neighbor */
-                it = consumer.m_toSync.erase(it);
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            {
+                if (removeNeighborPost(ctx))
+                    it_prev = consumer.m_toSync.erase(it_prev);
+                else
+                    it_prev++;
+            }
         }
     }
 }
@@ -771,7 +935,26 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
 {
     SWSS_LOG_ENTER();
 
-    sai_status_t status;
+    NeighborBulkContext ctx(neighborEntry, macAddress);
+    if (addNeighbor(ctx))
+    {
+        return true;
+    }
+    if (ctx.object_statuses.empty())
+    {
+        return false;
+    }
+
+    gNeighBulker.flush();
+    return addNeighborPost(ctx);
+}
+
+bool NeighOrch::addNeighbor(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
+    const MacAddress &macAddress = ctx.mac;
     IpAddress ip_address = neighborEntry.ip_address;
     string alias = neighborEntry.alias;
 
@@ -782,7 +965,7 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         return false;
     }
 
-    sai_neighbor_entry_t neighbor_entry;
+    sai_neighbor_entry_t &neighbor_entry = ctx.neighbor_entry;
     neighbor_entry.rif_id = rif_id;
     neighbor_entry.switch_id = gSwitchId;
     copy(neighbor_entry.ip_address, ip_address);
@@ -807,7 +990,7 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
     }
 
     MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
-    bool hw_config = isHwConfigured(neighborEntry);
+    ctx.hw_config = isHwConfigured(neighborEntry);
 
     if (gMySwitchType == "voq")
     {
@@ -817,10 +1000,40 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         }
     }
 
-    if (!hw_config && mux_orch->isNeighborActive(ip_address, macAddress, alias))
+    if (!ctx.hw_config && mux_orch->isNeighborActive(ip_address, macAddress, alias))
+    {
+        ctx.create = true;
+        ctx.object_statuses.emplace_back();
+        gNeighBulker.create_entry(&ctx.object_statuses.back(), &neighbor_entry,
+                                  (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
+        return false;
+    }
+    else if (ctx.hw_config)
+    {
+        ctx.object_statuses.emplace_back();
+        gNeighBulker.set_entry_attribute(&ctx.object_statuses.back(), &neighbor_entry, &neighbor_attr);
+        return false;
+    }
+
+    return addNeighborPost(ctx);
+}
+
+bool NeighOrch::addNeighborPost(const NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
+    const MacAddress &macAddress = ctx.mac;
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+    sai_neighbor_entry_t neighbor_entry = ctx.neighbor_entry;
+    bool hw_config = ctx.hw_config;
+
+    sai_status_t status;
+
+    if (ctx.create)
     {
-        status = sai_neighbor_api->create_neighbor_entry(&neighbor_entry,
-                                   (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
+        status = ctx.object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
             if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
@@ -854,7 +1067,8 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
             gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
         }
 
-        if (!addNextHop(NextHopKey(ip_address, alias)))
+        bool nexthop_added = ctx.nexthop_queued ? ctx.nexthop_added : addNextHop(NextHopKey(ip_address, alias));
+        if (!nexthop_added)
         {
             status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
             if (status != SAI_STATUS_SUCCESS)
@@ -882,9 +1096,9 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         }
         hw_config = true;
     }
-    else if (isHwConfigured(neighborEntry))
+    else if (!ctx.object_statuses.empty())
     {
-        status = sai_neighbor_api->set_neighbor_entry_attribute(&neighbor_entry, &neighbor_attr);
+        status = ctx.object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to update neighbor %s on %s, rv:%d",
@@ -916,6 +1130,25 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
 {
     SWSS_LOG_ENTER();
 
+    NeighborBulkContext ctx(neighborEntry, MacAddress(), disable);
+    if (removeNeighbor(ctx))
+    {
+        return true;
+    }
+    if (ctx.object_statuses.empty())
+    {
+        return false;
+    }
+
+    gNeighBulker.flush();
+    return removeNeighborPost(ctx);
+}
+
+bool NeighOrch::removeNeighbor(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
     sai_status_t status;
     IpAddress ip_address = neighborEntry.ip_address;
     string alias = neighborEntry.alias;
@@ -947,7 +1180,7 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
     {
         sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(alias);
 
-        sai_neighbor_entry_t neighbor_entry;
+        sai_neighbor_entry_t &neighbor_entry = ctx.neighbor_entry;
         neighbor_entry.rif_id = rif_id;
         neighbor_entry.switch_id = gSwitchId;
         copy(neighbor_entry.ip_address, ip_address);
@@ -989,7 +1222,27 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
         SWSS_LOG_NOTICE("Removed next hop %s on %s",
                         ip_address.to_string().c_str(), alias.c_str());
 
-        status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
+        /* The next hop is gone, the neighbor entry is removed on the next flush */
+        ctx.hw_config = true;
+        ctx.object_statuses.emplace_back();
+        gNeighBulker.remove_entry(&ctx.object_statuses.back(), &neighbor_entry);
+        return false;
+    }
+
+    return removeNeighborPost(ctx);
+}
+
+bool NeighOrch::removeNeighborPost(const NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+
+    if (ctx.hw_config)
+    {
+        sai_status_t status = ctx.object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
             if (status == SAI_STATUS_ITEM_NOT_FOUND)
@@ -1010,7 +1263,7 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
             }
         }
 
-        if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        if (ctx.neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
         {
             gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
         }
@@ -1027,7 +1280,7 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
             m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str());
 
     /* Do not delete entry from cache if its disable request */
-    if (disable)
+    if (ctx.disable)
     {
         m_syncdNeighbors[neighborEntry].hw_configured = false;
         return true;
@@ -1218,15 +1471,15 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
-            Port p;
-            if (!gPortsOrch->getPort(alias, p))
+            const Port *p = gPortsOrch->findPort(alias);
+            if (!p)
             {
                 SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
                 it++;
                 continue;
             }
 
-            if (!p.m_rif_id)
+            if (!p->m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
                 it++;
@@ -1324,13 +1577,13 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
 
                             gMacAddress.getMac(egress_asic_mac);
 
-                            if (p.m_type == Port::LAG)
+                            if (p->m_type == Port::LAG)
                             {
-                                sw_id = (int8_t) p.m_system_lag_info.switch_id;
+                                sw_id = (int8_t) p->m_system_lag_info.switch_id;
                             }
-                            else if (p.m_type == Port::PHY || p.m_type == Port::SYSTEM)
+                            else if (p->m_type == Port::PHY || p->m_type == Port::SYSTEM)
                             {
-                                sw_id = (int8_t) p.m_system_port_info.switch_id;
+                                sw_id = (int8_t) p->m_system_port_info.switch_id;
                             }
 
                             if(sw_id != -1)
@@ -1587,24 +1840,24 @@ void NeighOrch::voqSyncAddNeigh(string &alias, IpAddress &ip_address, const MacA
 
     //Sync only local neigh. Confirm for the local neigh and
     //get the system port alias for key for syncing to CHASSIS_APP_DB
-    Port port;
-    if(gPortsOrch->getPort(alias, port))
+    const Port *port = gPortsOrch->findPort(alias);
+    if (port)
     {
-        if (port.m_type == Port::LAG)
+        if (port->m_type == Port::LAG)
         {
-            if (port.m_system_lag_info.switch_id != gVoqMySwitchId)
+            if (port->m_system_lag_info.switch_id != gVoqMySwitchId)
             {
                 return;
             }
-            alias = port.m_system_lag_info.alias;
+            alias = port->m_system_lag_info.alias;
         }
         else
         {
-            if(port.m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
+            if(port->m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
             {
                 return;
             }
-            alias = port.m_system_port_info.alias;
+            alias = port->m_system_port_info.alias;
         }
     }
     else
@@ -1629,24 +1882,24 @@ void NeighOrch::voqSyncDelNeigh(string &alias, IpAddress &ip_address)
 {
     //Sync only local neigh. Confirm for the local neigh and
     //get the system port alias for key for syncing to CHASSIS_APP_DB
-    Port port;
-    if(gPortsOrch->getPort(alias, port))
+    const Port *port = gPortsOrch->findPort(alias);
+    if (port)
     {
-        if (port.m_type == Port::LAG)
+        if (port->m_type == Port::LAG)
         {
-            if (port.m_system_lag_info.switch_id != gVoqMySwitchId)
+            if (port->m_system_lag_info.switch_id != gVoqMySwitchId)
             {
                 return;
             }
-            alias = port.m_system_lag_info.alias;
+            alias = port->m_system_lag_info.alias;
         }
         else
         {
-            if(port.m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
+            if(port->m_system_port_info.type == SAI_SYSTEM_PORT_TYPE_REMOTE)
             {
                 return;
             }
-            alias = port.m_system_port_info.alias;
+            alias = port->m_system_port_info.alias;
         }
     }
     else
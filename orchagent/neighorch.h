@@ -6,6 +6,8 @@
 #include "portsorch.h"
 #include "intfsorch.h"
 #include "fdborch.h"
+#include "taskdependency.h"
+#include "bulker.h"
 
 #include "ipaddress.h"
 #include "nexthopkey.h"
@@ -35,6 +37,49 @@ typedef map<NeighborEntry, NeighborData> NeighborTable;
 /* NextHopTable: NextHopKey, NextHopEntry */
 typedef map<NextHopKey, NextHopEntry> NextHopTable;
 
+struct NextHopBulkContext
+{
+    sai_status_t                        object_status;      // Bulk status
+    sai_object_id_t                     next_hop_id;        // Set by the bulker on flush
+    NextHopKey                          nh;                 // Requested next hop
+    NextHopKey                          nexthop;            // Next hop key once on the inband port if remote
+    std::vector<Label>                  label_stack;        // Label list of the queued attributes
+    bool                                ifdown;             // Outgoing port is down
+
+    NextHopBulkContext(const NextHopKey& nh)
+        : object_status(SAI_STATUS_NOT_EXECUTED), next_hop_id(SAI_NULL_OBJECT_ID), nh(nh), nexthop(nh), ifdown(false)
+    {
+    }
+
+    // Disable any copy constructors
+    NextHopBulkContext(const NextHopBulkContext&) = delete;
+    NextHopBulkContext(NextHopBulkContext&&) = delete;
+};
+
+struct NeighborBulkContext
+{
+    std::deque<sai_status_t>            object_statuses;    // Bulk statuses
+    NeighborEntry                       neighborEntry;
+    MacAddress                          mac;
+    sai_neighbor_entry_t                neighbor_entry;     // SAI entry queued in the bulker
+    bool                                create;             // Creation queued, else update or removal
+    bool                                hw_config;          // Neighbor programmed in HW once done
+    bool                                disable;            // Keep the neighbor in cache on removal
+    NextHopBulkContext                  nexthop;            // Next hop of the created neighbor
+    bool                                nexthop_queued;     // Next hop queued in the next hop bulker
+    bool                                nexthop_added;      // Next hop created once flushed
+
+    NeighborBulkContext(const NeighborEntry& entry, const MacAddress& mac, bool disable = false)
+        : neighborEntry(entry), mac(mac), create(false), hw_config(false), disable(disable),
+          nexthop(NextHopKey(entry.ip_address, entry.alias)), nexthop_queued(false), nexthop_added(false)
+    {
+    }
+
+    // Disable any copy constructors
+    NeighborBulkContext(const NeighborBulkContext&) = delete;
+    NeighborBulkContext(NeighborBulkContext&&) = delete;
+};
+
 struct NeighborUpdate
 {
     NeighborEntry entry;
@@ -51,6 +96,9 @@ public:
     bool hasNextHop(const NextHopKey&);
     bool isNeighborResolved(const NextHopKey&);
     bool addNextHop(const NextHopKey&);
+    /* Queue the creation of a next hop, completed by flushNextHops() */
+    bool queueNextHop(const NextHopKey&);
+    void flushNextHops();
     bool removeMplsNextHop(const NextHopKey&);
 
     sai_object_id_t getNextHopId(const NextHopKey&);
@@ -81,7 +129,14 @@ public:
     void resolveNeighbor(const NeighborEntry &);
     void updateSrv6Nexthop(const NextHopKey &, const sai_object_id_t &);
 
+    /* Publishes the key of each next hop being created */
+    DependencySubject& getDependencySubject()
+    {
+        return m_dependencySubject;
+    }
+
 private:
+    DependencySubject m_dependencySubject;
     PortsOrch *m_portsOrch;
     IntfsOrch *m_intfsOrch;
     FdbOrch *m_fdbOrch;
@@ -92,10 +147,21 @@ private:
 
     std::set<NextHopKey> m_neighborToResolve;
 
+    EntityBulker<sai_neighbor_api_t> gNeighBulker;
+    ObjectBulker<sai_next_hop_api_t> gNextHopBulker;
+    /* Next hops queued by queueNextHop() */
+    map<NextHopKey, NextHopBulkContext> m_bulkNextHops;
+
     bool removeNextHop(const IpAddress&, const string&);
 
     bool addNeighbor(const NeighborEntry&, const MacAddress&);
     bool removeNeighbor(const NeighborEntry&, bool disable = false);
+    bool addNeighbor(NeighborBulkContext& ctx);
+    bool removeNeighbor(NeighborBulkContext& ctx);
+    bool addNeighborPost(const NeighborBulkContext& ctx);
+    bool removeNeighborPost(const NeighborBulkContext& ctx);
+    bool addNextHop(NextHopBulkContext& ctx);
+    bool addNextHopPost(const NextHopBulkContext& ctx);
 
     bool setNextHopFlag(const NextHopKey &, const uint32_t);
     bool clearNextHopFlag(const NextHopKey &, const uint32_t);
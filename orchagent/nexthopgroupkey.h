@@ -1,56 +1,88 @@
 #ifndef SWSS_NEXTHOPGROUPKEY_H
 #define SWSS_NEXTHOPGROUPKEY_H
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include "nexthopkey.h"
 
+/*
+ * NextHopGroupKey is a handle on shared, immutable group contents. Whenever a
+ * key is copied its contents are interned, so every route, next hop group and
+ * cache entry referring to the same group holds one refcounted instance
+ * instead of its own set of next hops. The hash is maintained incrementally
+ * as next hops are added or removed, and equal interned keys compare by
+ * pointer.
+ */
 class NextHopGroupKey
 {
 public:
-    NextHopGroupKey() = default;
+    NextHopGroupKey() : m_data(emptyData()) {}
+
+    NextHopGroupKey(const NextHopGroupKey &o) : m_data(o.internedData()) {}
+
+    NextHopGroupKey(NextHopGroupKey &&o) : m_data(std::move(o.m_data))
+    {
+        o.m_data = emptyData();
+    }
+
+    NextHopGroupKey &operator=(const NextHopGroupKey &o)
+    {
+        if (this != &o)
+        {
+            m_data = o.internedData();
+        }
+        return *this;
+    }
+
+    NextHopGroupKey &operator=(NextHopGroupKey &&o)
+    {
+        if (this != &o)
+        {
+            m_data = std::move(o.m_data);
+            o.m_data = emptyData();
+        }
+        return *this;
+    }
 
     /* ip_string@if_alias separated by ',' */
-    NextHopGroupKey(const std::string &nexthops)
+    NextHopGroupKey(const std::string &nexthops) : m_data(std::make_shared<Data>())
     {
-        m_overlay_nexthops = false;
-        m_srv6_nexthops = false;
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
         for (const auto &nh : nhv)
         {
-            m_nexthops.insert(nh);
+            insertNextHop(*m_data, nh);
         }
     }
 
     /* ip_string|if_alias|vni|router_mac separated by ',' */
-    NextHopGroupKey(const std::string &nexthops, bool overlay_nh, bool srv6_nh = false)
+    NextHopGroupKey(const std::string &nexthops, bool overlay_nh, bool srv6_nh = false) :
+        m_data(std::make_shared<Data>())
     {
         if (overlay_nh)
         {
-            m_overlay_nexthops = true;
-            m_srv6_nexthops = false;
+            m_data->overlay_nexthops = true;
             auto nhv = tokenize(nexthops, NHG_DELIMITER);
             for (const auto &nh_str : nhv)
             {
-                auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                insertNextHop(*m_data, NextHopKey(nh_str, overlay_nh, srv6_nh));
             }
         }
         else if (srv6_nh)
         {
-            m_overlay_nexthops = false;
-            m_srv6_nexthops = true;
+            m_data->srv6_nexthops = true;
             auto nhv = tokenize(nexthops, NHG_DELIMITER);
             for (const auto &nh_str : nhv)
             {
-                auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                insertNextHop(*m_data, NextHopKey(nh_str, overlay_nh, srv6_nh));
             }
         }
     }
 
-    NextHopGroupKey(const std::string &nexthops, const std::string &weights)
+    NextHopGroupKey(const std::string &nexthops, const std::string &weights) :
+        m_data(std::make_shared<Data>())
     {
-        m_overlay_nexthops = false;
-        m_srv6_nexthops = false;
         std::vector<std::string> nhv = tokenize(nexthops, NHG_DELIMITER);
         std::vector<std::string> wtv = tokenize(weights, NHG_DELIMITER);
         bool set_weight = wtv.size() == nhv.size();
@@ -58,30 +90,43 @@ public:
         {
             NextHopKey nh(nhv[i]);
             nh.weight = set_weight? (uint32_t)std::stoi(wtv[i]) : 0;
-            m_nexthops.insert(nh);
+            insertNextHop(*m_data, nh);
         }
     }
 
     inline const std::set<NextHopKey> &getNextHops() const
     {
-        return m_nexthops;
+        return m_data->nexthops;
     }
 
     inline size_t getSize() const
     {
-        return m_nexthops.size();
+        return m_data->nexthops.size();
+    }
+
+    /* Order independent hash of the next hops and their weights */
+    inline size_t getHash() const
+    {
+        return m_data->hash;
     }
 
     inline bool operator<(const NextHopGroupKey &o) const
     {
-        if (m_nexthops < o.m_nexthops)
+        if (m_data == o.m_data)
+        {
+            return false;
+        }
+
+        const auto &nexthops = m_data->nexthops;
+        const auto &o_nexthops = o.m_data->nexthops;
+        if (nexthops < o_nexthops)
         {
             return true;
         }
-        else if (m_nexthops == o.m_nexthops)
+        else if (nexthops == o_nexthops)
         {
-            auto it1 = m_nexthops.begin();
-            for (auto& it2 : o.m_nexthops)
+            auto it1 = nexthops.begin();
+            for (auto& it2 : o_nexthops)
             {
                 if (it1->weight < it2.weight)
                 {
@@ -99,20 +144,15 @@ public:
 
     inline bool operator==(const NextHopGroupKey &o) const
     {
-        if (m_nexthops != o.m_nexthops)
+        if (m_data == o.m_data)
         {
-            return false;
+            return true;
         }
-        auto it1 = m_nexthops.begin();
-        for (auto& it2 : o.m_nexthops)
+        if (m_data->hash != o.m_data->hash)
         {
-            if (it2.weight != it1->weight)
-            {
-                return false;
-            }
-            it1++;
+            return false;
         }
-        return true;
+        return sameNextHops(*m_data, *o.m_data);
     }
 
     inline bool operator!=(const NextHopGroupKey &o) const
@@ -122,33 +162,36 @@ public:
 
     void add(const std::string &ip, const std::string &alias)
     {
-        m_nexthops.emplace(ip, alias);
+        add(NextHopKey(ip, alias));
     }
 
     void add(const std::string &nh)
     {
-        m_nexthops.insert(nh);
+        add(NextHopKey(nh));
     }
 
     void add(const NextHopKey &nh)
     {
-        m_nexthops.insert(nh);
+        if (!contains(nh))
+        {
+            insertNextHop(mutableData(), nh);
+        }
     }
 
     bool contains(const std::string &ip, const std::string &alias) const
     {
         NextHopKey nh(ip, alias);
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(nh);
     }
 
     bool contains(const std::string &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(NextHopKey(nh));
     }
 
     bool contains(const NextHopKey &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return m_data->nexthops.find(nh) != m_data->nexthops.end();
     }
 
     bool contains(const NextHopGroupKey &nhs) const
@@ -165,7 +208,7 @@ public:
 
     bool hasIntfNextHop() const
     {
-        for (const auto &nh : m_nexthops)
+        for (const auto &nh : m_data->nexthops)
         {
             if (nh.isIntfNextHop())
             {
@@ -177,32 +220,42 @@ public:
 
     void remove(const std::string &ip, const std::string &alias)
     {
-        NextHopKey nh(ip, alias);
-        m_nexthops.erase(nh);
+        remove(NextHopKey(ip, alias));
     }
 
     void remove(const std::string &nh)
     {
-        m_nexthops.erase(nh);
+        remove(NextHopKey(nh));
     }
 
     void remove(const NextHopKey &nh)
     {
-        m_nexthops.erase(nh);
+        if (!contains(nh))
+        {
+            return;
+        }
+
+        auto &data = mutableData();
+        auto it = data.nexthops.find(nh);
+        data.hash -= nextHopHash(*it);
+        data.nexthops.erase(it);
     }
 
     const std::string to_string() const
     {
         string nhs_str;
+        const auto &nexthops = m_data->nexthops;
+        bool overlay_nexthops = m_data->overlay_nexthops;
+        bool srv6_nexthops = m_data->srv6_nexthops;
 
-        for (auto it = m_nexthops.begin(); it != m_nexthops.end(); ++it)
+        for (auto it = nexthops.begin(); it != nexthops.end(); ++it)
         {
-            if (it != m_nexthops.begin())
+            if (it != nexthops.begin())
             {
                 nhs_str += NHG_DELIMITER;
             }
-            if (m_overlay_nexthops || m_srv6_nexthops) {
-                nhs_str += it->to_string(m_overlay_nexthops, m_srv6_nexthops);
+            if (overlay_nexthops || srv6_nexthops) {
+                nhs_str += it->to_string(overlay_nexthops, srv6_nexthops);
             } else {
                 nhs_str += it->to_string();
             }
@@ -213,23 +266,189 @@ public:
 
     inline bool is_overlay_nexthop() const
     {
-        return m_overlay_nexthops;
+        return m_data->overlay_nexthops;
     }
 
     inline bool is_srv6_nexthop() const
     {
-        return m_srv6_nexthops;
+        return m_data->srv6_nexthops;
     }
 
     void clear()
     {
-        m_nexthops.clear();
+        if (getSize() == 0)
+        {
+            return;
+        }
+
+        auto &data = mutableData();
+        data.nexthops.clear();
+        data.hash = 0;
+    }
+
+    /* Number of distinct groups currently interned */
+    static size_t getInternedCount()
+    {
+        auto &table = internTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return table.entries.size();
     }
 
 private:
-    std::set<NextHopKey> m_nexthops;
-    bool m_overlay_nexthops;
-    bool m_srv6_nexthops;
+    struct Data
+    {
+        std::set<NextHopKey> nexthops;
+        bool overlay_nexthops = false;
+        bool srv6_nexthops = false;
+        size_t hash = 0;
+        /* Interned data is shared and must never be modified */
+        bool interned = false;
+    };
+
+    struct InternedDataHash
+    {
+        size_t operator()(const Data *data) const noexcept
+        {
+            return data->hash;
+        }
+    };
+
+    struct InternedDataEqual
+    {
+        bool operator()(const Data *a, const Data *b) const
+        {
+            return a->overlay_nexthops == b->overlay_nexthops &&
+                a->srv6_nexthops == b->srv6_nexthops &&
+                a->hash == b->hash && sameNextHops(*a, *b);
+        }
+    };
+
+    struct InternTable
+    {
+        std::mutex mutex;
+        std::unordered_map<const Data *, std::weak_ptr<Data>, InternedDataHash, InternedDataEqual> entries;
+    };
+
+    /*
+     * Un-interned data is only ever owned by a single key: copies intern it
+     * first and moves transfer it. That key may therefore modify it in place.
+     */
+    mutable std::shared_ptr<Data> m_data;
+
+    static InternTable &internTable()
+    {
+        /* Never destroyed so that keys outliving static destruction stay valid */
+        static InternTable *table = new InternTable;
+        return *table;
+    }
+
+    static const std::shared_ptr<Data> &emptyData()
+    {
+        static auto *empty = new std::shared_ptr<Data>(intern(std::make_shared<Data>()));
+        return *empty;
+    }
+
+    static size_t nextHopHash(const NextHopKey &nh)
+    {
+        size_t seed = NextHopKeyHash()(nh);
+        boost::hash_combine(seed, nh.weight);
+        return seed;
+    }
+
+    static void insertNextHop(Data &data, const NextHopKey &nh)
+    {
+        auto res = data.nexthops.insert(nh);
+        if (res.second)
+        {
+            data.hash += nextHopHash(*res.first);
+        }
+    }
+
+    static bool sameNextHops(const Data &a, const Data &b)
+    {
+        if (a.nexthops != b.nexthops)
+        {
+            return false;
+        }
+        auto it1 = a.nexthops.begin();
+        for (auto& it2 : b.nexthops)
+        {
+            if (it2.weight != it1->weight)
+            {
+                return false;
+            }
+            it1++;
+        }
+        return true;
+    }
+
+    static void release(Data *data)
+    {
+        auto &table = internTable();
+        {
+            std::lock_guard<std::mutex> lock(table.mutex);
+            auto it = table.entries.find(data);
+            if (it != table.entries.end() && it->first == data)
+            {
+                table.entries.erase(it);
+            }
+        }
+        delete data;
+    }
+
+    static std::shared_ptr<Data> intern(std::shared_ptr<Data> data)
+    {
+        if (data->interned)
+        {
+            return data;
+        }
+
+        auto &table = internTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        auto it = table.entries.find(data.get());
+        if (it != table.entries.end())
+        {
+            auto shared = it->second.lock();
+            if (shared)
+            {
+                return shared;
+            }
+            /* Last reference is being released concurrently, replace the entry */
+            table.entries.erase(it);
+        }
+
+        std::shared_ptr<Data> shared(new Data(std::move(*data)), release);
+        shared->interned = true;
+        table.entries.emplace(shared.get(), shared);
+        return shared;
+    }
+
+    const std::shared_ptr<Data> &internedData() const
+    {
+        if (!m_data->interned)
+        {
+            m_data = intern(std::move(m_data));
+        }
+        return m_data;
+    }
+
+    Data &mutableData()
+    {
+        if (m_data->interned)
+        {
+            m_data = std::make_shared<Data>(*m_data);
+            m_data->interned = false;
+        }
+        return *m_data;
+    }
+};
+
+struct NextHopGroupKeyHash
+{
+    size_t operator()(const NextHopGroupKey &key) const noexcept
+    {
+        return key.getHash();
+    }
 };
 
 #endif /* SWSS_NEXTHOPGROUPKEY_H */
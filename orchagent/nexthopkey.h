@@ -1,6 +1,8 @@
 #ifndef SWSS_NEXTHOPKEY_H
 #define SWSS_NEXTHOPKEY_H
 
+#include <boost/functional/hash.hpp>
+
 #include "ipaddress.h"
 #include "tokenize.h"
 #include "label.h"
@@ -199,4 +201,30 @@ struct NextHopKey
     }
 };
 
+/* Hashes the fields compared by NextHopKey::operator==, weight excluded */
+struct NextHopKeyHash
+{
+    size_t operator()(const NextHopKey &nh) const noexcept
+    {
+        size_t seed = 0;
+        if (nh.ip_address.isV4())
+        {
+            boost::hash_combine(seed, nh.ip_address.getV4Addr());
+        }
+        else
+        {
+            const unsigned char *addr = nh.ip_address.getV6Addr();
+            boost::hash_range(seed, addr, addr + sizeof(sai_ip6_t));
+        }
+        boost::hash_combine(seed, nh.alias);
+        boost::hash_combine(seed, nh.vni);
+        boost::hash_range(seed, nh.mac_address.getMac(), nh.mac_address.getMac() + sizeof(sai_mac_t));
+        const auto &labels = nh.label_stack.getLabelStack();
+        boost::hash_range(seed, labels.begin(), labels.end());
+        boost::hash_combine(seed, nh.srv6_segment);
+        boost::hash_combine(seed, nh.srv6_source);
+        return seed;
+    }
+};
+
 #endif /* SWSS_NEXTHOPKEY_H */
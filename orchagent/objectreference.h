@@ -0,0 +1,273 @@
+#ifndef SWSS_OBJECTREFERENCE_H
+#define SWSS_OBJECTREFERENCE_H
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Names of the objects tracked in type_map references (e.g. buffer profiles,
+ * queues, QoS maps) are interned into dense integer ids, so that the reference
+ * graph stores integers instead of copies of the names. The ids are reference
+ * counted: an id is released with the last set or reference holding it, and
+ * reused for the next name interned.
+ */
+typedef uint32_t object_name_id;
+
+class ObjectNameInterner
+{
+public:
+    /* Interns the name and takes a reference on its id */
+    static object_name_id acquire(const std::string &name)
+    {
+        auto &state = getState();
+        auto it = state.ids.find(name);
+        if (it != state.ids.end())
+        {
+            state.entries[it->second].refs++;
+            return it->second;
+        }
+
+        object_name_id id;
+        if (state.freeIds.empty())
+        {
+            id = static_cast<object_name_id>(state.entries.size());
+            state.entries.emplace_back();
+        }
+        else
+        {
+            id = state.freeIds.back();
+            state.freeIds.pop_back();
+        }
+
+        /* Keys of unordered_map are not moved on rehash */
+        state.entries[id] = { &state.ids.emplace(name, id).first->first, 1 };
+        return id;
+    }
+
+    static void acquire(object_name_id id)
+    {
+        getState().entries[id].refs++;
+    }
+
+    static void release(object_name_id id)
+    {
+        auto &state = getState();
+        auto &entry = state.entries[id];
+        if (--entry.refs == 0)
+        {
+            state.ids.erase(*entry.name);
+            entry.name = nullptr;
+            state.freeIds.push_back(id);
+        }
+    }
+
+    /* Looks the name up without interning it */
+    static bool find(const std::string &name, object_name_id &id)
+    {
+        auto &ids = getState().ids;
+        auto it = ids.find(name);
+        if (it == ids.end())
+        {
+            return false;
+        }
+        id = it->second;
+        return true;
+    }
+
+    static const std::string &name(object_name_id id)
+    {
+        return *getState().entries[id].name;
+    }
+
+    /* Number of names currently interned */
+    static size_t size()
+    {
+        return getState().ids.size();
+    }
+
+private:
+    struct Entry
+    {
+        const std::string *name;
+        uint32_t refs;
+    };
+
+    struct State
+    {
+        std::unordered_map<std::string, object_name_id> ids;
+        std::vector<Entry> entries;
+        std::vector<object_name_id> freeIds;
+    };
+
+    /* Never destroyed, the type maps of the Orchs may outlive a static */
+    static State &getState()
+    {
+        static State *state = new State;
+        return *state;
+    }
+};
+
+/* Reference on an interned object name */
+class ObjectName
+{
+public:
+    explicit ObjectName(const std::string &name) : m_id(ObjectNameInterner::acquire(name))
+    {
+    }
+
+    ObjectName(const ObjectName &other) : m_id(other.m_id)
+    {
+        ObjectNameInterner::acquire(m_id);
+    }
+
+    ObjectName &operator=(const ObjectName &other)
+    {
+        ObjectNameInterner::acquire(other.m_id);
+        ObjectNameInterner::release(m_id);
+        m_id = other.m_id;
+        return *this;
+    }
+
+    ~ObjectName()
+    {
+        ObjectNameInterner::release(m_id);
+    }
+
+    object_name_id id() const { return m_id; }
+    const std::string &str() const { return ObjectNameInterner::name(m_id); }
+
+private:
+    object_name_id m_id;
+};
+
+/*
+ * Set of interned object names stored as a sorted vector of ids, each holding
+ * a reference on its name. Keeps the std::set<std::string> interface used by
+ * the string API, but iterates in id order rather than in name order.
+ */
+class ObjectNameSet
+{
+public:
+    ObjectNameSet() = default;
+
+    ObjectNameSet(const ObjectNameSet &other) : m_ids(other.m_ids)
+    {
+        for (auto id : m_ids)
+        {
+            ObjectNameInterner::acquire(id);
+        }
+    }
+
+    ObjectNameSet &operator=(const ObjectNameSet &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            m_ids = other.m_ids;
+            for (auto id : m_ids)
+            {
+                ObjectNameInterner::acquire(id);
+            }
+        }
+        return *this;
+    }
+
+    ~ObjectNameSet()
+    {
+        clear();
+    }
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::string value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string* pointer;
+        typedef const std::string& reference;
+
+        explicit const_iterator(std::vector<object_name_id>::const_iterator it) : m_it(it)
+        {
+        }
+
+        reference operator*() const { return ObjectNameInterner::name(*m_it); }
+        pointer operator->() const { return &ObjectNameInterner::name(*m_it); }
+        const_iterator& operator++() { ++m_it; return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++m_it; return t; }
+        bool operator==(const const_iterator &o) const { return m_it == o.m_it; }
+        bool operator!=(const const_iterator &o) const { return m_it != o.m_it; }
+
+        object_name_id id() const { return *m_it; }
+
+    private:
+        std::vector<object_name_id>::const_iterator m_it;
+    };
+
+    bool insert(object_name_id id)
+    {
+        auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if (it != m_ids.end() && *it == id)
+        {
+            return false;
+        }
+        m_ids.insert(it, id);
+        ObjectNameInterner::acquire(id);
+        return true;
+    }
+
+    size_t erase(object_name_id id)
+    {
+        auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if (it == m_ids.end() || *it != id)
+        {
+            return 0;
+        }
+        m_ids.erase(it);
+        ObjectNameInterner::release(id);
+        return 1;
+    }
+
+    size_t count(object_name_id id) const
+    {
+        return std::binary_search(m_ids.begin(), m_ids.end(), id) ? 1 : 0;
+    }
+
+    bool insert(const std::string &name)
+    {
+        return insert(ObjectName(name).id());
+    }
+
+    size_t erase(const std::string &name)
+    {
+        object_name_id id;
+        return ObjectNameInterner::find(name, id) ? erase(id) : 0;
+    }
+
+    size_t count(const std::string &name) const
+    {
+        object_name_id id;
+        return ObjectNameInterner::find(name, id) ? count(id) : 0;
+    }
+
+    bool empty() const { return m_ids.empty(); }
+    size_t size() const { return m_ids.size(); }
+    void clear()
+    {
+        for (auto id : m_ids)
+        {
+            ObjectNameInterner::release(id);
+        }
+        m_ids.clear();
+    }
+
+    const_iterator begin() const { return const_iterator(m_ids.begin()); }
+    const_iterator end() const { return const_iterator(m_ids.end()); }
+
+private:
+    std::vector<object_name_id> m_ids;
+};
+
+#endif /* SWSS_OBJECTREFERENCE_H */
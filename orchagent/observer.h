@@ -24,7 +24,9 @@ enum SubjectType
     SUBJECT_TYPE_MLAG_INTF_CHANGE,
     SUBJECT_TYPE_MLAG_ISL_CHANGE,
     SUBJECT_TYPE_FDB_FLUSH_CHANGE,
-    SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE
+    SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE,
+    SUBJECT_TYPE_DEPENDENCY_CHANGE,
+    SUBJECT_TYPE_FDB_BATCH_CHANGE
 };
 
 class Observer
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <inttypes.h>
@@ -13,6 +14,7 @@
 #include "logger.h"
 #include "consumerstatetable.h"
 #include "sai_serialize.h"
+#include "recorder.h"
 
 using namespace swss;
 
@@ -23,6 +25,12 @@ extern ofstream gRecordOfs;
 extern bool gLogRotate;
 extern string gRecordFile;
 
+static Recorder& swssRecorder()
+{
+    static Recorder recorder(gRecordOfs, gRecordFile);
+    return recorder;
+}
+
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
     addConsumer(db, tableName, pri);
@@ -54,6 +62,12 @@ Orch::Orch(const vector<TableConnector>& tables)
 
 Orch::~Orch()
 {
+}
+
+void Orch::stopRecording()
+{
+    swssRecorder().stop();
+
     if (gRecordOfs.is_open())
     {
         gRecordOfs.close();
@@ -75,8 +89,7 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
     SWSS_LOG_ENTER();
 
 
-    string key = kfvKey(entry);
-    string op  = kfvOp(entry);
+    const string &key = kfvKey(entry);
 
     /* Record incoming tasks */
     if (gSwssRecord)
@@ -84,77 +97,23 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
         Orch::recordTuple(*this, entry);
     }
 
-    /*
-    * m_toSync is a multimap which will allow one key with multiple values,
-    * Also, the order of the key-value pairs whose keys compare equivalent
-    * is the order of insertion and does not change. (since C++11)
-    */
-
-    /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
+    /* A new task supersedes the parked ones of the same key, merge them as usual */
+    if (!m_parkedKeys.empty())
     {
-        m_toSync.emplace(key, entry);
+        unpark(key);
     }
 
-    /* if a DEL task comes, we overwrite the old key */
-    else if (op == DEL_COMMAND)
-    {
-        m_toSync.erase(key);
-        m_toSync.emplace(key, entry);
-    }
-    else
+    /* Let OrchDaemon know this Orch has new tasks to drain */
+    if (m_orch)
     {
-        /*
-        * Now we are trying to add the key-value with SET.
-        * We maintain maximum two values per key.
-        * In case there is one key-value, it should be DEL or SET
-        * In case there are two key-value pairs, it should be DEL then SET
-        * The code logic is following:
-        * We iterate the values with the key, we skip the value with DEL and then
-        * check if that was the only one (I,E, the iter pointer now points to end or next key),
-        * in such case, we insert the key-value with SET.
-        * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
-        */
-        auto ret = m_toSync.equal_range(key);
-        auto iter = ret.first;
-        for (; iter != ret.second; ++iter)
-        {
-            auto old_op = kfvOp(iter->second);
-            if (old_op == SET_COMMAND)
-                break;
-        }
-        if (iter == ret.second)
-        {
-            m_toSync.emplace(key, entry);
-        }
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
-
-
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
-
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
-            }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
-        }
+        m_orch->markDirty();
     }
 
+    /*
+     * A DEL overwrites the pending tasks of the key, a SET is merged in place
+     * into the pending SET of the key, see SyncQueue::add().
+     */
+    m_toSync.add(entry);
 }
 
 size_t Consumer::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries)
@@ -224,21 +183,203 @@ void Consumer::execute()
 {
     SWSS_LOG_ENTER();
 
+    auto start = std::chrono::steady_clock::now();
+
     size_t update_size = 0;
+    m_lastPopCount = 0;
     do
     {
         std::deque<KeyOpFieldsValuesTuple> entries;
         getConsumerTable()->pops(entries);
         update_size = addToSync(entries);
-    } while (update_size != 0);
+
+        m_lastPopCount += update_size;
+    } while (update_size != 0 && (m_popLimit == 0 || m_lastPopCount < m_popLimit));
+
+    /* Yielded with entries possibly left in the table */
+    m_hasMoreData = update_size != 0;
+
+    m_stats.onWakeup(m_lastPopCount);
 
     drain();
+
+    if (m_timeBudget.count() != 0)
+    {
+        adaptPopLimit(std::chrono::steady_clock::now() - start);
+    }
+}
+
+void Consumer::adaptPopLimit(std::chrono::steady_clock::duration elapsed)
+{
+    auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    size_t minLimit = gBatchSize > 0 ? static_cast<size_t>(gBatchSize) : 1;
+
+    if (usecs > m_timeBudget.count())
+    {
+        /* Over budget, pop proportionally less next time */
+        size_t limit = static_cast<size_t>(static_cast<double>(m_lastPopCount) *
+                static_cast<double>(m_timeBudget.count()) / static_cast<double>(usecs));
+        m_popLimit = std::max(minLimit, limit);
+    }
+    else if (m_hasMoreData && m_popLimit != 0)
+    {
+        /* Yielded under budget, grow at most twice */
+        size_t limit = usecs == 0 ? m_popLimit * 2 :
+            static_cast<size_t>(static_cast<double>(m_lastPopCount) *
+                    static_cast<double>(m_timeBudget.count()) / static_cast<double>(usecs));
+        m_popLimit = std::max(minLimit, std::min(limit, m_popLimit * 2));
+    }
 }
 
 void Consumer::drain()
 {
+    if (!m_wokenDependencies.empty())
+        restoreWokenTasks();
+
     if (!m_toSync.empty())
+    {
+        size_t retries = m_toSync.markAttempted();
+        size_t pending = m_toSync.size();
+        auto start = std::chrono::steady_clock::now();
         m_orch->doTask(*this);
+        m_stats.onDoTask(std::chrono::steady_clock::now() - start, m_toSync.size(), retries);
+
+        if (m_toSync.size() < pending)
+        {
+            m_orch->markChanged();
+        }
+    }
+}
+
+SyncMap::iterator Consumer::park(SyncMap::iterator it, const string &dependency)
+{
+    SWSS_LOG_ENTER();
+
+    /* Keep the tasks of one key together so that DEL and SET stay in order */
+    string key = it->first;
+    if (m_parkedKeys.find(key) != m_parkedKeys.end())
+    {
+        unpark(key);
+    }
+
+    m_parkedKeys[key] = dependency;
+
+    SWSS_LOG_INFO("Park task %s of %s on %s", key.c_str(), getName().c_str(), dependency.c_str());
+
+    return m_parkedTasks[dependency].transfer(m_toSync, it, m_toSync.equal_range(key).second);
+}
+
+SyncMap::iterator Consumer::park(SyncMap::iterator it, const vector<string> &dependencies)
+{
+    const string &dependency = dependencies.front();
+
+    auto next = park(it, dependency);
+    for (size_t i = 1; i < dependencies.size(); i++)
+    {
+        if (dependencies[i] != dependency)
+        {
+            m_parkedAliases[dependencies[i]].insert(dependency);
+        }
+    }
+
+    return next;
+}
+
+void Consumer::wake(const string &dependency)
+{
+    bool woken = false;
+
+    /* Tasks are moved back on next drain(), m_toSync may be iterated right now */
+    if (m_parkedTasks.find(dependency) != m_parkedTasks.end())
+    {
+        m_wokenDependencies.insert(dependency);
+        woken = true;
+    }
+
+    auto alias = m_parkedAliases.find(dependency);
+    if (alias != m_parkedAliases.end())
+    {
+        for (const auto &parked : alias->second)
+        {
+            if (m_parkedTasks.find(parked) != m_parkedTasks.end())
+            {
+                m_wokenDependencies.insert(parked);
+                woken = true;
+            }
+        }
+        m_parkedAliases.erase(alias);
+    }
+
+    if (woken && m_orch)
+    {
+        m_orch->markDirty();
+    }
+}
+
+void Consumer::unpark(const string &key)
+{
+    auto it = m_parkedKeys.find(key);
+    if (it == m_parkedKeys.end())
+    {
+        return;
+    }
+
+    auto dep = m_parkedTasks.find(it->second);
+    auto range = dep->second.equal_range(key);
+    m_toSync.transfer(dep->second, range.first, range.second);
+
+    if (dep->second.empty())
+    {
+        m_wokenDependencies.erase(dep->first);
+        m_parkedTasks.erase(dep);
+    }
+    m_parkedKeys.erase(it);
+}
+
+SyncMap::iterator Consumer::restoreWokenTasks()
+{
+    /* A key is either parked or in m_toSync, the woken tasks are appended */
+    auto last = m_toSync.empty() ? m_toSync.end() : std::prev(m_toSync.end());
+
+    for (const auto &dependency : m_wokenDependencies)
+    {
+        auto dep = m_parkedTasks.find(dependency);
+        if (dep == m_parkedTasks.end())
+        {
+            continue;
+        }
+
+        SWSS_LOG_INFO("Wake %zu tasks of %s parked on %s",
+                      dep->second.size(), getName().c_str(), dependency.c_str());
+
+        for (const auto &task : dep->second)
+        {
+            m_parkedKeys.erase(task.first);
+        }
+        m_toSync.transfer(dep->second, dep->second.begin(), dep->second.end());
+        m_parkedTasks.erase(dep);
+    }
+
+    m_wokenDependencies.clear();
+
+    return last == m_toSync.end() ? m_toSync.begin() : std::next(last);
+}
+
+uint64_t Consumer::getOldestPendingMsecs() const
+{
+    if (m_toSync.empty())
+    {
+        return 0;
+    }
+
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - m_toSync.oldestQueued()).count());
+}
+
+void Consumer::getStatsFieldValues(vector<FieldValueTuple> &fvs) const
+{
+    m_stats.toFieldValues(fvs);
+    fvs.emplace_back("OLDEST_PENDING_MS", std::to_string(getOldestPendingMsecs()));
 }
 
 string Consumer::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
@@ -263,6 +404,28 @@ void Consumer::dumpPendingTasks(vector<string> &ts)
 
         ts.push_back(s);
     }
+
+    for (auto &dep : m_parkedTasks)
+    {
+        for (auto &tm : dep.second)
+        {
+            ts.push_back(dumpTuple(tm.second));
+        }
+    }
+}
+
+void Consumer::dumpStats(vector<string> &ts) const
+{
+    vector<FieldValueTuple> fvs;
+    getStatsFieldValues(fvs);
+
+    string s = getStatsKey();
+    for (const auto &fv : fvs)
+    {
+        s += "|" + fvField(fv) + ":" + fvValue(fv);
+    }
+
+    ts.push_back(s);
 }
 
 size_t Orch::addExistingData(const string& tableName)
@@ -323,11 +486,18 @@ bool Orch::bake()
 - indication to the caller of the special case
 */
 bool Orch::parseReference(type_map &type_maps, string &ref_in, const string &type_name, string &object_name)
+{
+    const referenced_object *obj;
+    return parseReference(type_maps, ref_in, type_name, object_name, obj);
+}
+
+bool Orch::parseReference(type_map &type_maps, const string &ref_in, const string &type_name, string &object_name, const referenced_object *&obj)
 {
     SWSS_LOG_ENTER();
 
     SWSS_LOG_DEBUG("input:%s", ref_in.c_str());
 
+    obj = nullptr;
     if (ref_in.size() == 0)
     {
         // value set by user is ""
@@ -350,7 +520,7 @@ bool Orch::parseReference(type_map &type_maps, string &ref_in, const string &typ
         SWSS_LOG_ERROR("not recognized type:%s\n", type_name.c_str());
         return false;
     }
-    auto obj_map = type_maps[type_name];
+    auto obj_map = type_it->second;
     auto obj_it = obj_map->find(ref_in);
     if (obj_it == obj_map->end())
     {
@@ -363,6 +533,7 @@ bool Orch::parseReference(type_map &type_maps, string &ref_in, const string &typ
         return false;
     }
     object_name = ref_in;
+    obj = &obj_it->second;
     SWSS_LOG_DEBUG("parsed: type_name:%s, object_name:%s", type_name.c_str(), object_name.c_str());
     return true;
 }
@@ -389,7 +560,8 @@ ref_resolve_status Orch::resolveFieldRefValue(
                 return ref_resolve_status::multiple_instances;
             }
             string object_name;
-            if (!parseReference(type_maps, fvValue(*i), ref_type_name, object_name))
+            const referenced_object *obj;
+            if (!parseReference(type_maps, fvValue(*i), ref_type_name, object_name, obj))
             {
                 return ref_resolve_status::not_resolved;
             }
@@ -397,7 +569,7 @@ ref_resolve_status Orch::resolveFieldRefValue(
             {
                 return ref_resolve_status::empty;
             }
-            sai_object = (*(type_maps[ref_type_name]))[object_name].m_saiObjectId;
+            sai_object = obj ? obj->m_saiObjectId : (*(type_maps[ref_type_name]))[object_name].m_saiObjectId;
             referenced_object_name = ref_type_name + delimiter + object_name;
             hit = true;
         }
@@ -410,6 +582,62 @@ ref_resolve_status Orch::resolveFieldRefValue(
     return ref_resolve_status::success;
 }
 
+/*
+- Resolve a list of references "TABLE:name,TABLE:name" to the referenced
+- tables and interned object names
+*/
+static void parseObjectReferences(type_map &type_maps, const string &references, vector<object_reference> &refs)
+{
+    size_t start = 0;
+    while (start < references.size())
+    {
+        size_t end = references.find(list_item_delimiter, start);
+        if (end == string::npos)
+        {
+            end = references.size();
+        }
+
+        size_t sep = references.find(delimiter, start);
+        if (sep < end)
+        {
+            size_t name_end = std::min(references.find(delimiter, sep + 1), end);
+            auto table_it = type_maps.find(references.substr(start, sep - start));
+            if (table_it != type_maps.end())
+            {
+                refs.push_back({table_it->second, ObjectName(references.substr(sep + 1, name_end - sep - 1))});
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Unknown table in reference %s", references.substr(start, end - start).c_str());
+            }
+        }
+
+        start = end + 1;
+    }
+}
+
+static void removeDependency(
+    const string &table,
+    const string &obj_name,
+    object_name_id obj_id,
+    const string &field,
+    const vector<object_reference> &refs)
+{
+    for (auto &ref : refs)
+    {
+        auto &ref_obj_name = ref.m_name.str();
+        auto old_referenced_obj = ref.m_table->find(ref_obj_name);
+        if (old_referenced_obj == ref.m_table->end())
+        {
+            continue;
+        }
+        old_referenced_obj->second.m_objsDependingOnMe.erase(obj_id);
+        SWSS_LOG_INFO("Obj %s.%s Field %s: Remove reference to %s (now %zu)",
+                      table.c_str(), obj_name.c_str(), field.c_str(),
+                      ref_obj_name.c_str(), old_referenced_obj->second.m_objsDependingOnMe.size());
+    }
+}
+
 void Orch::removeMeFromObjsReferencedByMe(
     type_map &type_maps,
     const string &table,
@@ -418,26 +646,56 @@ void Orch::removeMeFromObjsReferencedByMe(
     const string &old_referenced_obj_name,
     bool remove_field)
 {
-    vector<string> objects = tokenize(old_referenced_obj_name, list_item_delimiter);
-    for (auto &obj : objects)
+    auto &obj_map = *type_maps[table];
+    auto obj_it = obj_map.find(obj_name);
+
+    /* A name that is not interned is not in any m_objsDependingOnMe */
+    object_name_id obj_id;
+    if (!ObjectNameInterner::find(obj_name, obj_id))
     {
-        // obj_name references token
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &ref_obj_name = tokens[1];
-        auto &old_referenced_obj = (*type_maps[referenced_table])[ref_obj_name];
-        old_referenced_obj.m_objsDependingOnMe.erase(obj_name);
-        SWSS_LOG_INFO("Obj %s.%s Field %s: Remove reference to %s %s (now %s)",
-                      table.c_str(), obj_name.c_str(), field.c_str(),
-                      referenced_table.c_str(), ref_obj_name.c_str(),
-                      to_string(old_referenced_obj.m_objsDependingOnMe.size()).c_str());
+        if (remove_field && obj_it != obj_map.end())
+        {
+            obj_it->second.m_objsReferencingByMe.erase(field);
+            obj_it->second.m_referencedObjects.erase(field);
+        }
+        return;
     }
 
-    if (remove_field)
+    /* Held until done, the id must not be reused by the references parsed below */
+    ObjectNameInterner::acquire(obj_id);
+
+    /* Use the resolved references when they match the references to remove */
+    const vector<object_reference> *refs = nullptr;
+    if (obj_it != obj_map.end())
     {
-        auto &referencing_object = (*type_maps[table])[obj_name];
-        referencing_object.m_objsReferencingByMe.erase(field);
+        auto &obj = obj_it->second;
+        auto field_ref = obj.m_objsReferencingByMe.find(field);
+        auto resolved = obj.m_referencedObjects.find(field);
+        if (field_ref != obj.m_objsReferencingByMe.end() && field_ref->second == old_referenced_obj_name &&
+            resolved != obj.m_referencedObjects.end())
+        {
+            refs = &resolved->second;
+        }
     }
+
+    if (refs)
+    {
+        removeDependency(table, obj_name, obj_id, field, *refs);
+    }
+    else
+    {
+        vector<object_reference> parsed;
+        parseObjectReferences(type_maps, old_referenced_obj_name, parsed);
+        removeDependency(table, obj_name, obj_id, field, parsed);
+    }
+
+    if (remove_field && obj_it != obj_map.end())
+    {
+        obj_it->second.m_objsReferencingByMe.erase(field);
+        obj_it->second.m_referencedObjects.erase(field);
+    }
+
+    ObjectNameInterner::release(obj_id);
 }
 
 void Orch::setObjectReference(
@@ -448,26 +706,39 @@ void Orch::setObjectReference(
     const string &referenced_obj)
 {
     auto &obj = (*type_maps[table])[obj_name];
+    ObjectName obj_ref(obj_name);
+    object_name_id obj_id = obj_ref.id();
     auto field_ref = obj.m_objsReferencingByMe.find(field);
 
     if (field_ref != obj.m_objsReferencingByMe.end())
+    {
+        auto resolved = obj.m_referencedObjects.find(field);
+        if (field_ref->second == referenced_obj && resolved != obj.m_referencedObjects.end())
+        {
+            // Same references, the referenced objects may have been recreated meanwhile
+            for (auto &ref : resolved->second)
+            {
+                (*ref.m_table)[ref.m_name.str()].m_objsDependingOnMe.insert(obj_id);
+            }
+            return;
+        }
         removeMeFromObjsReferencedByMe(type_maps, table, obj_name, field, field_ref->second, false);
+    }
 
     obj.m_objsReferencingByMe[field] = referenced_obj;
 
     // Add the reference to the new object being referenced
-    vector<string> objs = tokenize(referenced_obj, list_item_delimiter);
-    for (auto &obj : objs)
-    {
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &referenced_obj_name = tokens[1];
-        auto &new_obj_being_referenced = (*type_maps[referenced_table])[referenced_obj_name];
-        new_obj_being_referenced.m_objsDependingOnMe.insert(obj_name);
-        SWSS_LOG_INFO("Obj %s.%s Field %s: Add reference to %s %s (now %s)",
+    auto &refs = obj.m_referencedObjects[field];
+    refs.clear();
+    parseObjectReferences(type_maps, referenced_obj, refs);
+    for (auto &ref : refs)
+    {
+        auto &referenced_obj_name = ref.m_name.str();
+        auto &new_obj_being_referenced = (*ref.m_table)[referenced_obj_name];
+        new_obj_being_referenced.m_objsDependingOnMe.insert(obj_id);
+        SWSS_LOG_INFO("Obj %s.%s Field %s: Add reference to %s (now %zu)",
                       table.c_str(), obj_name.c_str(), field.c_str(),
-                      referenced_table.c_str(), referenced_obj_name.c_str(),
-                      to_string(new_obj_being_referenced.m_objsDependingOnMe.size()).c_str());
+                      referenced_obj_name.c_str(), new_obj_being_referenced.m_objsDependingOnMe.size());
     }
 }
 
@@ -506,7 +777,7 @@ void Orch::removeObject(
 
     auto &obj = searchRef->second;
 
-    for (auto field_ref : obj.m_objsReferencingByMe)
+    for (auto &field_ref : obj.m_objsReferencingByMe)
     {
         removeMeFromObjsReferencedByMe(type_maps, table, obj_name, field_ref.first, field_ref.second, false);
     }
@@ -530,13 +801,16 @@ string Orch::objectReferenceInfo(
     const string &obj_name)
 {
     auto &objsDependingSet = (*type_maps[table])[obj_name].m_objsDependingOnMe;
-    for (auto &depObjName : objsDependingSet)
+    if (objsDependingSet.empty())
     {
-        string hint = table + " " + obj_name + " one object: " + depObjName;
-        hint += " reference count: " + to_string(objsDependingSet.size());
-        return hint;
+        return "reference count: 0";
     }
-    return "reference count: 0";
+
+    /* The set iterates in intern order, report the first name as std::set did */
+    auto &depObjName = *std::min_element(objsDependingSet.begin(), objsDependingSet.end());
+    string hint = table + " " + obj_name + " one object: " + depObjName;
+    hint += " reference count: " + to_string(objsDependingSet.size());
+    return hint;
 }
 
 void Orch::doTask()
@@ -547,6 +821,32 @@ void Orch::doTask()
     }
 }
 
+bool Orch::hasPendingTasks() const
+{
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer && !consumer->m_toSync.empty())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Orch::wakeParkedTasks(const string &dependency)
+{
+    for (auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer)
+        {
+            consumer->wake(dependency);
+        }
+    }
+}
+
 void Orch::dumpPendingTasks(vector<string> &ts)
 {
     for (auto &it : m_consumerMap)
@@ -562,30 +862,60 @@ void Orch::dumpPendingTasks(vector<string> &ts)
     }
 }
 
-void Orch::logfileReopen()
+void Orch::dumpConsumerStats(vector<string> &ts)
 {
-    gRecordOfs.close();
+    for (auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer == NULL)
+        {
+            continue;
+        }
 
-    /*
-     * On log rotate we will use the same file name, we are assuming that
-     * logrotate daemon move filename to filename.1 and we will create new
-     * empty file here.
-     */
+        consumer->dumpStats(ts);
+    }
+}
+
+void Orch::setConsumerTimeBudget(std::chrono::microseconds budget, const vector<string> &unlimitedTables)
+{
+    for (auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer == NULL)
+        {
+            continue;
+        }
 
-    gRecordOfs.open(gRecordFile, std::ofstream::out | std::ofstream::app);
+        bool unlimited = std::find(unlimitedTables.begin(), unlimitedTables.end(), it.first) != unlimitedTables.end();
+        consumer->setTimeBudget(unlimited ? std::chrono::microseconds(0) : budget);
+    }
+}
 
-    if (!gRecordOfs.is_open())
+void Orch::publishConsumerStats(Table &table)
+{
+    for (auto &it : m_consumerMap)
     {
-        SWSS_LOG_ERROR("failed to open gRecordOfs file %s: %s", gRecordFile.c_str(), strerror(errno));
-        return;
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer == NULL)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs;
+        consumer->getStatsFieldValues(fvs);
+        table.set(consumer->getStatsKey(), fvs);
     }
 }
 
-void Orch::recordTuple(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple)
+void Orch::logfileReopen()
 {
-    string s = consumer.dumpTuple(tuple);
+    /* The record file is owned by the recorder thread, reopen it there */
+    swssRecorder().reopen();
+}
 
-    gRecordOfs << getTimestamp() << "|" << s << endl;
+void Orch::recordTuple(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple)
+{
+    swssRecorder().record(consumer.dumpTuple(tuple));
 
     if (gLogRotate)
     {
@@ -595,6 +925,11 @@ void Orch::recordTuple(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple)
     }
 }
 
+uint64_t Orch::getDroppedRecordCount()
+{
+    return swssRecorder().getDroppedCount();
+}
+
 string Orch::dumpTuple(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple)
 {
     string s = consumer.dumpTuple(tuple);
@@ -635,12 +970,13 @@ ref_resolve_status Orch::resolveFieldRefArray(
             }
             for (size_t ind = 0; ind < list_items.size(); ind++)
             {
-                if (!parseReference(type_maps, list_items[ind], ref_type_name, object_name))
+                const referenced_object *obj;
+                if (!parseReference(type_maps, list_items[ind], ref_type_name, object_name, obj))
                 {
                     SWSS_LOG_NOTICE("Failed to parse profile reference:%s\n", list_items[ind].c_str());
                     return ref_resolve_status::not_resolved;
                 }
-                sai_object_id_t sai_obj = (*(type_maps[ref_type_name]))[object_name].m_saiObjectId;
+                sai_object_id_t sai_obj = obj ? obj->m_saiObjectId : (*(type_maps[ref_type_name]))[object_name].m_saiObjectId;
                 SWSS_LOG_DEBUG("Resolved to sai_object:0x%" PRIx64 ", type:%s, name:%s", sai_obj, ref_type_name.c_str(), object_name.c_str());
                 sai_object_arr.push_back(sai_obj);
                 if (!object_name_list.empty())
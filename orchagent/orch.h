@@ -7,6 +7,7 @@
 #include <set>
 #include <memory>
 #include <utility>
+#include <chrono>
 
 extern "C" {
 #include "sai.h"
@@ -21,6 +22,9 @@ extern "C" {
 #include "selectabletimer.h"
 #include "macaddress.h"
 #include "response_publisher.h"
+#include "consumerstats.h"
+#include "objectreference.h"
+#include "syncqueue.h"
 
 const char delimiter           = ':';
 const char list_item_delimiter = ',';
@@ -57,28 +61,38 @@ typedef enum
     task_duplicated
 } task_process_status;
 
-typedef struct
+struct referenced_object;
+typedef std::map<std::string, referenced_object> object_reference_map;
+
+// An object referenced by a field, with its name interned
+struct object_reference
+{
+    object_reference_map *m_table;
+    ObjectName m_name;
+};
+
+struct referenced_object
 {
     // m_objsDependingOnMe stores names (without table name) of all objects depending on the current obj
-    std::set<std::string> m_objsDependingOnMe;
+    ObjectNameSet m_objsDependingOnMe;
     // m_objsReferencingByMe is a map from a field of the current object's to the object names it references
     // the object names are with table name
     // multiple objects being referenced are separated by ','
     std::map<std::string, std::string> m_objsReferencingByMe;
+    // m_referencedObjects is m_objsReferencingByMe already resolved to the referenced tables and interned names
+    std::map<std::string, std::vector<object_reference>> m_referencedObjects;
     sai_object_id_t m_saiObjectId;
     bool m_pendingRemove;
-} referenced_object;
+};
 
-typedef std::map<std::string, referenced_object> object_reference_map;
 typedef std::map<std::string, object_reference_map*> type_map;
 
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
-// Use multimap to support multiple OpFieldsValues for the same key (e,g, DEL and SET)
-// The order of the key-value pairs whose keys compare equivalent is the order of
-// insertion and does not change. (since C++11)
-typedef std::multimap<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
+// Support multiple OpFieldsValues for the same key (e,g, DEL and SET), kept together
+// in their order of insertion. Keys are drained in the order they were first queued.
+typedef SyncQueue SyncMap;
 
 typedef std::pair<std::string, int> table_name_with_pri_t;
 
@@ -160,6 +174,20 @@ public:
 
     std::string dumpTuple(const swss::KeyOpFieldsValuesTuple &tuple);
     void dumpPendingTasks(std::vector<std::string> &ts);
+    void dumpStats(std::vector<std::string> &ts) const;
+
+    /* Key of the consumer statistics, e.g. APPL_DB:ROUTE_TABLE */
+    std::string getStatsKey() const
+    {
+        return getDbName() + ":" + getTableName();
+    }
+
+    const ConsumerStats &getStats() const { return m_stats; }
+
+    /* Age of the oldest task in m_toSync, 0 when empty. Parked tasks are not counted */
+    uint64_t getOldestPendingMsecs() const;
+    /* The statistics and the oldest pending age, as published to COUNTERS_DB */
+    void getStatsFieldValues(std::vector<swss::FieldValueTuple> &fvs) const;
 
     size_t refillToSync();
     size_t refillToSync(swss::Table* table);
@@ -174,6 +202,81 @@ public:
 
     // Returns: the number of entries added to m_toSync
     size_t addToSync(const std::deque<swss::KeyOpFieldsValuesTuple> &entries);
+
+    /*
+     * Move the task pointed by 'it', and the tasks following it with the same key,
+     * out of m_toSync until 'dependency' (e.g. a next hop, a port alias or a table
+     * name) is woken. Parked tasks are not retried by drain().
+     * Returns: the iterator following the parked tasks
+     */
+    SyncMap::iterator park(SyncMap::iterator it, const std::string &dependency);
+
+    /*
+     * Same as above for tasks waiting on several dependencies. The tasks are
+     * woken by the first of them woken, and are parked again by the Orch if
+     * they still have to wait on the others.
+     */
+    SyncMap::iterator park(SyncMap::iterator it, const std::vector<std::string> &dependencies);
+
+    /* Schedule the tasks parked on 'dependency' to be moved back to m_toSync on next drain */
+    void wake(const std::string &dependency);
+
+    bool hasWokenTasks() const { return !m_wokenDependencies.empty(); }
+
+    /*
+     * Move the woken tasks back to the end of m_toSync now, e.g. for an Orch
+     * to process them in the doTask which created their dependencies.
+     * Returns: the first task moved back, or m_toSync.end()
+     */
+    SyncMap::iterator restoreWokenTasks();
+
+    size_t getParkedTaskCount() const { return m_parkedKeys.size(); }
+    bool isParked(const std::string &key) const { return m_parkedKeys.find(key) != m_parkedKeys.end(); }
+
+    /* Number of the entries popped by the last execute() */
+    size_t getLastPopCount() const { return m_lastPopCount; }
+
+    /*
+     * Cooperative scheduling: execute() pops as many entries as can be
+     * processed within 'budget' and leaves the rest in the table, so that
+     * a large table does not hold the main loop. Zero disables the budget.
+     *
+     * Only the pops are bounded: doTask() cannot stop half way, so drain()
+     * still processes all of m_toSync, including the retried tasks and the
+     * tasks restored by restoreWokenTasks(). That time counts against the
+     * budget, a long drain() makes the next execute() pop fewer entries.
+     */
+    void setTimeBudget(std::chrono::microseconds budget)
+    {
+        m_timeBudget = budget;
+        m_popLimit = 0;
+    }
+
+    /* The last execute() yielded before the table was empty */
+    bool hasMoreData() const { return m_hasMoreData; }
+
+private:
+    size_t m_lastPopCount = 0;
+
+    std::chrono::microseconds m_timeBudget { 0 };
+    /* Entries to pop per execute(), adapted to the time budget, 0 for no limit */
+    size_t m_popLimit = 0;
+    bool m_hasMoreData = false;
+
+    void adaptPopLimit(std::chrono::steady_clock::duration elapsed);
+
+    ConsumerStats m_stats;
+
+    /* Parked tasks, keyed by the dependency they wait on */
+    std::unordered_map<std::string, SyncMap> m_parkedTasks;
+    /* Dependency of each parked task key */
+    std::unordered_map<std::string, std::string> m_parkedKeys;
+    /* Other dependencies of tasks parked on several, mapped to the ones the tasks are keyed by */
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_parkedAliases;
+    /* Dependencies woken since the last drain */
+    std::unordered_set<std::string> m_wokenDependencies;
+
+    void unpark(const std::string &key);
 };
 
 typedef std::map<std::string, std::shared_ptr<Executor>> ConsumerMap;
@@ -220,8 +323,49 @@ public:
 
     /* TODO: refactor recording */
     static void recordTuple(Consumer &consumer, const swss::KeyOpFieldsValuesTuple &tuple);
+    /* Number of records dropped because the recorder queue was full */
+    static uint64_t getDroppedRecordCount();
+    /* Flush the pending records and close the record file, once at daemon shutdown */
+    static void stopRecording();
 
     void dumpPendingTasks(std::vector<std::string> &ts);
+    void dumpConsumerStats(std::vector<std::string> &ts);
+
+    /*
+     * Set the time budget of each consumer, see Consumer::setTimeBudget().
+     * The consumers of 'unlimitedTables' are always processed in full.
+     */
+    void setConsumerTimeBudget(std::chrono::microseconds budget, const std::vector<std::string> &unlimitedTables = {});
+
+    /* Publish the statistics of each consumer, keyed by Consumer::getStatsKey() */
+    void publishConsumerStats(swss::Table &table);
+
+    /*
+     * Scheduling state used by OrchDaemon to skip Orchs without work.
+     * An Orch is dirty when one of its consumers received new tasks
+     * which have not been drained yet.
+     */
+    void markDirty() { m_dirty = true; }
+    void clearDirty() { m_dirty = false; }
+    bool isDirty() const { return m_dirty; }
+
+    /*
+     * An Orch changed state when its consumers completed tasks. The tasks
+     * the Orchs after it in OrchDaemon retry may then succeed.
+     */
+    void markChanged() { m_changed = true; }
+    bool takeChanged()
+    {
+        bool changed = m_changed;
+        m_changed = false;
+        return changed;
+    }
+
+    /* Return true if any consumer still has tasks in m_toSync (e.g. task_need_retry) */
+    bool hasPendingTasks() const;
+
+    /* Wake the tasks of all consumers parked on 'dependency' */
+    void wakeParkedTasks(const std::string &dependency);
 protected:
     ConsumerMap m_consumerMap;
 
@@ -233,6 +377,7 @@ protected:
     bool isItemIdsMapContinuous(unsigned long idsMap, sai_uint32_t maxId);
     bool parseIndexRange(const std::string &input, sai_uint32_t &range_low, sai_uint32_t &range_high);
     bool parseReference(type_map &type_maps, std::string &ref, const std::string &table_name, std::string &object_name);
+    bool parseReference(type_map &type_maps, const std::string &ref, const std::string &table_name, std::string &object_name, const referenced_object *&obj);
     ref_resolve_status resolveFieldRefArray(type_map&, const std::string&, const std::string&, swss::KeyOpFieldsValuesTuple&, std::vector<sai_object_id_t>&, std::string&);
     void setObjectReference(type_map&, const std::string&, const std::string&, const std::string&, const std::string&);
     bool doesObjectExist(type_map&, const std::string&, const std::string&, const std::string&, std::string&);
@@ -254,6 +399,9 @@ protected:
 
     ResponsePublisher m_publisher;
 private:
+    bool m_dirty = false;
+    bool m_changed = false;
+
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri = default_orch_pri);
 };
 
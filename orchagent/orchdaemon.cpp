@@ -16,6 +16,11 @@ using namespace swss;
 
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
+/* Interval to retry tasks left in m_toSync when no new data arrives for them */
+#define RETRY_INTERVAL_MSECS 100
+/* Interval of the consumer statistics publication to COUNTERS_DB */
+#define CONSUMER_STATS_INTERVAL_MSECS 10000
+#define COUNTERS_ORCH_CONSUMER_STATS_TABLE "ORCH_CONSUMER_STATS"
 #define PFC_WD_POLL_MSECS 100
 
 extern sai_switch_api_t*           sai_switch_api;
@@ -61,6 +66,29 @@ bool gIsNatSupported = false;
 #define DEFAULT_MAX_BULK_SIZE 1000
 size_t gMaxBulkSize = DEFAULT_MAX_BULK_SIZE;
 
+#define DEFAULT_CONSUMER_TIME_BUDGET_MSECS 0
+uint32_t gConsumerTimeBudgetMsecs = DEFAULT_CONSUMER_TIME_BUDGET_MSECS;
+
+/*
+ * Latency sensitive tables are processed in full on each turn, whatever the
+ * consumer time budget. Their updates wait at most one time budget of the
+ * bulk tables, e.g. ROUTE_TABLE, which yield to them.
+ */
+static const vector<string> latencySensitiveTables = {
+    APP_PORT_TABLE_NAME,
+    APP_NEIGH_TABLE_NAME,
+    APP_BFD_SESSION_TABLE_NAME
+};
+
+/* Threads pre-parsing the route entries, 0 parses them on the main thread */
+uint32_t gParseThreads = 0;
+
+/* Update the members of a next hop group used by a single route in place */
+bool gNhgInPlaceUpdate = false;
+
+/* Point the single next hop routes of MUX neighbors at a next hop group shared per neighbor */
+bool gRoutePic = false;
+
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb, DBConnector *chassisAppDb) :
         m_applDb(applDb),
         m_configDb(configDb),
@@ -69,6 +97,10 @@ OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *
 {
     SWSS_LOG_ENTER();
     m_select = new Select();
+    m_flushPolicyOrch = new FlushPolicyOrch(configDb, CFG_SAIREDIS_FLUSH_POLICY_TABLE_NAME);
+
+    m_countersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
+    m_consumerStatsTable = unique_ptr<Table>(new Table(m_countersDb.get(), COUNTERS_ORCH_CONSUMER_STATS_TABLE));
 }
 
 OrchDaemon::~OrchDaemon()
@@ -88,7 +120,11 @@ OrchDaemon::~OrchDaemon()
     for(; it != m_orchList.rend(); ++it) {
         delete(*it);
     }
+    delete m_flushPolicyOrch;
     delete m_select;
+
+    /* The Orchs are gone, nothing records anymore */
+    Orch::stopRecording();
 }
 
 bool OrchDaemon::init()
@@ -646,7 +682,7 @@ bool OrchDaemon::init()
 }
 
 /* Flush redis through sairedis interface */
-void OrchDaemon::flush()
+void OrchDaemon::flush(FlushReason reason)
 {
     SWSS_LOG_ENTER();
 
@@ -659,6 +695,10 @@ void OrchDaemon::flush()
         abort();
     }
 
+    m_flushPolicyOrch->addBulkerOperations();
+    m_flushPolicyOrch->onFlush(reason);
+    m_lastFlush = std::chrono::high_resolution_clock::now();
+
     // check if logroate is requested
     if (gSaiRedisLogRotate)
     {
@@ -673,61 +713,208 @@ void OrchDaemon::flush()
     }
 }
 
+/*
+ * Drain the Orchs which have work to do.
+ *
+ * Orchs which received new tasks (dirty) are always drained. Orchs which only
+ * hold tasks left over from previous passes (e.g. task_need_retry) are drained
+ * when retry is requested, or when an Orch before them in m_orchList changed
+ * state by completing tasks, as their tasks may wait on it. A burst of events
+ * which completes nothing does not re-scan the pending tasks of every Orch,
+ * and the Orchs without pending tasks are skipped.
+ *
+ * An Orch after its dependents in m_orchList only gets them retried on the
+ * next pass, or after RETRY_INTERVAL_MSECS at the latest.
+ */
+void OrchDaemon::doPendingTasks(bool retry)
+{
+    bool pending = false;
+    bool changed = false;
+    size_t visited = 0;
+
+    for (Orch *o : m_orchList)
+    {
+        if (o->isDirty() || ((retry || changed) && o->hasPendingTasks()))
+        {
+            o->clearDirty();
+            o->doTask();
+            visited++;
+
+            if (o->isDirty() || o->hasPendingTasks())
+            {
+                pending = true;
+            }
+        }
+
+        /* Also taken when the Orch completed tasks in execute() */
+        changed = o->takeChanged() || changed;
+    }
+
+    if (retry)
+    {
+        m_retryPending = pending;
+        m_lastRetry = std::chrono::high_resolution_clock::now();
+    }
+    else
+    {
+        m_retryPending = m_retryPending || pending;
+    }
+
+    m_flushPolicyOrch->addBulkerOperations();
+
+    m_lastVisitedOrchs = visited;
+    m_lastSkippedOrchs = m_orchList.size() - visited;
+    m_totalVisitedOrchs += m_lastVisitedOrchs;
+    m_totalSkippedOrchs += m_lastSkippedOrchs;
+
+    SWSS_LOG_DEBUG("%s pass visited %zu orchs, skipped %zu orchs",
+                   retry ? "Retry" : "Dirty", m_lastVisitedOrchs, m_lastSkippedOrchs);
+}
+
+/*
+ * Execute a selectable and account what it wrote to the pipeline to the flush
+ * policy, a timer or a notification that writes nothing accounts nothing.
+ * A consumer which yielded before emptying its table is queued to be resumed.
+ */
+void OrchDaemon::execute(Executor *executor)
+{
+    executor->execute();
+    m_flushPolicyOrch->addBulkerOperations();
+
+    auto *consumer = dynamic_cast<Consumer *>(executor);
+    if (consumer && consumer->hasMoreData() &&
+        find(m_yieldedConsumers.begin(), m_yieldedConsumers.end(), consumer) == m_yieldedConsumers.end())
+    {
+        m_yieldedConsumers.push_back(consumer);
+    }
+}
+
+void OrchDaemon::setConsumerTimeBudget()
+{
+    auto budget = std::chrono::microseconds(gConsumerTimeBudgetMsecs * 1000);
+    for (Orch *o : m_orchList)
+    {
+        o->setConsumerTimeBudget(budget, latencySensitiveTables);
+    }
+}
+
 void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
 
+    setConsumerTimeBudget();
     for (Orch *o : m_orchList)
     {
         m_select->addSelectables(o->getSelectables());
     }
+    m_select->addSelectables(m_flushPolicyOrch->getSelectables());
 
-    auto tstart = std::chrono::high_resolution_clock::now();
+    m_lastRetry = std::chrono::high_resolution_clock::now();
+    m_lastFlush = m_lastRetry;
+    m_lastStatsPublish = m_lastRetry;
 
     while (true)
     {
         Selectable *s;
         int ret;
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        /* Wake up earlier when there are tasks waiting to be retried */
+        int timeout = m_retryPending ? RETRY_INTERVAL_MSECS : SELECT_TIMEOUT;
 
-        auto tend = std::chrono::high_resolution_clock::now();
+        /* Wake up in time to flush the queued operations once they are too old */
+        timeout = m_flushPolicyOrch->getSelectTimeout(timeout);
 
-        auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart);
+        bool yielded = !m_yieldedConsumers.empty();
 
-        if (diff.count() >= SELECT_TIMEOUT)
+        if (yielded)
         {
-            tstart = std::chrono::high_resolution_clock::now();
+            /* Consumers have work left, only pick up the selectables which are ready */
+            ret = m_select->select(&s, 0);
+        }
+        else if (m_flushPolicyOrch->hasPendingOperations() && m_flushPolicyOrch->getFlushOnIdle())
+        {
+            /* Flush right away when no consumer has anything left to do */
+            ret = m_select->select(&s, 0);
+            if (ret == Select::TIMEOUT)
+            {
+                flush(FlushReason::IDLE);
+                ret = m_select->select(&s, m_retryPending ? RETRY_INTERVAL_MSECS : SELECT_TIMEOUT);
+            }
+        }
+        else
+        {
+            ret = m_select->select(&s, timeout);
+        }
+
+        auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - m_lastFlush);
 
+        /* Operations not accounted by the flush policy (e.g. retries) are flushed periodically */
+        if (diff.count() >= SELECT_TIMEOUT)
+        {
             flush();
         }
 
+        auto statsDiff = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - m_lastStatsPublish);
+        if (statsDiff.count() >= CONSUMER_STATS_INTERVAL_MSECS)
+        {
+            publishConsumerStats();
+        }
+
         if (ret == Select::ERROR)
         {
             SWSS_LOG_NOTICE("Error: %s!\n", strerror(errno));
             continue;
         }
 
-        if (ret == Select::TIMEOUT)
+        if (ret == Select::TIMEOUT && !yielded)
         {
+            if (m_retryPending)
+            {
+                doPendingTasks(true);
+            }
+
             /* Let sairedis to flush all SAI function call to ASIC DB.
              * Normally the redis pipeline will flush when enough request
              * accumulated. Still it is possible that small amount of
              * requests live in it. When the daemon has nothing to do, it
              * is a good chance to flush the pipeline  */
-            flush();
+            FlushReason reason = FlushReason::IDLE;
+            m_flushPolicyOrch->needFlush(reason);
+            flush(reason);
             continue;
         }
 
-        auto *c = (Executor *)s;
-        c->execute();
+        if (ret != Select::TIMEOUT)
+        {
+            execute((Executor *)s);
+        }
 
-        /* After each iteration, periodically check all m_toSync map to
-         * execute all the remaining tasks that need to be retried. */
+        /*
+         * Give one more turn to the consumer at the head of the yielded
+         * queue, round-robin. Ready selectables are served first, by
+         * priority, so a large table only delays them by one time budget.
+         */
+        if (!m_yieldedConsumers.empty())
+        {
+            Consumer *consumer = m_yieldedConsumers.front();
+            m_yieldedConsumers.pop_front();
+            execute(consumer);
+        }
 
-        /* TODO: Abstract Orch class to have a specific todo list */
-        for (Orch *o : m_orchList)
-            o->doTask();
+        /* After each iteration, drain the Orchs which received new tasks.
+         * The remaining tasks that need to be retried are executed only
+         * once per RETRY_INTERVAL_MSECS. */
+        auto retryDiff = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - m_lastRetry);
+        doPendingTasks(retryDiff.count() >= RETRY_INTERVAL_MSECS);
+
+        FlushReason reason;
+        if (m_flushPolicyOrch->needFlush(reason))
+        {
+            flush(reason);
+        }
 
         /*
          * Asked to check warm restart readiness.
@@ -839,6 +1026,32 @@ bool OrchDaemon::warmRestoreAndSyncUp()
     return true;
 }
 
+/* Publish the latency and backlog statistics of each consumer to COUNTERS_DB */
+void OrchDaemon::publishConsumerStats()
+{
+    SWSS_LOG_ENTER();
+
+    for (Orch *o : m_orchList)
+    {
+        o->publishConsumerStats(*m_consumerStatsTable);
+    }
+    m_flushPolicyOrch->publishConsumerStats(*m_consumerStatsTable);
+
+    m_lastStatsPublish = std::chrono::high_resolution_clock::now();
+}
+
+/*
+ * Get the statistics of the consumers of each orch, one line per consumer
+ */
+void OrchDaemon::getConsumerStats(vector<string> &ts)
+{
+    for (Orch *o : m_orchList)
+    {
+        o->dumpConsumerStats(ts);
+    }
+    m_flushPolicyOrch->dumpConsumerStats(ts);
+}
+
 /*
  * Get tasks to sync for consumers of each orch being managed by this orch daemon
  */
@@ -868,6 +1081,14 @@ bool OrchDaemon::warmRestoreValidation()
         {
             SWSS_LOG_NOTICE("%s", s.c_str());
         }
+
+        vector<string> stats;
+        getConsumerStats(stats);
+        SWSS_LOG_NOTICE("Consumer statistics: ");
+        for (auto &s : stats)
+        {
+            SWSS_LOG_NOTICE("%s", s.c_str());
+        }
     }
     WarmStart::setWarmStartState("orchagent", WarmStart::RESTORED);
     return ts.empty();
@@ -6,6 +6,9 @@
 #include "consumertable.h"
 #include "select.h"
 
+#include <chrono>
+#include <deque>
+
 #include "portsorch.h"
 #include "fabricportsorch.h"
 #include "intfsorch.h"
@@ -45,6 +48,7 @@
 #include "bfdorch.h"
 #include "srv6orch.h"
 #include "nvgreorch.h"
+#include "flushpolicyorch.h"
 
 using namespace swss;
 
@@ -58,15 +62,25 @@ public:
     void start();
     bool warmRestoreAndSyncUp();
     void getTaskToSync(vector<string> &ts);
+    void getConsumerStats(vector<string> &ts);
     bool warmRestoreValidation();
 
     bool warmRestartCheck();
 
     void addOrchList(Orch* o);
+
+    /* Apply gConsumerTimeBudgetMsecs to the consumers, but the latency sensitive ones */
+    void setConsumerTimeBudget();
     void setFabricEnabled(bool enabled)
     {
         m_fabricEnabled = enabled;
     }
+
+    /* Number of Orchs drained/skipped by the last scheduling pass */
+    size_t getLastVisitedOrchs() const { return m_lastVisitedOrchs; }
+    size_t getLastSkippedOrchs() const { return m_lastSkippedOrchs; }
+    uint64_t getTotalVisitedOrchs() const { return m_totalVisitedOrchs; }
+    uint64_t getTotalSkippedOrchs() const { return m_totalSkippedOrchs; }
 private:
     DBConnector *m_applDb;
     DBConnector *m_configDb;
@@ -78,7 +92,30 @@ private:
     std::vector<Orch *> m_orchList;
     Select *m_select;
 
-    void flush();
+    /* Some Orch still holds tasks to be retried */
+    bool m_retryPending = false;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_lastRetry;
+
+    size_t m_lastVisitedOrchs = 0;
+    size_t m_lastSkippedOrchs = 0;
+    uint64_t m_totalVisitedOrchs = 0;
+    uint64_t m_totalSkippedOrchs = 0;
+
+    /* Consumers which used up their time budget with entries left in their table */
+    std::deque<Consumer *> m_yieldedConsumers;
+
+    /* Decides when to flush the sairedis pipeline */
+    FlushPolicyOrch *m_flushPolicyOrch;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_lastFlush;
+
+    std::shared_ptr<DBConnector> m_countersDb;
+    std::unique_ptr<Table> m_consumerStatsTable;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_lastStatsPublish;
+
+    void flush(FlushReason reason = FlushReason::FORCED);
+    void doPendingTasks(bool retry);
+    void execute(Executor *executor);
+    void publishConsumerStats();
 };
 
 class FabricOrchDaemon : public OrchDaemon
@@ -43,4 +43,9 @@ int DBConnector::getDbId() const
     return m_dbId;
 }
 
+DBConnector *DBConnector::newConnector(unsigned int timeout) const
+{
+    return new DBConnector(m_dbId, "", timeout);
+}
+
 } // namespace swss
@@ -11,6 +11,11 @@ ProducerTable::ProducerTable(DBConnector *db, const std::string &tableName)
 {
 }
 
+ProducerTable::ProducerTable(RedisPipeline *pipeline, const std::string &tableName, bool buffered)
+    : TableBase(tableName, ":"), TableName_KeyValueOpQueues(tableName)
+{
+}
+
 ProducerTable::~ProducerTable()
 {
 }
@@ -24,4 +29,12 @@ void ProducerTable::del(const std::string &key, const std::string &op, const std
 {
 }
 
+void ProducerTable::setBuffered(bool buffered)
+{
+}
+
+void ProducerTable::flush()
+{
+}
+
 } // namespace swss
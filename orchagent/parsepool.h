@@ -0,0 +1,147 @@
+#ifndef SWSS_PARSEPOOL_H
+#define SWSS_PARSEPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Worker pool used to pre-parse the entries popped by a Consumer before the
+ * Orch processes them on the main thread.
+ *
+ * run() calls the task once for every index of a batch, from the workers and
+ * from the calling thread, and returns once all calls are done. Tasks must not
+ * touch any Orch state nor log: they only turn the strings of an entry into
+ * typed values stored at their own index. The Orch then consumes the results
+ * in the order of m_toSync, so the order of the entries of a key is the same
+ * as without the pool.
+ */
+class ParsePool
+{
+public:
+    typedef std::function<void(size_t)> Task;
+
+    explicit ParsePool(size_t threads)
+    {
+        for (size_t i = 0; i < threads; i++)
+        {
+            m_threads.emplace_back(&ParsePool::worker, this);
+        }
+    }
+
+    ~ParsePool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeCv.notify_all();
+
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    ParsePool(const ParsePool&) = delete;
+    ParsePool& operator=(const ParsePool&) = delete;
+
+    size_t size() const
+    {
+        return m_threads.size();
+    }
+
+    void run(size_t count, const Task &task)
+    {
+        if (count <= PARSE_CHUNK_SIZE || m_threads.empty())
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                task(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_count = count;
+            m_next = 0;
+            m_busy = m_threads.size();
+            m_generation++;
+        }
+        m_wakeCv.notify_all();
+
+        work(task, count);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCv.wait(lock, [this] { return m_busy == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    /* Indexes claimed at once, to keep the shared counter off the hot path */
+    static const size_t PARSE_CHUNK_SIZE = 16;
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCv;
+    std::condition_variable m_doneCv;
+
+    const Task *m_task = nullptr;
+    size_t m_count = 0;
+    std::atomic<size_t> m_next { 0 };
+    /* Incremented by each run(), tells the workers a new batch is available */
+    uint64_t m_generation = 0;
+    /* Workers which did not finish the current batch yet */
+    size_t m_busy = 0;
+    bool m_stop = false;
+
+    void work(const Task &task, size_t count)
+    {
+        size_t begin;
+        while ((begin = m_next.fetch_add(PARSE_CHUNK_SIZE)) < count)
+        {
+            size_t end = std::min(begin + PARSE_CHUNK_SIZE, count);
+            for (size_t i = begin; i < end; i++)
+            {
+                task(i);
+            }
+        }
+    }
+
+    void worker()
+    {
+        uint64_t generation = 0;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wakeCv.wait(lock, [&] { return m_stop || m_generation != generation; });
+            if (m_stop)
+            {
+                return;
+            }
+
+            generation = m_generation;
+            const Task *task = m_task;
+            size_t count = m_count;
+
+            lock.unlock();
+            work(*task, count);
+            lock.lock();
+
+            if (--m_busy == 0)
+            {
+                m_doneCv.notify_one();
+            }
+        }
+    }
+};
+
+#endif /* SWSS_PARSEPOOL_H */
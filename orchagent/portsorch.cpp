@@ -13,6 +13,7 @@
 #include <sstream>
 #include <set>
 #include <algorithm>
+#include <chrono>
 #include <tuple>
 #include <sstream>
 #include <unordered_set>
@@ -55,6 +56,7 @@ extern string gMySwitchType;
 extern int32_t gVoqMySwitchId;
 extern string gMyHostName;
 extern string gMyAsicName;
+extern size_t gMaxBulkSize;
 
 #define DEFAULT_SYSTEM_PORT_MTU 9100
 #define VLAN_PREFIX         "Vlan"
@@ -69,6 +71,8 @@ extern string gMyAsicName;
 #define PG_DROP_FLEX_STAT_COUNTER_POLL_MSECS         "10000"
 #define PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS   "1000"
 
+#define STATE_PORT_INIT_TIMING_TABLE "PORT_INIT_TIMING"
+
 
 static map<string, sai_port_fec_mode_t> fec_mode_map =
 {
@@ -331,13 +335,19 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
                 PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, StatsMode::READ,
                 PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false),
         port_buffer_drop_stat_manager(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP, StatsMode::READ, PORT_BUFFER_DROP_STAT_POLLING_INTERVAL_MS, false),
-        queue_stat_manager(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, StatsMode::READ, QUEUE_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false)
+        queue_stat_manager(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, StatsMode::READ, QUEUE_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false),
+        gBridgePortBulker(sai_bridge_api, gSwitchId, gMaxBulkSize),
+        gVlanMemberBulker(sai_vlan_api, gSwitchId, gMaxBulkSize),
+        gLagMemberBulker(sai_lag_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
+    m_dependencySubject.attach(&m_dependencyObserver);
+
     /* Initialize counter table */
     m_counter_db = shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
-    m_counterTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PORT_NAME_MAP));
+    m_counterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_counter_db.get()));
+    m_counterTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PORT_NAME_MAP, false));
     m_counterLagTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_LAG_NAME_MAP));
     FieldValueTuple tuple("", "");
     vector<FieldValueTuple> defaultLagFv;
@@ -351,22 +361,24 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     m_gearboxTable = unique_ptr<Table>(new Table(db, "_GEARBOX_TABLE"));
 
     /* Initialize queue tables */
-    m_queueTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_NAME_MAP));
-    m_queuePortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_PORT_MAP));
-    m_queueIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_INDEX_MAP));
-    m_queueTypeTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_TYPE_MAP));
+    m_queueTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_NAME_MAP, false));
+    m_queuePortTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_PORT_MAP, false));
+    m_queueIndexTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_INDEX_MAP, false));
+    m_queueTypeTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_TYPE_MAP, false));
 
     /* Initialize ingress priority group tables */
-    m_pgTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_NAME_MAP));
-    m_pgPortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_PORT_MAP));
-    m_pgIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_INDEX_MAP));
+    m_pgTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PG_NAME_MAP, false));
+    m_pgPortTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PG_PORT_MAP, false));
+    m_pgIndexTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PG_INDEX_MAP, false));
 
     m_flex_db = shared_ptr<DBConnector>(new DBConnector("FLEX_COUNTER_DB", 0));
-    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
+    m_flexCounterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_flex_db.get()));
+    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE, false));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
     m_state_db = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
     m_stateBufferMaximumValueTable = unique_ptr<Table>(new Table(m_state_db.get(), STATE_BUFFER_MAXIMUM_VALUE_TABLE));
+    m_statePortInitTimingTable = unique_ptr<Table>(new Table(m_state_db.get(), STATE_PORT_INIT_TIMING_TABLE));
 
     initGearbox();
 
@@ -769,33 +781,50 @@ bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    const Port *port = findPort(alias);
+    if (!port)
     {
         return false;
     }
-    else
-    {
-        p = m_portList[alias];
-        return true;
-    }
+
+    p = *port;
+    return true;
 }
 
 bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    auto itr = saiOidToAlias.find(id);
-    if (itr == saiOidToAlias.end())
+    const Port *p = findPort(id);
+    if (!p)
     {
         return false;
     }
-    else
+
+    port = *p;
+    return true;
+}
+
+const Port *PortsOrch::findPort(const string &alias) const
+{
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
     {
-        getPort(itr->second, port);
-        return true;
+        return nullptr;
     }
 
-    return false;
+    return &itr->second;
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id) const
+{
+    auto itr = saiOidToPort.find(id);
+    if (itr == saiOidToPort.end())
+    {
+        return nullptr;
+    }
+
+    return itr->second;
 }
 
 void PortsOrch::increasePortRefCount(const string &alias)
@@ -832,18 +861,7 @@ bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port
 {
     SWSS_LOG_ENTER();
 
-    auto itr = saiOidToAlias.find(bridge_port_id);
-    if (itr == saiOidToAlias.end())
-    {
-        return false;
-    }
-    else
-    {
-        getPort(itr->second, port);
-        return true;
-    }
-
-    return false;
+    return getPort(bridge_port_id, port);
 }
 
 bool PortsOrch::addSubPort(Port &port, const string &alias, const string &vlan, const bool &adminUp, const uint32_t &mtu)
@@ -976,7 +994,7 @@ bool PortsOrch::removeSubPort(const string &alias)
     }
     m_portList[parentPort.m_alias] = parentPort;
 
-    m_portList.erase(it);
+    erasePort(it);
 
     // Restore hostif vlan tag for the parent port when the last subport is removed
     if (parentPort.m_child_ports.empty())
@@ -2403,102 +2421,184 @@ bool PortsOrch::initPort(const string &alias, const string &role, const int inde
 {
     SWSS_LOG_ENTER();
 
-    /* Determine if the lane combination exists in switch */
-    if (m_portListLaneMap.find(lane_set) != m_portListLaneMap.end())
+    deque<PortInitContext> ports;
+    ports.emplace_back(alias, role, index, lane_set);
+    initPorts(ports);
+
+    return ports.front().done;
+}
+
+/*
+ * Initialize the ports phase by phase instead of port by port:
+ * 1) Get the queues, priority groups, buffer limits, admin status and speed
+ *    of all the ports.
+ * 2) Create their host interfaces. No get is interleaved with the creates,
+ *    so that sairedis does not have to flush its pipeline for each port.
+ * 3) Add the ports to the port list and write their counter name maps and
+ *    flex counters as one batch.
+ * The duration of each phase is written to STATE_DB PORT_INIT_TIMING.
+ */
+void PortsOrch::initPorts(deque<PortInitContext> &ports)
+{
+    SWSS_LOG_ENTER();
+
+    auto start = chrono::steady_clock::now();
+    vector<PortInitContext *> pending;
+
+    for (auto &ctx : ports)
     {
-        sai_object_id_t id = m_portListLaneMap[lane_set];
+        /* Determine if the lane combination exists in switch */
+        auto lanes = m_portListLaneMap.find(ctx.lanes);
+        if (lanes == m_portListLaneMap.end())
+        {
+            SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", ctx.alias.c_str());
+            continue;
+        }
+
+        sai_object_id_t id = lanes->second;
 
         /* Determine if the port has already been initialized before */
-        if (m_portList.find(alias) != m_portList.end() && m_portList[alias].m_port_id == id)
+        auto existing = m_portList.find(ctx.alias);
+        if (existing != m_portList.end() && existing->second.m_port_id == id)
         {
-            SWSS_LOG_DEBUG("Port has already been initialized before alias:%s", alias.c_str());
+            SWSS_LOG_DEBUG("Port has already been initialized before alias:%s", ctx.alias.c_str());
+            ctx.done = true;
+            continue;
         }
-        else
+
+        ctx.port = Port(ctx.alias, Port::PHY);
+        ctx.port.m_index = ctx.index;
+        ctx.port.m_port_id = id;
+
+        if (!initializePortAttributes(ctx.port))
         {
-            Port p(alias, Port::PHY);
+            SWSS_LOG_ERROR("Failed to initialize port %s", ctx.alias.c_str());
+            continue;
+        }
 
-            p.m_index = index;
-            p.m_port_id = id;
+        pending.push_back(&ctx);
+    }
 
-            /* Initialize the port and create corresponding host interface */
-            if (initializePort(p))
-            {
-                /* Create associated Gearbox lane mapping */
-                initGearboxPort(p);
-
-                /* Add port to port list */
-                m_portList[alias] = p;
-                saiOidToAlias[id] = alias;
-                m_port_ref_count[alias] = 0;
-                m_portOidToIndex[id] = index;
-
-                /* Add port name map to counter table */
-                FieldValueTuple tuple(p.m_alias, sai_serialize_object_id(p.m_port_id));
-                vector<FieldValueTuple> fields;
-                fields.push_back(tuple);
-                m_counterTable->set("", fields);
-
-                // Install a flex counter for this port to track stats
-                auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
-                /* Delay installing the counters if they are yet enabled
-                If they are enabled, install the counters immediately */
-                if (flex_counters_orch->getPortCountersState())
-                {
-                    auto port_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP);
-                    port_stat_manager.setCounterIdList(p.m_port_id,
-                            CounterType::PORT, port_counter_stats);
-                    auto gbport_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, true);
-                    if (p.m_system_side_id)
-                        gb_port_stat_manager.setCounterIdList(p.m_system_side_id,
-                                CounterType::PORT, gbport_counter_stats);
-                    if (p.m_line_side_id)
-                        gb_port_stat_manager.setCounterIdList(p.m_line_side_id,
-                                CounterType::PORT, gbport_counter_stats);
-                }
-                if (flex_counters_orch->getPortBufferDropCountersState())
-                {
-                    auto port_buffer_drop_stats = generateCounterStats(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP);
-                    port_buffer_drop_stat_manager.setCounterIdList(p.m_port_id, CounterType::PORT, port_buffer_drop_stats);
-                }
+    if (pending.empty())
+    {
+        return;
+    }
 
-                /* when a port is added and priority group map counter is enabled --> we need to add pg counter for it */
-                if (m_isPriorityGroupMapGenerated)
-                {
-                    generatePriorityGroupMapPerPort(p);
-                }
+    auto attributesDone = chrono::steady_clock::now();
 
-                /* when a port is added and queue map counter is enabled --> we need to add queue map counter for it */
-                if (m_isQueueMapGenerated)
-                {
-                    generateQueueMapPerPort(p);
-                }
+    vector<PortInitContext *> created;
+    for (auto ctx : pending)
+    {
+        /* Create the corresponding host interface */
+        if (!initializePortHostIntf(ctx->port))
+        {
+            SWSS_LOG_ERROR("Failed to initialize port %s", ctx->alias.c_str());
+            continue;
+        }
 
-                PortUpdate update = { p, true };
-                notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+        created.push_back(ctx);
+    }
 
-                m_portList[alias].m_init = true;
+    auto hostIntfsDone = chrono::steady_clock::now();
 
-                if (role == "Rec" || role == "Inb")
-                {
-                    m_recircPortRole[alias] = role;
-                }
+    auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+    vector<FieldValueTuple> portNames;
 
-                SWSS_LOG_NOTICE("Initialized port %s", alias.c_str());
+    {
+        CounterBatch batch(this);
+
+        for (auto ctx : created)
+        {
+            Port &p = ctx->port;
+
+            /* Create associated Gearbox lane mapping */
+            initGearboxPort(p);
+
+            /* Add port to port list */
+            m_portList[ctx->alias] = p;
+            saiOidToPort[p.m_port_id] = &m_portList[ctx->alias];
+            m_port_ref_count[ctx->alias] = 0;
+            m_portOidToIndex[p.m_port_id] = ctx->index;
+
+            /* Add port name map to counter table */
+            portNames.emplace_back(p.m_alias, sai_serialize_object_id(p.m_port_id));
+
+            // Install a flex counter for this port to track stats
+            /* Delay installing the counters if they are yet enabled
+            If they are enabled, install the counters immediately */
+            if (flex_counters_orch->getPortCountersState())
+            {
+                auto port_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP);
+                port_stat_manager.setCounterIdList(p.m_port_id,
+                        CounterType::PORT, port_counter_stats);
+                auto gbport_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, true);
+                if (p.m_system_side_id)
+                    gb_port_stat_manager.setCounterIdList(p.m_system_side_id,
+                            CounterType::PORT, gbport_counter_stats);
+                if (p.m_line_side_id)
+                    gb_port_stat_manager.setCounterIdList(p.m_line_side_id,
+                            CounterType::PORT, gbport_counter_stats);
             }
-            else
+            if (flex_counters_orch->getPortBufferDropCountersState())
             {
-                SWSS_LOG_ERROR("Failed to initialize port %s", alias.c_str());
-                return false;
+                auto port_buffer_drop_stats = generateCounterStats(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP);
+                port_buffer_drop_stat_manager.setCounterIdList(p.m_port_id, CounterType::PORT, port_buffer_drop_stats);
+            }
+
+            /* when a port is added and priority group map counter is enabled --> we need to add pg counter for it */
+            if (m_isPriorityGroupMapGenerated)
+            {
+                generatePriorityGroupMapPerPort(p);
+            }
+
+            /* when a port is added and queue map counter is enabled --> we need to add queue map counter for it */
+            if (m_isQueueMapGenerated)
+            {
+                generateQueueMapPerPort(p);
             }
         }
+
+        if (!portNames.empty())
+        {
+            m_counterTable->set("", portNames);
+        }
     }
-    else
+
+    for (auto ctx : created)
     {
-        SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", alias.c_str());
-        return false;
+        PortUpdate update = { ctx->port, true };
+        notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+
+        m_portList[ctx->alias].m_init = true;
+
+        m_dependencySubject.publish(ctx->alias);
+
+        if (ctx->role == "Rec" || ctx->role == "Inb")
+        {
+            m_recircPortRole[ctx->alias] = ctx->role;
+        }
+
+        ctx->done = true;
+
+        SWSS_LOG_NOTICE("Initialized port %s", ctx->alias.c_str());
     }
 
-    return true;
+    auto countersDone = chrono::steady_clock::now();
+
+    auto ms = [](chrono::steady_clock::duration d) {
+        return to_string(chrono::duration_cast<chrono::milliseconds>(d).count());
+    };
+
+    /* Ports initialized before PortInitDone are the cold boot ones */
+    vector<FieldValueTuple> timings;
+    timings.emplace_back("ports", to_string(created.size()));
+    timings.emplace_back("attributes_ms", ms(attributesDone - start));
+    timings.emplace_back("host_interfaces_ms", ms(hostIntfsDone - attributesDone));
+    timings.emplace_back("counters_ms", ms(countersDone - hostIntfsDone));
+    timings.emplace_back("total_ms", ms(countersDone - start));
+    m_statePortInitTimingTable->set(m_initDone ? "runtime" : "boot", timings);
+
+    SWSS_LOG_NOTICE("Initialized %zu ports in %s ms", created.size(), ms(countersDone - start).c_str());
 }
 
 void PortsOrch::deInitPort(string alias, sai_object_id_t port_id)
@@ -2641,6 +2741,32 @@ void PortsOrch::removePortFromPortListMap(sai_object_id_t port_id)
     }
 }
 
+/*
+ * Erase a port from m_portList along with the entries of saiOidToPort
+ * which point to it, so that no dangling Port pointer is left behind.
+ */
+void PortsOrch::erasePort(map<string, Port>::iterator it)
+{
+    if (it == m_portList.end())
+    {
+        return;
+    }
+
+    const Port &port = it->second;
+
+    for (auto id : { port.m_port_id, port.m_bridge_port_id, port.m_lag_id,
+                     port.m_vlan_info.vlan_oid, port.m_tunnel_id })
+    {
+        auto oid_it = saiOidToPort.find(id);
+        if (oid_it != saiOidToPort.end() && oid_it->second == &port)
+        {
+            saiOidToPort.erase(oid_it);
+        }
+    }
+
+    m_portList.erase(it);
+}
+
 
 void PortsOrch::doPortTask(Consumer &consumer)
 {
@@ -2910,7 +3036,8 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
-                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
+                deque<PortInitContext> ports;
+                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end(); it++)
                 {
                     if (m_portListLaneMap.find(it->first) == m_portListLaneMap.end())
                     {
@@ -2920,15 +3047,18 @@ void PortsOrch::doPortTask(Consumer &consumer)
                         }
                     }
 
-                    if (!initPort(get<0>(it->second), get<5>(it->second), get<4>(it->second), it->first))
+                    ports.emplace_back(get<0>(it->second), get<5>(it->second), get<4>(it->second), it->first);
+                }
+
+                initPorts(ports);
+
+                for (const auto &ctx : ports)
+                {
+                    // Failure has been recorded in initPorts
+                    if (ctx.done)
                     {
-                        // Failure has been recorded in initPort
-                        it++;
-                        continue;
+                        initPortSupportedSpeeds(ctx.alias, m_portListLaneMap[ctx.lanes]);
                     }
-
-                    initPortSupportedSpeeds(get<0>(it->second), m_portListLaneMap[it->first]);
-                    it++;
                 }
 
                 m_portConfigState = PORT_CONFIG_DONE;
@@ -3439,7 +3569,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
             removePortFromPortListMap(port_id);
 
             /* Delete port from port list */
-            m_portList.erase(alias);
+            erasePort(m_portList.find(alias));
         }
         else
         {
@@ -3577,112 +3707,216 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        auto &t = it->second;
+        // VLAN member bulk results will be stored in a map
+        std::map<
+                std::pair<
+                        std::string,            // Key
+                        std::string             // Op
+                >,
+                VlanMemberBulkContext
+        >                                       toBulk;
+        // Bridge ports created for the members, by port alias
+        std::map<std::string, BridgePortBulkContext> bridgePorts;
 
-        string key = kfvKey(t);
-
-        /* Ensure the key starts with "Vlan" otherwise ignore */
-        if (strncmp(key.c_str(), VLAN_PREFIX, 4))
+        // Queue the bridge ports and VLAN members to create
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_ERROR("Invalid key format. No 'Vlan' prefix: %s", key.c_str());
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            auto &t = it->second;
 
-        key = key.substr(4);
-        size_t found = key.find(':');
-        int vlan_id;
-        string vlan_alias, port_alias;
-        if (found != string::npos)
-        {
-            vlan_id = stoi(key.substr(0, found)); // FIXME: might raise exception
-            port_alias = key.substr(found+1);
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Invalid key format. No member port is presented: %s",
-                           kfvKey(t).c_str());
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            string key = kfvKey(t);
+            string op = kfvOp(t);
 
-        vlan_alias = VLAN_PREFIX + to_string(vlan_id);
-        string op = kfvOp(t);
+            /* Create the queued member before processing the next operation on it */
+            if (toBulk.find(make_pair(key, SET_COMMAND)) != toBulk.end())
+            {
+                break;
+            }
 
-        assert(m_portList.find(vlan_alias) != m_portList.end());
-        Port vlan, port;
+            /* Ensure the key starts with "Vlan" otherwise ignore */
+            if (strncmp(key.c_str(), VLAN_PREFIX, 4))
+            {
+                SWSS_LOG_ERROR("Invalid key format. No 'Vlan' prefix: %s", key.c_str());
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
 
-        /* When VLAN member is to be created before VLAN is created */
-        if (!getPort(vlan_alias, vlan))
-        {
-            SWSS_LOG_INFO("Failed to locate VLAN %s", vlan_alias.c_str());
-            it++;
-            continue;
-        }
+            key = key.substr(4);
+            size_t found = key.find(':');
+            int vlan_id;
+            string vlan_alias, port_alias;
+            if (found != string::npos)
+            {
+                vlan_id = stoi(key.substr(0, found)); // FIXME: might raise exception
+                port_alias = key.substr(found+1);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Invalid key format. No member port is presented: %s",
+                               kfvKey(t).c_str());
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
 
-        if (!getPort(port_alias, port))
-        {
-            SWSS_LOG_DEBUG("%s is not not yet created, delaying", port_alias.c_str());
-            it++;
-            continue;
-        }
+            vlan_alias = VLAN_PREFIX + to_string(vlan_id);
 
-        if (op == SET_COMMAND)
-        {
-            string tagging_mode = "untagged";
+            assert(m_portList.find(vlan_alias) != m_portList.end());
+            Port vlan, port;
 
-            for (auto i : kfvFieldsValues(t))
+            /* When VLAN member is to be created before VLAN is created */
+            if (!getPort(vlan_alias, vlan))
             {
-                if (fvField(i) == "tagging_mode")
-                    tagging_mode = fvValue(i);
+                SWSS_LOG_INFO("Failed to locate VLAN %s", vlan_alias.c_str());
+                it = consumer.park(it, vlan_alias);
+                continue;
             }
 
-            if (tagging_mode != "untagged" &&
-                tagging_mode != "tagged"   &&
-                tagging_mode != "priority_tagged")
+            if (!getPort(port_alias, port))
             {
-                SWSS_LOG_ERROR("Wrong tagging_mode '%s' for key: %s", tagging_mode.c_str(), kfvKey(t).c_str());
-                it = consumer.m_toSync.erase(it);
+                SWSS_LOG_DEBUG("%s is not not yet created, delaying", port_alias.c_str());
+                it = consumer.park(it, port_alias);
                 continue;
             }
 
-            /* Duplicate entry */
-            if (vlan.m_members.find(port_alias) != vlan.m_members.end())
+            if (op == SET_COMMAND)
             {
-                it = consumer.m_toSync.erase(it);
-                continue;
-            }
+                string tagging_mode = "untagged";
 
-            if (addBridgePort(port) && addVlanMember(vlan, port, tagging_mode))
-                it = consumer.m_toSync.erase(it);
-            else
+                for (auto i : kfvFieldsValues(t))
+                {
+                    if (fvField(i) == "tagging_mode")
+                        tagging_mode = fvValue(i);
+                }
+
+                if (tagging_mode != "untagged" &&
+                    tagging_mode != "tagged"   &&
+                    tagging_mode != "priority_tagged")
+                {
+                    SWSS_LOG_ERROR("Wrong tagging_mode '%s' for key: %s", tagging_mode.c_str(), kfvKey(t).c_str());
+                    it = consumer.m_toSync.erase(it);
+                    continue;
+                }
+
+                /* Duplicate entry */
+                if (vlan.m_members.find(port_alias) != vlan.m_members.end())
+                {
+                    it = consumer.m_toSync.erase(it);
+                    continue;
+                }
+
+                /* A port joining several VLANs of the bulk gets a single bridge port */
+                vector<sai_attribute_t> attrs;
+                if (port.m_bridge_port_id == SAI_NULL_OBJECT_ID &&
+                    bridgePorts.find(port_alias) == bridgePorts.end() &&
+                    getBridgePortAttrs(port, attrs))
+                {
+                    auto &bridgePort = bridgePorts[port_alias];
+                    gBridgePortBulker.create_entry(&bridgePort.bridge_port_id,
+                            (uint32_t)attrs.size(), attrs.data(), &bridgePort.object_status);
+                }
+
+                toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(kfvKey(t), op),
+                        std::forward_as_tuple(vlan_alias, port_alias, tagging_mode));
                 it++;
-        }
-        else if (op == DEL_COMMAND)
-        {
-            if (vlan.m_members.find(port_alias) != vlan.m_members.end())
+            }
+            else if (op == DEL_COMMAND)
             {
-                if (removeVlanMember(vlan, port))
+                /* Create the queued members first, the port may lose its bridge port */
+                if (!toBulk.empty())
                 {
-                    if (m_portVlanMember[port.m_alias].empty())
+                    break;
+                }
+
+                if (vlan.m_members.find(port_alias) != vlan.m_members.end())
+                {
+                    if (removeVlanMember(vlan, port))
                     {
-                        removeBridgePort(port);
+                        if (m_portVlanMember[port.m_alias].empty())
+                        {
+                            removeBridgePort(port);
+                        }
+                        it = consumer.m_toSync.erase(it);
+                    }
+                    else
+                    {
+                        it++;
                     }
-                    it = consumer.m_toSync.erase(it);
                 }
                 else
-                {
-                    it++;
-                }
+                    /* Cannot locate the VLAN */
+                    it = consumer.m_toSync.erase(it);
             }
             else
-                /* Cannot locate the VLAN */
+            {
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
                 it = consumer.m_toSync.erase(it);
+            }
         }
-        else
+
+        gBridgePortBulker.flush();
+
+        for (auto &bridgePort : bridgePorts)
         {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            auto &ctx = bridgePort.second;
+            Port port;
+            if (ctx.object_status == SAI_STATUS_NOT_EXECUTED || !getPort(bridgePort.first, port))
+            {
+                continue;
+            }
+
+            port.m_bridge_port_id = ctx.bridge_port_id;
+            ctx.done = addBridgePortPost(port, ctx.object_status);
+        }
+
+        // Queue the members whose port has a bridge port
+        for (auto &member : toBulk)
+        {
+            auto &ctx = member.second;
+            Port vlan, port;
+            if (!getPort(ctx.vlan_alias, vlan) || !getPort(ctx.port_alias, port))
+            {
+                continue;
+            }
+
+            if (port.m_bridge_port_id == SAI_NULL_OBJECT_ID)
+            {
+                /* Not retried when the bridge port creation failed for good */
+                auto found = bridgePorts.find(ctx.port_alias);
+                ctx.done = found != bridgePorts.end() && found->second.done;
+                continue;
+            }
+
+            vector<sai_attribute_t> attrs;
+            ctx.sai_tagging_mode = getVlanMemberAttrs(vlan, port, ctx.tagging_mode, attrs);
+            gVlanMemberBulker.create_entry(&ctx.vlan_member_id,
+                    (uint32_t)attrs.size(), attrs.data(), &ctx.object_status);
+            ctx.queued = true;
+        }
+
+        gVlanMemberBulker.flush();
+
+        // Go through the bulker results, the VLAN and port of every member are
+        // fetched again as the previous members of the bulk updated them
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
+        {
+            string key = kfvKey(it_prev->second);
+            string op = kfvOp(it_prev->second);
+            auto found = toBulk.find(make_pair(key, op));
+            if (found == toBulk.end())
+            {
+                it_prev++;
+                continue;
+            }
+
+            if (addVlanMemberPost(found->second))
+            {
+                it_prev = consumer.m_toSync.erase(it_prev);
+            }
+            else
+            {
+                it_prev++;
+            }
         }
     }
 }
@@ -3877,159 +4111,212 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
     SWSS_LOG_ENTER();
 
     string table_name = consumer.getTableName();
+    bool parse_failed = false;
 
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        auto &t = it->second;
+        // LAG member bulk results will be stored in a map
+        std::map<
+                std::pair<
+                        std::string,            // Key
+                        std::string             // Op
+                >,
+                LagMemberBulkContext
+        >                                       toBulk;
+        // Ports joining a LAG in this bulk
+        std::set<std::string>                   bulkPorts;
 
-        /* Retrieve LAG alias and LAG member alias from key */
-        string key = kfvKey(t);
-        size_t found = key.find(':');
-        /* Return if the format of key is wrong */
-        if (found == string::npos)
+        // Queue the LAG members to create
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_ERROR("Failed to parse %s", key.c_str());
-            return;
-        }
-        string lag_alias = key.substr(0, found);
-        string port_alias = key.substr(found+1);
-
-        string op = kfvOp(t);
+            auto &t = it->second;
 
-        Port lag, port;
-        if (!getPort(lag_alias, lag))
-        {
-            SWSS_LOG_INFO("Failed to locate LAG %s", lag_alias.c_str());
-            it++;
-            continue;
-        }
+            /* Retrieve LAG alias and LAG member alias from key */
+            string key = kfvKey(t);
+            string op = kfvOp(t);
 
-        if (!getPort(port_alias, port))
-        {
-            SWSS_LOG_ERROR("Failed to locate port %s", port_alias.c_str());
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            /* Create the queued member before processing the next operation on it */
+            if (toBulk.find(make_pair(key, SET_COMMAND)) != toBulk.end())
+            {
+                break;
+            }
 
-        /* Fail if a port type is not a valid type for being a LAG member port.
-         * Erase invalid entry, no need to retry in this case. */
-        if (!isValidPortTypeForLagMember(port))
-        {
-            SWSS_LOG_ERROR("LAG member port has to be of type PHY or SYSTEM");
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            size_t found = key.find(':');
+            /* Return if the format of key is wrong */
+            if (found == string::npos)
+            {
+                SWSS_LOG_ERROR("Failed to parse %s", key.c_str());
+                parse_failed = true;
+                break;
+            }
+            string lag_alias = key.substr(0, found);
+            string port_alias = key.substr(found+1);
 
-        if (table_name == CHASSIS_APP_LAG_MEMBER_TABLE_NAME)
-        {
-            int32_t lag_switch_id = lag.m_system_lag_info.switch_id;
-            if (lag_switch_id == gVoqMySwitchId)
+            Port lag, port;
+            if (!getPort(lag_alias, lag))
             {
-                //Synced local member addition to local lag. Skip
-                it = consumer.m_toSync.erase(it);
+                SWSS_LOG_INFO("Failed to locate LAG %s", lag_alias.c_str());
+                it = consumer.park(it, lag_alias);
                 continue;
             }
 
-            //Sanity check: The switch id-s of lag and member must match
-            int32_t port_switch_id = port.m_system_port_info.switch_id;
-            if (port_switch_id != lag_switch_id)
+            if (!getPort(port_alias, port))
             {
-                SWSS_LOG_ERROR("System lag switch id mismatch. Lag %s switch id: %d, Member %s switch id: %d",
-                        lag_alias.c_str(), lag_switch_id, port_alias.c_str(), port_switch_id);
+                SWSS_LOG_ERROR("Failed to locate port %s", port_alias.c_str());
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
-        }
 
-        /* Update a LAG member */
-        if (op == SET_COMMAND)
-        {
-            string status;
-            for (auto i : kfvFieldsValues(t))
+            /* Fail if a port type is not a valid type for being a LAG member port.
+             * Erase invalid entry, no need to retry in this case. */
+            if (!isValidPortTypeForLagMember(port))
             {
-                if (fvField(i) == "status")
-                    status = fvValue(i);
+                SWSS_LOG_ERROR("LAG member port has to be of type PHY or SYSTEM");
+                it = consumer.m_toSync.erase(it);
+                continue;
             }
 
-            if (lag.m_members.find(port_alias) == lag.m_members.end())
+            if (table_name == CHASSIS_APP_LAG_MEMBER_TABLE_NAME)
             {
-                if (port.m_lag_member_id != SAI_NULL_OBJECT_ID)
+                int32_t lag_switch_id = lag.m_system_lag_info.switch_id;
+                if (lag_switch_id == gVoqMySwitchId)
                 {
-                    SWSS_LOG_INFO("Port %s is already a LAG member", port.m_alias.c_str());
-                    it++;
+                    //Synced local member addition to local lag. Skip
+                    it = consumer.m_toSync.erase(it);
                     continue;
                 }
 
-                if (!addLagMember(lag, port, (status == "enabled")))
+                //Sanity check: The switch id-s of lag and member must match
+                int32_t port_switch_id = port.m_system_port_info.switch_id;
+                if (port_switch_id != lag_switch_id)
                 {
-                    it++;
+                    SWSS_LOG_ERROR("System lag switch id mismatch. Lag %s switch id: %d, Member %s switch id: %d",
+                            lag_alias.c_str(), lag_switch_id, port_alias.c_str(), port_switch_id);
+                    it = consumer.m_toSync.erase(it);
                     continue;
                 }
             }
 
-            /* Sync an enabled member */
-            if (status == "enabled")
+            /* Update a LAG member */
+            if (op == SET_COMMAND)
             {
-                /* enable collection first, distribution-only mode
-                 * is not supported on Mellanox platform
-                 */
-                if (setCollectionOnLagMember(port, true) &&
-                    setDistributionOnLagMember(port, true))
+                string status;
+                for (auto i : kfvFieldsValues(t))
+                {
+                    if (fvField(i) == "status")
+                        status = fvValue(i);
+                }
+
+                if (lag.m_members.find(port_alias) == lag.m_members.end())
+                {
+                    /* The port joins another LAG of this bulk, wait for the result */
+                    if (bulkPorts.find(port_alias) != bulkPorts.end())
+                    {
+                        break;
+                    }
+
+                    if (port.m_lag_member_id != SAI_NULL_OBJECT_ID)
+                    {
+                        SWSS_LOG_INFO("Port %s is already a LAG member", port.m_alias.c_str());
+                        it++;
+                        continue;
+                    }
+
+                    sai_uint32_t pvid;
+                    if (getPortPvid(lag, pvid))
+                    {
+                        setPortPvid (port, pvid);
+                        m_portList[port.m_alias] = port;
+                    }
+
+                    vector<sai_attribute_t> attrs;
+                    getLagMemberAttrs(lag, port, (status == "enabled"), attrs);
+
+                    auto &ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key, op),
+                            std::forward_as_tuple(lag_alias, port_alias, status)).first->second;
+                    gLagMemberBulker.create_entry(&ctx.lag_member_id,
+                            (uint32_t)attrs.size(), attrs.data(), &ctx.object_status);
+                    bulkPorts.insert(port_alias);
+                    it++;
+                    continue;
+                }
+
+                if (setLagMemberStatus(port, status))
                 {
                     it = consumer.m_toSync.erase(it);
                 }
                 else
                 {
                     it++;
-                    continue;
                 }
             }
-            /* Sync an disabled member */
-            else /* status == "disabled" */
+            /* Remove a LAG member */
+            else if (op == DEL_COMMAND)
             {
-                /* disable distribution first, distribution-only mode
-                 * is not supported on Mellanox platform
-                 */
-                if (setDistributionOnLagMember(port, false) &&
-                    setCollectionOnLagMember(port, false))
+                /* Create the queued members first */
+                if (!toBulk.empty())
+                {
+                    break;
+                }
+
+                /* Assert the LAG member exists */
+                assert(lag.m_members.find(port_alias) != lag.m_members.end());
+
+                if (!port.m_lag_id || !port.m_lag_member_id)
+                {
+                    SWSS_LOG_WARN("Member %s not found in LAG %s lid:%" PRIx64 " lmid:%" PRIx64 ",",
+                            port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_lag_member_id);
+                    it = consumer.m_toSync.erase(it);
+                    continue;
+                }
+
+                if (removeLagMember(lag, port))
                 {
                     it = consumer.m_toSync.erase(it);
                 }
                 else
                 {
                     it++;
-                    continue;
                 }
             }
+            else
+            {
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+                it = consumer.m_toSync.erase(it);
+            }
         }
-        /* Remove a LAG member */
-        else if (op == DEL_COMMAND)
-        {
-            /* Assert the LAG member exists */
-            assert(lag.m_members.find(port_alias) != lag.m_members.end());
 
-            if (!port.m_lag_id || !port.m_lag_member_id)
+        gLagMemberBulker.flush();
+
+        // Go through the bulker results, the LAG and port of every member are
+        // fetched again as the previous members of the bulk updated them
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
+        {
+            string key = kfvKey(it_prev->second);
+            string op = kfvOp(it_prev->second);
+            auto found = toBulk.find(make_pair(key, op));
+            if (found == toBulk.end())
             {
-                SWSS_LOG_WARN("Member %s not found in LAG %s lid:%" PRIx64 " lmid:%" PRIx64 ",",
-                        port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_lag_member_id);
-                it = consumer.m_toSync.erase(it);
+                it_prev++;
                 continue;
             }
 
-            if (removeLagMember(lag, port))
+            if (addLagMemberPost(found->second))
             {
-                it = consumer.m_toSync.erase(it);
+                it_prev = consumer.m_toSync.erase(it_prev);
             }
             else
             {
-                it++;
+                it_prev++;
             }
         }
-        else
+
+        if (parse_failed)
         {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            return;
         }
     }
 }
@@ -4215,19 +4502,20 @@ bool PortsOrch::initializePort(Port &port)
 {
     SWSS_LOG_ENTER();
 
+    return initializePortAttributes(port) && initializePortHostIntf(port);
+}
+
+/* Get the initial state of the port, only SAI gets */
+bool PortsOrch::initializePortAttributes(Port &port)
+{
+    SWSS_LOG_ENTER();
+
     SWSS_LOG_NOTICE("Initializing port alias:%s pid:%" PRIx64, port.m_alias.c_str(), port.m_port_id);
 
     initializePriorityGroups(port);
     initializeQueues(port);
     initializePortBufferMaximumParameters(port);
 
-    /* Create host interface */
-    if (!addHostIntfs(port, port.m_alias, port.m_hif_id))
-    {
-        SWSS_LOG_ERROR("Failed to create host interface for port %s", port.m_alias.c_str());
-        return false;
-    }
-
     /* Check warm start states */
     vector<FieldValueTuple> tuples;
     bool exist = m_portTable->get(port.m_alias, tuples);
@@ -4277,6 +4565,21 @@ bool PortsOrch::initializePort(Port &port)
         return false;
     }
 
+    return true;
+}
+
+/* Create the host interface of the port, no SAI get */
+bool PortsOrch::initializePortHostIntf(Port &port)
+{
+    SWSS_LOG_ENTER();
+
+    /* Create host interface */
+    if (!addHostIntfs(port, port.m_alias, port.m_hif_id))
+    {
+        SWSS_LOG_ERROR("Failed to create host interface for port %s", port.m_alias.c_str());
+        return false;
+    }
+
     /*
      * always initialize Port SAI_HOSTIF_ATTR_OPER_STATUS based on oper_status value in appDB.
      */
@@ -4284,7 +4587,7 @@ bool PortsOrch::initializePort(Port &port)
     if (!setHostIntfsOperStatus(port, isUp))
     {
         SWSS_LOG_WARN("Failed to set operation status %s to host interface %s",
-                      operStatus.c_str(), port.m_alias.c_str());
+                      oper_status_strings.at(port.m_oper_status).c_str(), port.m_alias.c_str());
         return false;
     }
 
@@ -4365,8 +4668,19 @@ bool PortsOrch::addBridgePort(Port &port)
         return true;
     }
 
-    sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
+    if (!getBridgePortAttrs(port, attrs))
+    {
+        return false;
+    }
+
+    sai_status_t status = sai_bridge_api->create_bridge_port(&port.m_bridge_port_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    return addBridgePortPost(port, status);
+}
+
+bool PortsOrch::getBridgePortAttrs(const Port &port, vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
 
     if (port.m_type == Port::PHY)
     {
@@ -4427,7 +4741,11 @@ bool PortsOrch::addBridgePort(Port &port)
     }
     attrs.push_back(attr);
 
-    sai_status_t status = sai_bridge_api->create_bridge_port(&port.m_bridge_port_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    return true;
+}
+
+bool PortsOrch::addBridgePortPost(Port &port, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to add bridge port %s to default 1Q bridge, rv:%d",
@@ -4446,7 +4764,7 @@ bool PortsOrch::addBridgePort(Port &port)
         return false;
     }
     m_portList[port.m_alias] = port;
-    saiOidToAlias[port.m_bridge_port_id] = port.m_alias;
+    saiOidToPort[port.m_bridge_port_id] = &m_portList[port.m_alias];
     SWSS_LOG_NOTICE("Add bridge port %s to default 1Q bridge", port.m_alias.c_str());
 
     PortUpdate update = { port, true };
@@ -4503,7 +4821,7 @@ bool PortsOrch::removeBridgePort(Port &port)
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
-    saiOidToAlias.erase(port.m_bridge_port_id);
+    saiOidToPort.erase(port.m_bridge_port_id);
     port.m_bridge_port_id = SAI_NULL_OBJECT_ID;
 
     /* Remove bridge port */
@@ -4587,7 +4905,9 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_members = set<string>();
     m_portList[vlan_alias] = vlan;
     m_port_ref_count[vlan_alias] = 0;
-    saiOidToAlias[vlan_oid] =  vlan_alias;
+    saiOidToPort[vlan_oid] = &m_portList[vlan_alias];
+
+    m_dependencySubject.publish(vlan_alias);
 
     return true;
 }
@@ -4651,8 +4971,7 @@ bool PortsOrch::removeVlan(Port vlan)
     SWSS_LOG_NOTICE("Remove VLAN %s vid:%hu", vlan.m_alias.c_str(),
             vlan.m_vlan_info.vlan_id);
 
-    saiOidToAlias.erase(vlan.m_vlan_info.vlan_oid);
-    m_portList.erase(vlan.m_alias);
+    erasePort(m_portList.find(vlan.m_alias));
     m_port_ref_count.erase(vlan.m_alias);
 
     return true;
@@ -4691,8 +5010,17 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, stri
         return addVlanFloodGroups(vlan, port, end_point_ip);
     }
 
-    sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
+    sai_vlan_tagging_mode_t sai_tagging_mode = getVlanMemberAttrs(vlan, port, tagging_mode, attrs);
+
+    sai_object_id_t vlan_member_id;
+    sai_status_t status = sai_vlan_api->create_vlan_member(&vlan_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    return addVlanMemberPost(vlan, port, vlan_member_id, sai_tagging_mode, status);
+}
+
+sai_vlan_tagging_mode_t PortsOrch::getVlanMemberAttrs(const Port &vlan, const Port &port, const string &tagging_mode, vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
 
     attr.id = SAI_VLAN_MEMBER_ATTR_VLAN_ID;
     attr.value.oid = vlan.m_vlan_info.vlan_oid;
@@ -4715,8 +5043,11 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, stri
     attr.value.s32 = sai_tagging_mode;
     attrs.push_back(attr);
 
-    sai_object_id_t vlan_member_id;
-    sai_status_t status = sai_vlan_api->create_vlan_member(&vlan_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    return sai_tagging_mode;
+}
+
+bool PortsOrch::addVlanMemberPost(Port &vlan, Port &port, sai_object_id_t vlan_member_id, sai_vlan_tagging_mode_t sai_tagging_mode, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to add member %s to VLAN %s vid:%hu pid:%" PRIx64,
@@ -4752,6 +5083,30 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, stri
     return true;
 }
 
+bool PortsOrch::addVlanMemberPost(const VlanMemberBulkContext &ctx)
+{
+    if (!ctx.queued)
+    {
+        return ctx.done;
+    }
+
+    /* Not created when an earlier member of the bulk failed */
+    if (ctx.object_status == SAI_STATUS_NOT_EXECUTED)
+    {
+        return false;
+    }
+
+    Port vlan, port;
+    if (!getPort(ctx.vlan_alias, vlan) || !getPort(ctx.port_alias, port))
+    {
+        SWSS_LOG_ERROR("Failed to locate VLAN %s or port %s of the created member",
+                ctx.vlan_alias.c_str(), ctx.port_alias.c_str());
+        return false;
+    }
+
+    return addVlanMemberPost(vlan, port, ctx.vlan_member_id, ctx.sai_tagging_mode, ctx.object_status);
+}
+
 bool PortsOrch::getPortVlanMembers(Port &port, vlan_members_t &vlan_members)
 {
     vlan_members = m_portVlanMember[port.m_alias];
@@ -5107,11 +5462,13 @@ bool PortsOrch::addLag(string lag_alias, uint32_t spa_id, int32_t switch_id)
     lag.m_members = set<string>();
     m_portList[lag_alias] = lag;
     m_port_ref_count[lag_alias] = 0;
-    saiOidToAlias[lag_id] = lag_alias;
+    saiOidToPort[lag_id] = &m_portList[lag_alias];
 
     PortUpdate update = { lag, true };
     notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
 
+    m_dependencySubject.publish(lag_alias);
+
     FieldValueTuple tuple(lag_alias, sai_serialize_object_id(lag_id));
     vector<FieldValueTuple> fields;
     fields.push_back(tuple);
@@ -5180,8 +5537,7 @@ bool PortsOrch::removeLag(Port lag)
 
     SWSS_LOG_NOTICE("Remove LAG %s lid:%" PRIx64, lag.m_alias.c_str(), lag.m_lag_id);
 
-    saiOidToAlias.erase(lag.m_lag_id);
-    m_portList.erase(lag.m_alias);
+    erasePort(m_portList.find(lag.m_alias));
     m_port_ref_count.erase(lag.m_alias);
 
     PortUpdate update = { lag, false };
@@ -5215,7 +5571,7 @@ bool PortsOrch::removeLag(Port lag)
     return true;
 }
 
-void PortsOrch::getLagMember(Port &lag, vector<Port> &portv)
+void PortsOrch::getLagMember(const Port &lag, vector<Port> &portv)
 {
     Port member;
 
@@ -5240,8 +5596,17 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
         setPortPvid (port, pvid);
     }
 
-    sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
+    getLagMemberAttrs(lag, port, enableForwarding, attrs);
+
+    sai_object_id_t lag_member_id;
+    sai_status_t status = sai_lag_api->create_lag_member(&lag_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    return addLagMemberPost(lag, port, lag_member_id, status);
+}
+
+void PortsOrch::getLagMemberAttrs(const Port &lag, const Port &port, bool enableForwarding, vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
 
     attr.id = SAI_LAG_MEMBER_ATTR_LAG_ID;
     attr.value.oid = lag.m_lag_id;
@@ -5261,10 +5626,10 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
         attr.value.booldata = true;
         attrs.push_back(attr);
     }
+}
 
-    sai_object_id_t lag_member_id;
-    sai_status_t status = sai_lag_api->create_lag_member(&lag_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-
+bool PortsOrch::addLagMemberPost(Port &lag, Port &port, sai_object_id_t lag_member_id, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64,
@@ -5387,6 +5752,57 @@ bool PortsOrch::setLagTpid(sai_object_id_t id, sai_uint16_t tpid)
 }
 
 
+bool PortsOrch::addLagMemberPost(const LagMemberBulkContext &ctx)
+{
+    /* Not created when an earlier member of the bulk failed */
+    if (ctx.object_status == SAI_STATUS_NOT_EXECUTED)
+    {
+        return false;
+    }
+
+    Port lag, port;
+    if (!getPort(ctx.lag_alias, lag) || !getPort(ctx.port_alias, port))
+    {
+        SWSS_LOG_ERROR("Failed to locate LAG %s or port %s of the created member",
+                ctx.lag_alias.c_str(), ctx.port_alias.c_str());
+        return false;
+    }
+
+    if (!addLagMemberPost(lag, port, ctx.lag_member_id, ctx.object_status))
+    {
+        return false;
+    }
+
+    /* Not retried when the member creation failed for good */
+    if (port.m_lag_member_id == SAI_NULL_OBJECT_ID)
+    {
+        return true;
+    }
+
+    return setLagMemberStatus(port, ctx.status);
+}
+
+bool PortsOrch::setLagMemberStatus(Port &lagMember, const string &status)
+{
+    /* Sync an enabled member */
+    if (status == "enabled")
+    {
+        /* enable collection first, distribution-only mode
+         * is not supported on Mellanox platform
+         */
+        return setCollectionOnLagMember(lagMember, true) &&
+               setDistributionOnLagMember(lagMember, true);
+    }
+
+    /* Sync an disabled member */
+    /* status == "disabled" */
+    /* disable distribution first, distribution-only mode
+     * is not supported on Mellanox platform
+     */
+    return setDistributionOnLagMember(lagMember, false) &&
+           setCollectionOnLagMember(lagMember, false);
+}
+
 bool PortsOrch::setCollectionOnLagMember(Port &lagMember, bool enableCollection)
 {
     /* Port must be LAG member */
@@ -5486,11 +5902,64 @@ bool PortsOrch::removeTunnel(Port tunnel)
 {
     SWSS_LOG_ENTER();
 
-    m_portList.erase(tunnel.m_alias);
+    erasePort(m_portList.find(tunnel.m_alias));
 
     return true;
 }
 
+/*
+ * Buffer the writes of the counter name maps and of the flex counters until
+ * the outermost commitCounterBatch(), which sends them through one pipeline
+ * per DB. Use a CounterBatch rather than calling these directly.
+ */
+void PortsOrch::beginCounterBatch()
+{
+    if (m_counterBatchDepth++)
+    {
+        return;
+    }
+
+    for (auto table : { m_counterTable.get(), m_queueTable.get(), m_queuePortTable.get(), m_queueIndexTable.get(),
+                        m_queueTypeTable.get(), m_pgTable.get(), m_pgPortTable.get(), m_pgIndexTable.get() })
+    {
+        table->setBuffered(true);
+    }
+    m_flexCounterTable->setBuffered(true);
+
+    port_stat_manager.beginBatch();
+    gb_port_stat_manager.beginBatch();
+    port_buffer_drop_stat_manager.beginBatch();
+    queue_stat_manager.beginBatch();
+}
+
+void PortsOrch::commitCounterBatch()
+{
+    if (m_counterBatchDepth == 0)
+    {
+        SWSS_LOG_WARN("No counter batch to commit");
+        return;
+    }
+
+    if (--m_counterBatchDepth)
+    {
+        return;
+    }
+
+    m_counterPipeline->flush();
+    m_flexCounterPipeline->flush();
+    for (auto table : { m_counterTable.get(), m_queueTable.get(), m_queuePortTable.get(), m_queueIndexTable.get(),
+                        m_queueTypeTable.get(), m_pgTable.get(), m_pgPortTable.get(), m_pgIndexTable.get() })
+    {
+        table->setBuffered(false);
+    }
+    m_flexCounterTable->setBuffered(false);
+
+    port_stat_manager.commitBatch();
+    gb_port_stat_manager.commitBatch();
+    port_buffer_drop_stat_manager.commitBatch();
+    queue_stat_manager.commitBatch();
+}
+
 void PortsOrch::generateQueueMap()
 {
     if (m_isQueueMapGenerated)
@@ -5498,6 +5967,7 @@ void PortsOrch::generateQueueMap()
         return;
     }
 
+    CounterBatch batch(this);
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
@@ -5614,6 +6084,7 @@ void PortsOrch::generatePriorityGroupMap()
         return;
     }
 
+    CounterBatch batch(this);
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
@@ -5718,6 +6189,7 @@ void PortsOrch::generatePortCounterMap()
 
     auto port_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP);
     auto gbport_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, true);
+    FlexCounterBatch batch({ &port_stat_manager, &gb_port_stat_manager });
     for (const auto& it: m_portList)
     {
         // Set counter stats only for PHY ports to ensure syncd will not try to query the counter statistics from the HW for non-PHY ports.
@@ -5746,6 +6218,7 @@ void PortsOrch::generatePortBufferDropCounterMap()
     }
 
     auto port_buffer_drop_stats = generateCounterStats(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP);
+    FlexCounterBatch batch({ &port_buffer_drop_stat_manager });
     for (const auto& it: m_portList)
     {
         // Set counter stats only for PHY ports to ensure syncd will not try to query the counter statistics from the HW for non-PHY ports.
@@ -7023,6 +7496,20 @@ void PortsOrch::updateGearboxPortOperStatus(const Port& port)
     }
 }
 
+bool PortsOrch::incrFdbCount(const std::string& alias, int count)
+{
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
+    {
+        return false;
+    }
+    else
+    {
+        itr->second.m_fdb_count += count;
+    }
+    return true;
+}
+
 bool PortsOrch::decrFdbCount(const std::string& alias, int count)
 {
     auto itr = m_portList.find(alias);
@@ -14,6 +14,8 @@
 #include "saihelper.h"
 #include "lagid.h"
 #include "flexcounterorch.h"
+#include "taskdependency.h"
+#include "bulker.h"
 
 
 #define FCS_LEN 4
@@ -72,6 +74,71 @@ struct VlanMemberUpdate
     bool add;
 };
 
+struct BridgePortBulkContext
+{
+    sai_object_id_t                     bridge_port_id = SAI_NULL_OBJECT_ID;
+    sai_status_t                        object_status = SAI_STATUS_NOT_EXECUTED;
+    bool                                done = false;   // Result of the bridge port creation
+};
+
+struct VlanMemberBulkContext
+{
+    string                              vlan_alias;
+    string                              port_alias;
+    string                              tagging_mode;
+    sai_vlan_tagging_mode_t             sai_tagging_mode = SAI_VLAN_TAGGING_MODE_UNTAGGED;
+    sai_object_id_t                     vlan_member_id = SAI_NULL_OBJECT_ID;
+    sai_status_t                        object_status = SAI_STATUS_NOT_EXECUTED;
+    bool                                queued = false; // Member creation queued in the bulker
+    bool                                done = false;   // Result when the creation was not queued
+
+    VlanMemberBulkContext(const string& vlan_alias, const string& port_alias, const string& tagging_mode)
+        : vlan_alias(vlan_alias), port_alias(port_alias), tagging_mode(tagging_mode)
+    {
+    }
+
+    // Disable any copy constructors
+    VlanMemberBulkContext(const VlanMemberBulkContext&) = delete;
+    VlanMemberBulkContext(VlanMemberBulkContext&&) = delete;
+};
+
+struct LagMemberBulkContext
+{
+    string                              lag_alias;
+    string                              port_alias;
+    string                              status;
+    sai_object_id_t                     lag_member_id = SAI_NULL_OBJECT_ID;
+    sai_status_t                        object_status = SAI_STATUS_NOT_EXECUTED;
+
+    LagMemberBulkContext(const string& lag_alias, const string& port_alias, const string& status)
+        : lag_alias(lag_alias), port_alias(port_alias), status(status)
+    {
+    }
+
+    // Disable any copy constructors
+    LagMemberBulkContext(const LagMemberBulkContext&) = delete;
+    LagMemberBulkContext(LagMemberBulkContext&&) = delete;
+};
+
+struct PortInitContext
+{
+    string                              alias;
+    string                              role;
+    int                                 index;
+    set<int>                            lanes;
+    Port                                port;
+    bool                                done = false;   // Port initialized, now or before
+
+    PortInitContext(const string& alias, const string& role, int index, const set<int>& lanes)
+        : alias(alias), role(role), index(index), lanes(lanes)
+    {
+    }
+
+    // Disable any copy constructors
+    PortInitContext(const PortInitContext&) = delete;
+    PortInitContext(PortInitContext&&) = delete;
+};
+
 class PortsOrch : public Orch, public Subject
 {
 public:
@@ -90,6 +157,10 @@ public:
     bool setBridgePortLearningFDB(Port &port, sai_bridge_port_fdb_learning_mode_t mode);
     bool getPort(string alias, Port &port);
     bool getPort(sai_object_id_t id, Port &port);
+    /* Same lookups without copying the Port, valid until the port is removed.
+     * The Port is updated through PortsOrch, e.g. setPort() or incrFdbCount() */
+    const Port *findPort(const string &alias) const;
+    const Port *findPort(sai_object_id_t id) const;
     void increasePortRefCount(const string &alias);
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
@@ -139,7 +210,7 @@ public:
     bool addSubPort(Port &port, const string &alias, const string &vlan, const bool &adminUp = true, const uint32_t &mtu = 0);
     bool removeSubPort(const string &alias);
     bool updateL3VniStatus(uint16_t vlan_id, bool status);
-    void getLagMember(Port &lag, vector<Port> &portv);
+    void getLagMember(const Port &lag, vector<Port> &portv);
     void updateChildPortsMtu(const Port &p, const uint32_t mtu);
 
     bool addTunnel(string tunnel,sai_object_id_t, bool learning=true);
@@ -171,9 +242,23 @@ public:
 
     void updateGearboxPortOperStatus(const Port& port);
 
+    bool incrFdbCount(const string& alias, int count);
     bool decrFdbCount(const string& alias, int count);
 
+    /* Publishes the alias of each port, LAG and VLAN being created */
+    DependencySubject& getDependencySubject()
+    {
+        return m_dependencySubject;
+    }
+
 private:
+    DependencySubject m_dependencySubject;
+    /* Wakes VLAN and LAG members parked on a missing port, LAG or VLAN */
+    DependencyObserver m_dependencyObserver{this};
+
+    /* The port, queue and PG name maps share one pipeline, buffered while ports are initialized */
+    unique_ptr<RedisPipeline> m_counterPipeline;
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
     unique_ptr<Table> m_counterTable;
     unique_ptr<Table> m_counterLagTable;
     unique_ptr<Table> m_portTable;
@@ -186,6 +271,7 @@ private:
     unique_ptr<Table> m_pgPortTable;
     unique_ptr<Table> m_pgIndexTable;
     unique_ptr<Table> m_stateBufferMaximumValueTable;
+    unique_ptr<Table> m_statePortInitTimingTable;
     unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
     Table m_portStateTable;
@@ -242,11 +328,11 @@ private:
     map<set<int>, tuple<string, uint32_t, int, string, int, string>> m_lanesAliasSpeedMap;
     map<string, Port> m_portList;
     map<string, vlan_members_t> m_portVlanMember;
-    /* mapping from SAI object ID to Name for faster
-     * retrieval of Port/VLAN from object ID for events
-     * coming from SAI
+    /* mapping from SAI object ID (port, LAG, VLAN or bridge port)
+     * to its entry of m_portList for faster retrieval of Port/VLAN
+     * from object ID for events coming from SAI
      */
-    unordered_map<sai_object_id_t, string> saiOidToAlias;
+    unordered_map<sai_object_id_t, Port *> saiOidToPort;
     unordered_map<sai_object_id_t, int> m_portOidToIndex;
     map<string, uint32_t> m_port_ref_count;
     unordered_set<string> m_pendingPortSet;
@@ -257,6 +343,10 @@ private:
 
     NotificationConsumer* m_portStatusNotificationConsumer;
 
+    ObjectBulker<sai_bridge_api_t> gBridgePortBulker;
+    ObjectBulker<sai_vlan_api_t> gVlanMemberBulker;
+    ObjectBulker<sai_lag_api_t> gLagMemberBulker;
+
     void doTask() override;
     void doTask(Consumer &consumer);
     void doPortTask(Consumer &consumer);
@@ -269,10 +359,13 @@ private:
 
     void removePortFromLanesMap(string alias);
     void removePortFromPortListMap(sai_object_id_t port_id);
+    void erasePort(map<string, Port>::iterator it);
     void removeDefaultVlanMembers();
     void removeDefaultBridgePorts();
 
     bool initializePort(Port &port);
+    bool initializePortAttributes(Port &port);
+    bool initializePortHostIntf(Port &port);
     void initializePriorityGroups(Port &port);
     void initializePortBufferMaximumParameters(Port &port);
     void initializeQueues(Port &port);
@@ -282,6 +375,12 @@ private:
 
     bool setBridgePortLearnMode(Port &port, string learn_mode);
 
+    bool getBridgePortAttrs(const Port &port, vector<sai_attribute_t> &attrs);
+    bool addBridgePortPost(Port &port, sai_status_t status);
+    sai_vlan_tagging_mode_t getVlanMemberAttrs(const Port &vlan, const Port &port, const string &tagging_mode, vector<sai_attribute_t> &attrs);
+    bool addVlanMemberPost(Port &vlan, Port &port, sai_object_id_t vlan_member_id, sai_vlan_tagging_mode_t tagging_mode, sai_status_t status);
+    bool addVlanMemberPost(const VlanMemberBulkContext &ctx);
+
     bool addVlan(string vlan);
     bool removeVlan(Port vlan);
 
@@ -289,6 +388,10 @@ private:
     bool removeLag(Port lag);
     bool setLagTpid(sai_object_id_t id, sai_uint16_t tpid);
     bool addLagMember(Port &lag, Port &port, bool enableForwarding);
+    void getLagMemberAttrs(const Port &lag, const Port &port, bool enableForwarding, vector<sai_attribute_t> &attrs);
+    bool addLagMemberPost(Port &lag, Port &port, sai_object_id_t lag_member_id, sai_status_t status);
+    bool addLagMemberPost(const LagMemberBulkContext &ctx);
+    bool setLagMemberStatus(Port &lagMember, const string &status);
     bool removeLagMember(Port &lag, Port &port);
     bool setCollectionOnLagMember(Port &lagMember, bool enableCollection);
     bool setDistributionOnLagMember(Port &lagMember, bool enableDistribution);
@@ -296,6 +399,7 @@ private:
     bool addPort(const set<int> &lane_set, uint32_t speed, int an=0, string fec="");
     sai_status_t removePort(sai_object_id_t port_id);
     bool initPort(const string &alias, const string &role, const int index, const set<int> &lane_set);
+    void initPorts(deque<PortInitContext> &ports);
     void deInitPort(string alias, sai_object_id_t port_id);
 
     bool setPortAdminStatus(Port &port, bool up);
@@ -322,6 +426,31 @@ private:
 
     bool getQueueTypeAndIndex(sai_object_id_t queue_id, string &type, uint8_t &index);
 
+    uint32_t m_counterBatchDepth = 0;
+    void beginCounterBatch();
+    void commitCounterBatch();
+
+    /* Buffers the counter writes during its lifetime, batches may be nested */
+    class CounterBatch
+    {
+    public:
+        CounterBatch(PortsOrch *portsOrch) : m_portsOrch(portsOrch)
+        {
+            m_portsOrch->beginCounterBatch();
+        }
+
+        ~CounterBatch()
+        {
+            m_portsOrch->commitCounterBatch();
+        }
+
+        CounterBatch(const CounterBatch&) = delete;
+        CounterBatch& operator=(const CounterBatch&) = delete;
+
+    private:
+        PortsOrch *m_portsOrch;
+    };
+
     bool m_isQueueMapGenerated = false;
     void generateQueueMapPerPort(const Port& port);
     void removeQueueMapPerPort(const Port& port);
@@ -0,0 +1,318 @@
+#ifndef SWSS_PREFIXTRIE_H
+#define SWSS_PREFIXTRIE_H
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sys/socket.h>
+
+/*
+ * Longest prefix match index mapping IP prefixes to values, one path
+ * compressed binary trie per address family. A node is only kept for a
+ * prefix or where two branches split, so a lookup visits at most one node
+ * per prefix length whatever the number of prefixes.
+ *
+ * Host addresses are stored as full length prefixes. The callbacks of the
+ * walks must not insert nor erase entries.
+ */
+template <typename T>
+class PrefixTrie
+{
+public:
+    PrefixTrie() : m_size(0)
+    {
+    }
+
+    PrefixTrie(const PrefixTrie&) = delete;
+    PrefixTrie& operator=(const PrefixTrie&) = delete;
+    PrefixTrie(PrefixTrie&&) = default;
+    PrefixTrie& operator=(PrefixTrie&&) = default;
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void clear()
+    {
+        m_roots[0].reset();
+        m_roots[1].reset();
+        m_size = 0;
+    }
+
+    /* Sets the value of the prefix, returns false if the prefix was present */
+    bool insert(const swss::IpPrefix &prefix, const T &value)
+    {
+        return insert(prefix.getIp(), static_cast<uint8_t>(prefix.getMaskLength()), value);
+    }
+
+    bool insert(const swss::IpAddress &host, const T &value)
+    {
+        return insert(host, maxLength(host), value);
+    }
+
+    bool erase(const swss::IpPrefix &prefix)
+    {
+        return erase(prefix.getIp(), static_cast<uint8_t>(prefix.getMaskLength()));
+    }
+
+    bool erase(const swss::IpAddress &host)
+    {
+        return erase(host, maxLength(host));
+    }
+
+    const T *find(const swss::IpPrefix &prefix) const
+    {
+        Key key = makeKey(prefix.getIp());
+        uint8_t length = static_cast<uint8_t>(prefix.getMaskLength());
+        const Node *node = descend(prefix.getIp().isV4(), key, length);
+
+        if (!node || node->length != length || !node->valued)
+        {
+            return nullptr;
+        }
+        return &node->value;
+    }
+
+    /* Calls f with the values of the prefixes covering the address, shortest first */
+    template <typename F>
+    void forEachCovering(const swss::IpAddress &address, F f) const
+    {
+        Key key = makeKey(address);
+        uint8_t length = maxLength(address);
+        const Node *node = root(address.isV4()).get();
+
+        while (node && node->length <= length && matches(node->key, key, node->length))
+        {
+            if (node->valued)
+            {
+                f(node->value);
+            }
+            if (node->length == length)
+            {
+                break;
+            }
+            node = node->child[bit(key, node->length)].get();
+        }
+    }
+
+    /* Value of the longest prefix covering the address, null if none */
+    const T *longestMatch(const swss::IpAddress &address) const
+    {
+        const T *match = nullptr;
+        forEachCovering(address, [&match](const T &value) { match = &value; });
+        return match;
+    }
+
+    /* Calls f with the values of the prefixes and hosts within the prefix */
+    template <typename F>
+    void forEachWithin(const swss::IpPrefix &prefix, F f) const
+    {
+        Key key = makeKey(prefix.getIp());
+        uint8_t length = static_cast<uint8_t>(prefix.getMaskLength());
+        const Node *node = descend(prefix.getIp().isV4(), key, length);
+
+        if (node)
+        {
+            visit(node, f);
+        }
+    }
+
+private:
+    typedef std::array<uint8_t, 16> Key;
+
+    struct Node
+    {
+        Key key;
+        uint8_t length;
+        bool valued;
+        T value;
+        std::unique_ptr<Node> child[2];
+
+        Node(const Key &key, uint8_t length) : key(key), length(length), valued(false), value()
+        {
+        }
+    };
+
+    std::unique_ptr<Node> m_roots[2];
+    size_t m_size;
+
+    std::unique_ptr<Node> &root(bool v4) { return m_roots[v4 ? 0 : 1]; }
+    const std::unique_ptr<Node> &root(bool v4) const { return m_roots[v4 ? 0 : 1]; }
+
+    static uint8_t maxLength(const swss::IpAddress &address)
+    {
+        return address.isV4() ? 32 : 128;
+    }
+
+    static Key makeKey(const swss::IpAddress &address)
+    {
+        Key key = {};
+        auto ip = address.getIp();
+        if (ip.family == AF_INET)
+        {
+            memcpy(key.data(), &ip.ip_addr.ipv4_addr, 4);
+        }
+        else
+        {
+            memcpy(key.data(), ip.ip_addr.ipv6_addr, 16);
+        }
+        return key;
+    }
+
+    static size_t bit(const Key &key, uint8_t index)
+    {
+        return (key[index / 8] >> (7 - index % 8)) & 1;
+    }
+
+    /* Number of leading bits a and b share, up to length */
+    static uint8_t commonLength(const Key &a, const Key &b, uint8_t length)
+    {
+        for (size_t i = 0; i * 8 < length; i++)
+        {
+            uint8_t diff = static_cast<uint8_t>(a[i] ^ b[i]);
+            if (diff)
+            {
+                size_t common = i * 8 + static_cast<size_t>(__builtin_clz(diff) - 24);
+                return static_cast<uint8_t>(std::min<size_t>(common, length));
+            }
+        }
+        return length;
+    }
+
+    static bool matches(const Key &a, const Key &b, uint8_t length)
+    {
+        return commonLength(a, b, length) == length;
+    }
+
+    /* First node of the family at or below length bits of key, null if none */
+    const Node *descend(bool v4, const Key &key, uint8_t length) const
+    {
+        const Node *node = root(v4).get();
+
+        while (node && node->length < length)
+        {
+            if (!matches(node->key, key, node->length))
+            {
+                return nullptr;
+            }
+            node = node->child[bit(key, node->length)].get();
+        }
+        if (!node || !matches(node->key, key, length))
+        {
+            return nullptr;
+        }
+        return node;
+    }
+
+    template <typename F>
+    static void visit(const Node *node, F &f)
+    {
+        if (node->valued)
+        {
+            f(node->value);
+        }
+        for (auto &child : node->child)
+        {
+            if (child)
+            {
+                visit(child.get(), f);
+            }
+        }
+    }
+
+    bool insert(const swss::IpAddress &address, uint8_t length, const T &value)
+    {
+        Key key = makeKey(address);
+        std::unique_ptr<Node> *slot = &root(address.isV4());
+
+        while (*slot)
+        {
+            Node *node = slot->get();
+            uint8_t common = commonLength(node->key, key, std::min(node->length, length));
+
+            if (common == node->length && common == length)
+            {
+                bool added = !node->valued;
+                node->valued = true;
+                node->value = value;
+                m_size += added;
+                return added;
+            }
+            if (common == node->length)
+            {
+                slot = &node->child[bit(key, common)];
+                continue;
+            }
+
+            /* The prefix branches off above the node, or is one of its parents */
+            std::unique_ptr<Node> rest = std::move(*slot);
+            slot->reset(new Node(key, common));
+            (*slot)->child[bit(rest->key, common)] = std::move(rest);
+            if (common != length)
+            {
+                slot = &(*slot)->child[bit(key, common)];
+                slot->reset(new Node(key, length));
+            }
+            break;
+        }
+
+        if (!*slot)
+        {
+            slot->reset(new Node(key, length));
+        }
+        (*slot)->valued = true;
+        (*slot)->value = value;
+        m_size++;
+        return true;
+    }
+
+    bool erase(const swss::IpAddress &address, uint8_t length)
+    {
+        Key key = makeKey(address);
+        std::unique_ptr<Node> *parent = nullptr;
+        std::unique_ptr<Node> *slot = &root(address.isV4());
+
+        while (*slot && (*slot)->length < length)
+        {
+            if (!matches((*slot)->key, key, (*slot)->length))
+            {
+                return false;
+            }
+            parent = slot;
+            slot = &(*slot)->child[bit(key, (*slot)->length)];
+        }
+        if (!*slot || (*slot)->length != length || !(*slot)->valued ||
+            !matches((*slot)->key, key, length))
+        {
+            return false;
+        }
+
+        (*slot)->valued = false;
+        (*slot)->value = T();
+        m_size--;
+
+        prune(*slot);
+        if (parent && !*slot)
+        {
+            prune(*parent);
+        }
+        return true;
+    }
+
+    /* Replaces a node without value by its child, unless it has two */
+    static void prune(std::unique_ptr<Node> &slot)
+    {
+        if (slot->valued || (slot->child[0] && slot->child[1]))
+        {
+            return;
+        }
+        std::unique_ptr<Node> child = std::move(slot->child[slot->child[0] ? 0 : 1]);
+        slot = std::move(child);
+    }
+};
+
+#endif /* SWSS_PREFIXTRIE_H */
@@ -0,0 +1,177 @@
+#include <string.h>
+#include <errno.h>
+
+#include "logger.h"
+#include "timestamp.h"
+#include "recorder.h"
+
+using namespace std;
+using namespace swss;
+
+Recorder::Recorder(ofstream &ofs, const string &file, ios_base::openmode reopenMode, size_t queueSize) :
+    m_ofs(ofs),
+    m_file(file),
+    m_reopenMode(reopenMode),
+    m_tail(0),
+    m_head(0),
+    m_dropped(0),
+    m_reopen(false)
+{
+    /* Round the ring up to a power of two */
+    size_t size = 1;
+    while (size < queueSize)
+    {
+        size <<= 1;
+    }
+
+    m_ring.reset(new string[size]);
+    m_mask = size - 1;
+}
+
+Recorder::~Recorder()
+{
+    stop();
+}
+
+void Recorder::start()
+{
+    m_stopping = false;
+    m_thread = thread(&Recorder::run, this);
+}
+
+void Recorder::stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+void Recorder::record(const string &s)
+{
+    if (!m_thread.joinable())
+    {
+        start();
+    }
+
+    size_t tail = m_tail.load(memory_order_relaxed);
+    size_t pending = tail - m_head.load(memory_order_acquire);
+
+    if (pending > m_mask)
+    {
+        m_dropped.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+
+    string &slot = m_ring[tail & m_mask];
+    slot = getTimestamp();
+    slot += "|";
+    slot += s;
+    m_tail.store(tail + 1, memory_order_release);
+
+    /* Wake up the writer early when the ring fills up */
+    if (pending == m_mask / 2)
+    {
+        m_cv.notify_one();
+    }
+}
+
+void Recorder::reopen()
+{
+    m_reopen.store(true, memory_order_relaxed);
+
+    if (!m_thread.joinable())
+    {
+        start();
+    }
+    m_cv.notify_one();
+}
+
+bool Recorder::drain(string &buffer)
+{
+    size_t head = m_head.load(memory_order_relaxed);
+    size_t tail = m_tail.load(memory_order_acquire);
+
+    if (head == tail)
+    {
+        return false;
+    }
+
+    buffer.clear();
+    for (; head != tail; head++)
+    {
+        string &slot = m_ring[head & m_mask];
+        buffer += slot;
+        buffer += '\n';
+        slot.clear();
+    }
+    m_head.store(head, memory_order_release);
+
+    m_ofs.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+
+    return true;
+}
+
+void Recorder::run()
+{
+    string buffer;
+
+    while (true)
+    {
+        bool stopping;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_cv.wait_for(lock, chrono::milliseconds(RECORDER_FLUSH_INTERVAL_MSECS));
+            stopping = m_stopping;
+        }
+
+        bool written = drain(buffer);
+
+        uint64_t dropped = m_dropped.load(memory_order_relaxed);
+        if (dropped != m_reportedDropped)
+        {
+            m_ofs << getTimestamp() << "|recorder dropped " << dropped - m_reportedDropped << " records" << endl;
+            m_reportedDropped = dropped;
+            written = false;
+        }
+
+        if (written)
+        {
+            m_ofs.flush();
+        }
+
+        if (m_reopen.exchange(false, memory_order_relaxed))
+        {
+            m_ofs.close();
+
+            /*
+             * On log rotate we will use the same file name, we are assuming that
+             * logrotate daemon move filename to filename.1 and we will create new
+             * empty file here.
+             */
+            m_ofs.open(m_file, m_reopenMode);
+
+            if (!m_ofs.is_open())
+            {
+                SWSS_LOG_ERROR("failed to reopen record file %s: %s", m_file.c_str(), strerror(errno));
+            }
+        }
+
+        if (stopping)
+        {
+            /* Records queued between the wakeup and the drain above */
+            if (drain(buffer))
+            {
+                m_ofs.flush();
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef SWSS_RECORDER_H
+#define SWSS_RECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#define RECORDER_QUEUE_SIZE             (64 * 1024)
+#define RECORDER_FLUSH_INTERVAL_MSECS   100
+
+/*
+ * Recorder moves the writes of a record file off the calling thread.
+ *
+ * Records are pushed into a lock-free single producer single consumer ring
+ * and a writer thread appends them to the file in large buffered writes.
+ * When the ring is full the record is dropped and counted, the writer
+ * notes the number of dropped records in the file once it catches up.
+ *
+ * record() and reopen() must be called from a single thread. The file
+ * stream must not be touched by the caller while the writer thread runs,
+ * stop() flushes the pending records and joins the thread.
+ */
+class Recorder
+{
+public:
+    Recorder(std::ofstream &ofs, const std::string &file,
+             std::ios_base::openmode reopenMode = std::ofstream::out | std::ofstream::app,
+             size_t queueSize = RECORDER_QUEUE_SIZE);
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /* Queue a record, the timestamp is taken by the caller's clock */
+    void record(const std::string &s);
+
+    /* Reopen the file on the writer thread, used on log rotate */
+    void reopen();
+
+    void stop();
+
+    uint64_t getDroppedCount() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::ofstream &m_ofs;
+    const std::string &m_file;
+    std::ios_base::openmode m_reopenMode;
+
+    std::unique_ptr<std::string[]> m_ring;
+    size_t m_mask;
+
+    /* Written by the producer only */
+    alignas(64) std::atomic<size_t> m_tail;
+    /* Written by the writer thread only */
+    alignas(64) std::atomic<size_t> m_head;
+
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<bool> m_reopen;
+    uint64_t m_reportedDropped = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopping = false;
+
+    void start();
+    void run();
+    bool drain(std::string &buffer);
+};
+
+#endif /* SWSS_RECORDER_H */
@@ -5,7 +5,7 @@
 #include <string>
 #include <vector>
 
-#include "timestamp.h"
+#include "recorder.h"
 
 extern bool gResponsePublisherRecord;
 extern bool gResponsePublisherLogRotate;
@@ -35,6 +35,12 @@ std::string PrependedComponent(const ReturnCode &status)
     return kOrchagentComponent;
 }
 
+Recorder &ResponsePublisherRecorder()
+{
+    static Recorder recorder(gResponsePublisherRecordOfs, gResponsePublisherRecordFile, std::ofstream::out);
+    return recorder;
+}
+
 void PerformLogRotate()
 {
     if (!gResponsePublisherLogRotate)
@@ -43,13 +49,8 @@ void PerformLogRotate()
     }
     gResponsePublisherLogRotate = false;
 
-    gResponsePublisherRecordOfs.close();
-    gResponsePublisherRecordOfs.open(gResponsePublisherRecordFile);
-    if (!gResponsePublisherRecordOfs.is_open())
-    {
-        SWSS_LOG_ERROR("Failed to reopen Response Publisher record file %s: %s", gResponsePublisherRecordFile.c_str(),
-                       strerror(errno));
-    }
+    // The record file is reopened by the recorder thread.
+    ResponsePublisherRecorder().reopen();
 }
 
 void RecordDBWrite(const std::string &table, const std::string &key, const std::vector<swss::FieldValueTuple> &attrs,
@@ -67,7 +68,7 @@ void RecordDBWrite(const std::string &table, const std::string &key, const std::
     }
 
     PerformLogRotate();
-    gResponsePublisherRecordOfs << swss::getTimestamp() << "|" << s << std::endl;
+    ResponsePublisherRecorder().record(s);
 }
 
 void RecordResponse(const std::string &response_channel, const std::string &key,
@@ -85,7 +86,7 @@ void RecordResponse(const std::string &response_channel, const std::string &key,
     }
 
     PerformLogRotate();
-    gResponsePublisherRecordOfs << swss::getTimestamp() << "|" << s << std::endl;
+    ResponsePublisherRecorder().record(s);
 }
 
 } // namespace
@@ -9,6 +9,7 @@
 #include "swssnet.h"
 #include "crmorch.h"
 #include "directory.h"
+#include "muxorch.h"
 
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
@@ -26,10 +27,20 @@ extern CbfNhgOrch *gCbfNhgOrch;
 extern FlowCounterRouteOrch *gFlowCounterRouteOrch;
 
 extern size_t gMaxBulkSize;
+extern uint32_t gParseThreads;
+extern bool gNhgInPlaceUpdate;
+extern bool gRoutePic;
 
 /* Default maximum number of next hop groups */
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
+/* Fewer pending routes are parsed inline by doTask() */
+#define ROUTE_PARSE_MIN_ENTRIES         64
+/* Routes examined by one slice of the resync sweep, and the slice period */
+#define ROUTE_SWEEP_SCAN_SIZE           16384
+#define ROUTE_SWEEP_INTERVAL_MSEC       10
+/* Passes over the routes before the sweep gives up on the failed removals */
+#define ROUTE_SWEEP_MAX_PASSES          3
 
 RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames, SwitchOrch *switchOrch, NeighOrch *neighOrch, IntfsOrch *intfsOrch, VRFOrch *vrfOrch, FgNhgOrch *fgNhgOrch, Srv6Orch *srv6Orch) :
         gRouteBulker(sai_route_api, gMaxBulkSize),
@@ -43,7 +54,13 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
         m_fgNhgOrch(fgNhgOrch),
         m_nextHopGroupCount(0),
         m_srv6Orch(srv6Orch),
-        m_resync(false)
+        m_resync(false),
+        m_routeEpoch(0),
+        m_resyncSweep(false),
+        m_resyncSweepPasses(0),
+        m_resyncSweepFailed(0),
+        m_resyncSweepRemoved(0),
+        m_resyncSweepCursor({ SAI_NULL_OBJECT_ID, IpPrefix() })
 {
     SWSS_LOG_ENTER();
 
@@ -82,6 +99,19 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     SWSS_LOG_NOTICE("Maximum number of ECMP groups supported is %d", m_maxNextHopGroupCount);
 
+    m_neighOrch->getDependencySubject().attach(&m_dependencyObserver);
+    m_intfsOrch->getDependencySubject().attach(&m_dependencyObserver);
+
+    if (gParseThreads > 0)
+    {
+        m_parsePool = unique_ptr<ParsePool>(new ParsePool(gParseThreads));
+        SWSS_LOG_NOTICE("Pre-parse routes with %u threads", gParseThreads);
+    }
+
+    auto interv = timespec { .tv_sec = 0, .tv_nsec = ROUTE_SWEEP_INTERVAL_MSEC * 1000000 };
+    m_resyncSweepTimer = new SelectableTimer(interv);
+    Orch::addExecutor(new ExecutableTimer(m_resyncSweepTimer, this, "ROUTE_RESYNC_SWEEP"));
+
     m_stateDb = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
     m_stateDefaultRouteTb = unique_ptr<swss::Table>(new Table(m_stateDb.get(), STATE_ROUTE_TABLE_NAME));
 
@@ -108,6 +138,7 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     /* Add default IPv4 route into the m_syncdRoutes */
     m_syncdRoutes[gVirtualRouterId][default_ip_prefix] = RouteNhg();
+    m_routeTries[gVirtualRouterId].insert(default_ip_prefix, m_syncdRoutes[gVirtualRouterId].find(default_ip_prefix));
 
     SWSS_LOG_NOTICE("Create IPv4 default route with packet action drop");
 
@@ -128,6 +159,7 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     /* Add default IPv6 route into the m_syncdRoutes */
     m_syncdRoutes[gVirtualRouterId][v6_default_ip_prefix] = RouteNhg();
+    m_routeTries[gVirtualRouterId].insert(v6_default_ip_prefix, m_syncdRoutes[gVirtualRouterId].find(v6_default_ip_prefix));
 
     SWSS_LOG_NOTICE("Create IPv6 default route with packet action drop");
 
@@ -273,22 +305,18 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr, sai_object_
      * IP address */
     if (observerEntry == m_nextHopObservers.end())
     {
-        m_nextHopObservers.emplace(host, NextHopObserverEntry());
-        observerEntry = m_nextHopObservers.find(host);
+        observerEntry = m_nextHopObservers.emplace(host, NextHopObserverEntry()).first;
+        m_nextHopObserverTries[vrf_id].insert(dstAddr, observerEntry);
 
         /* Find the prefixes that cover the destination IP */
-        if (m_syncdRoutes.find(vrf_id) != m_syncdRoutes.end())
+        auto it_trie = m_routeTries.find(vrf_id);
+        if (it_trie != m_routeTries.end())
         {
-            for (auto route : m_syncdRoutes.at(vrf_id))
-            {
-                if (route.first.isAddressInSubnet(dstAddr))
-                {
-                    SWSS_LOG_INFO("Prefix %s covers destination address",
-                            route.first.to_string().c_str());
-                    observerEntry->second.routeTable.emplace(
-                            route.first, route.second);
-                }
-            }
+            it_trie->second.forEachCovering(dstAddr, [&](const RouteTable::iterator &route) {
+                SWSS_LOG_INFO("Prefix %s covers destination address",
+                        route->first.to_string().c_str());
+                observerEntry->second.routeTable.emplace(route->first, route->second);
+            });
         }
     }
 
@@ -337,6 +365,16 @@ void RouteOrch::detach(Observer *observer, const IpAddress& dstAddr, sai_object_
             if (observerEntry->second.observers.empty())
             {
                 m_nextHopObservers.erase(observerEntry);
+
+                auto it_trie = m_nextHopObserverTries.find(vrf_id);
+                if (it_trie != m_nextHopObserverTries.end())
+                {
+                    it_trie->second.erase(dstAddr);
+                    if (it_trie->second.empty())
+                    {
+                        m_nextHopObserverTries.erase(it_trie);
+                    }
+                }
             }
             break;
         }
@@ -459,6 +497,220 @@ bool RouteOrch::invalidnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t
     return true;
 }
 
+/*
+ * Turns the strings of an APP_ROUTE_TABLE entry into typed values. It only
+ * depends on the entry, so it may run on a parse pool thread: no Orch state
+ * is read and nothing is logged, doTask() checks and logs the result.
+ */
+void RouteOrch::parseRoute(const KeyOpFieldsValuesTuple &t, ParsedRoute &route)
+{
+    const string &key = kfvKey(t);
+
+    size_t found = string::npos;
+    if (!key.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+    {
+        found = key.find(':');
+        route.vrf_name = key.substr(0, found);
+    }
+
+    try
+    {
+        route.ip_prefix = IpPrefix(route.vrf_name.empty() ? key : key.substr(found + 1));
+        route.prefix_parsed = true;
+    }
+    catch (const std::exception &e)
+    {
+        return;
+    }
+
+    if (kfvOp(t) != SET_COMMAND)
+    {
+        return;
+    }
+
+    string ips;
+    string aliases;
+    string mpls_nhs;
+    string vni_labels;
+    string remote_macs;
+    string srv6_segments;
+    string srv6_source;
+
+    for (const auto &i : kfvFieldsValues(t))
+    {
+        if (fvField(i) == "nexthop")
+            ips = fvValue(i);
+
+        if (fvField(i) == "ifname")
+            aliases = fvValue(i);
+
+        if (fvField(i) == "mpls_nh")
+            mpls_nhs = fvValue(i);
+
+        if (fvField(i) == "vni_label") {
+            vni_labels = fvValue(i);
+            route.overlay_nh = true;
+        }
+
+        if (fvField(i) == "router_mac")
+            remote_macs = fvValue(i);
+
+        if (fvField(i) == "blackhole")
+            route.blackhole = fvValue(i) == "true";
+
+        if (fvField(i) == "weight")
+            route.weights = fvValue(i);
+
+        if (fvField(i) == "nexthop_group")
+            route.nhg_index = fvValue(i);
+
+        if (fvField(i) == "segment") {
+            srv6_segments = fvValue(i);
+            route.srv6_nh = true;
+        }
+
+        if (fvField(i) == "seg_src")
+            srv6_source = fvValue(i);
+    }
+
+    route.ipv = tokenize(ips, ',');
+    route.alsv = tokenize(aliases, ',');
+    route.ipv_size = route.ipv.size();
+
+    if (!route.nhg_index.empty())
+    {
+        return;
+    }
+
+    route.mpls_nhv = tokenize(mpls_nhs, ',');
+    route.vni_labelv = tokenize(vni_labels, ',');
+    route.rmacv = tokenize(remote_macs, ',');
+    route.srv6_segv = tokenize(srv6_segments, ',');
+    route.srv6_src = tokenize(srv6_source, ',');
+
+    auto &ipv = route.ipv;
+    auto &alsv = route.alsv;
+
+    if (alsv.size() == 0 && !route.blackhole && !route.srv6_nh)
+    {
+        return;
+    }
+    ipv.resize(alsv.size());
+
+    for (auto &ip : ipv)
+    {
+        if (ip.empty())
+        {
+            route.empty_ips++;
+            ip = route.ip_prefix.isV4() ? "0.0.0.0" : "::";
+        }
+    }
+
+    for (const auto &alias : alsv)
+    {
+        if (alias == "eth0" || alias == "docker0" ||
+            alias == "lo" || !alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX))
+        {
+            route.excp_intfs = true;
+            return;
+        }
+    }
+
+    /*
+     * Blackhole and SRv6 next hops are cheap or rare, leave them to doTask().
+     * Plain next hops are parsed as long as none needs a lookup of IntfsOrch
+     * (tun0, VRF or empty interface) and the MPLS labels match the next hops.
+     */
+    if (route.blackhole || route.srv6_nh)
+    {
+        return;
+    }
+
+    string nhg_str;
+    if (!route.overlay_nh)
+    {
+        if (!route.mpls_nhv.empty() && route.mpls_nhv.size() < ipv.size())
+        {
+            return;
+        }
+
+        for (uint32_t i = 0; i < ipv.size(); i++)
+        {
+            if (alsv[i].empty() || alsv[i] == "tun0" ||
+                !alsv[i].compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+            {
+                return;
+            }
+            if (i) nhg_str += NHG_DELIMITER;
+            if (!route.mpls_nhv.empty() && route.mpls_nhv[i] != "na")
+            {
+                nhg_str += route.mpls_nhv[i] + LABELSTACK_DELIMITER;
+            }
+            nhg_str += ipv[i] + NH_DELIMITER + alsv[i];
+        }
+    }
+    else
+    {
+        if (route.vni_labelv.size() < ipv.size() || route.rmacv.size() < ipv.size())
+        {
+            return;
+        }
+
+        for (uint32_t i = 0; i < ipv.size(); i++)
+        {
+            if (i) nhg_str += NHG_DELIMITER;
+            nhg_str += ipv[i] + NH_DELIMITER + "vni" + alsv[i] + NH_DELIMITER + route.vni_labelv[i] + NH_DELIMITER + route.rmacv[i];
+        }
+    }
+
+    try
+    {
+        if (!route.overlay_nh)
+        {
+            route.nhg = NextHopGroupKey(nhg_str, route.weights);
+        }
+        else
+        {
+            route.nhg = NextHopGroupKey(nhg_str, route.overlay_nh, route.srv6_nh);
+        }
+        route.nhg_parsed = true;
+    }
+    catch (const std::exception &e)
+    {
+        /* doTask() builds the key again and handles the error */
+    }
+}
+
+/*
+ * Parses the pending APP_ROUTE_TABLE entries of the consumer on the parse
+ * pool, indexed by entry. The entries are still processed in the order of
+ * m_toSync by doTask().
+ */
+void RouteOrch::parseRoutes(Consumer& consumer, vector<ParsedRoute>& routes,
+                            unordered_map<const KeyOpFieldsValuesTuple *, ParsedRoute *>& parsed)
+{
+    SWSS_LOG_ENTER();
+
+    vector<const KeyOpFieldsValuesTuple *> entries;
+    entries.reserve(consumer.m_toSync.size());
+    for (const auto &entry : consumer.m_toSync)
+    {
+        if (kfvKey(entry.second) != "resync")
+        {
+            entries.push_back(&entry.second);
+        }
+    }
+
+    routes.resize(entries.size());
+    m_parsePool->run(entries.size(), [&](size_t i) { parseRoute(*entries[i], routes[i]); });
+
+    parsed.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        parsed.emplace(entries[i], &routes[i]);
+    }
+}
+
 void RouteOrch::doTask(Consumer& consumer)
 {
     SWSS_LOG_ENTER();
@@ -477,7 +729,36 @@ void RouteOrch::doTask(Consumer& consumer)
     }
 
     /* Default handling is for APP_ROUTE_TABLE_NAME */
+    vector<ParsedRoute> routes;
+    unordered_map<const KeyOpFieldsValuesTuple *, ParsedRoute *> parsed;
+    if (m_parsePool && consumer.m_toSync.size() >= ROUTE_PARSE_MIN_ENTRIES)
+    {
+        parseRoutes(consumer, routes, parsed);
+    }
+
     auto it = consumer.m_toSync.begin();
+
+    /*
+     * Create the next hops queued by the routes and bring the routes parked on
+     * them back, so that they are programmed in the same flush. Done once, the
+     * routes are woken as well when their next hop fails to be created.
+     */
+    bool restored = false;
+    auto restoreWokenRoutes = [&]()
+    {
+        m_neighOrch->flushNextHops();
+        if (restored || !consumer.hasWokenTasks())
+        {
+            return false;
+        }
+        restored = true;
+
+        /* The restored entries are not pre-parsed, and may reuse the memory of erased ones */
+        parsed.clear();
+        it = consumer.restoreWokenTasks();
+        return it != consumer.m_toSync.end();
+    };
+
     while (it != consumer.m_toSync.end())
     {
         // Route bulk results will be stored in a map
@@ -489,8 +770,10 @@ void RouteOrch::doTask(Consumer& consumer)
                 RouteBulkContext
         >                                       toBulk;
 
+        m_bulkNhgInUse.clear();
+
         // Add or remove routes with a route bulker
-        while (it != consumer.m_toSync.end())
+        while (it != consumer.m_toSync.end() || restoreWokenRoutes())
         {
             KeyOpFieldsValuesTuple t = it->second;
 
@@ -510,133 +793,96 @@ void RouteOrch::doTask(Consumer& consumer)
 
             /* Get notification from application */
             /* resync application:
-             * When routeorch receives 'resync' message, it marks all current
-             * routes as dirty and waits for 'resync complete' message. For all
-             * newly received routes, if they match current dirty routes, it unmarks
-             * them dirty. After receiving 'resync complete' message, it creates all
-             * newly added routes and removes all dirty routes.
+             * When routeorch receives 'resync' message, it starts a new epoch
+             * and keeps processing routes, stamping each route it receives
+             * with that epoch. After receiving 'resync complete' message, the
+             * routes left with an older epoch are stale and are removed by
+             * the sweep timer, a slice at a time.
              */
             if (key == "resync")
             {
                 if (op == "SET")
                 {
-                    /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
                     SWSS_LOG_NOTICE("Start resync routes\n");
-                    for (auto j : m_syncdRoutes)
+                    m_resync = true;
+                    m_routeEpoch++;
+                    if (m_resyncSweep)
                     {
-                        string vrf;
-
-                        if (j.first != gVirtualRouterId)
-                        {
-                            vrf = m_vrfOrch->getVRFname(j.first) + ":";
-                        }
-
-                        for (auto i : j.second)
-                        {
-                            vector<FieldValueTuple> v;
-                            key = vrf + i.first.to_string();
-                            auto x = KeyOpFieldsValuesTuple(key, DEL_COMMAND, v);
-                            consumer.addToSync(x);
-                        }
+                        /* Routes left by the interrupted sweep are stale in the new epoch too */
+                        m_resyncSweep = false;
+                        m_resyncSweepTimer->stop();
                     }
-                    m_resync = true;
                 }
                 else
                 {
                     SWSS_LOG_NOTICE("Complete resync routes\n");
                     m_resync = false;
+                    m_resyncSweep = true;
+                    m_resyncSweepPasses = 0;
+                    m_resyncSweepFailed = 0;
+                    m_resyncSweepRemoved = 0;
+                    m_resyncSweepCursor = { SAI_NULL_OBJECT_ID, IpPrefix() };
+                    m_resyncSweepTimer->start();
                 }
 
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
 
-            if (m_resync)
+            ParsedRoute inline_route;
+            auto parsed_it = parsed.find(&it->second);
+            ParsedRoute& route = parsed_it != parsed.end() ? *parsed_it->second : inline_route;
+            if (parsed_it == parsed.end())
             {
-                it++;
-                continue;
+                parseRoute(t, route);
             }
 
             sai_object_id_t& vrf_id = ctx.vrf_id;
             IpPrefix& ip_prefix = ctx.ip_prefix;
 
-            if (!key.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+            if (!route.vrf_name.empty())
             {
-                size_t found = key.find(':');
-                string vrf_name = key.substr(0, found);
-
-                if (!m_vrfOrch->isVRFexists(vrf_name))
+                if (!m_vrfOrch->isVRFexists(route.vrf_name))
                 {
                     it++;
                     continue;
                 }
-                vrf_id = m_vrfOrch->getVRFid(vrf_name);
-                ip_prefix = IpPrefix(key.substr(found+1));
+                vrf_id = m_vrfOrch->getVRFid(route.vrf_name);
             }
             else
             {
                 vrf_id = gVirtualRouterId;
-                ip_prefix = IpPrefix(key);
             }
 
-            if (op == SET_COMMAND)
+            if (route.prefix_parsed)
             {
-                string ips;
-                string aliases;
-                string mpls_nhs;
-                string vni_labels;
-                string remote_macs;
-                string weights;
-                string nhg_index;
-                bool& excp_intfs_flag = ctx.excp_intfs_flag;
-                bool overlay_nh = false;
-                bool blackhole = false;
-                string srv6_segments;
-                string srv6_source;
-                bool srv6_nh = false;
+                ip_prefix = route.ip_prefix;
+            }
+            else
+            {
+                /* Let the invalid prefix be reported as before */
+                ip_prefix = IpPrefix(route.vrf_name.empty() ? key : key.substr(key.find(':') + 1));
+            }
 
-                for (auto i : kfvFieldsValues(t))
+            if (op == SET_COMMAND)
+            {
+                if (m_resync || m_resyncSweep)
                 {
-                    if (fvField(i) == "nexthop")
-                        ips = fvValue(i);
-
-                    if (fvField(i) == "ifname")
-                        aliases = fvValue(i);
-
-                    if (fvField(i) == "mpls_nh")
-                        mpls_nhs = fvValue(i);
-
-                    if (fvField(i) == "vni_label") {
-                        vni_labels = fvValue(i);
-                        overlay_nh = true;
-                    }
-
-                    if (fvField(i) == "router_mac")
-                        remote_macs = fvValue(i);
-
-                    if (fvField(i) == "blackhole")
-                        blackhole = fvValue(i) == "true";
-
-                    if (fvField(i) == "weight")
-                        weights = fvValue(i);
-
-                    if (fvField(i) == "nexthop_group")
-                        nhg_index = fvValue(i);
-
-                    if (fvField(i) == "segment") {
-                        srv6_segments = fvValue(i);
-                        srv6_nh = true;
-                    }
-
-                    if (fvField(i) == "seg_src")
-                        srv6_source = fvValue(i);
+                    refreshRoute(vrf_id, ip_prefix);
                 }
 
+                const string& weights = route.weights;
+                const string& nhg_index = route.nhg_index;
+                bool& excp_intfs_flag = ctx.excp_intfs_flag;
+                bool overlay_nh = route.overlay_nh;
+                bool blackhole = route.blackhole;
+                bool srv6_nh = route.srv6_nh;
+
                 /*
                  * A route should not fill both nexthop_group and ips /
                  * aliases.
                  */
-                if (!nhg_index.empty() && (!ips.empty() || !aliases.empty()))
+                if (!nhg_index.empty() && (!route.ipv.empty() || !route.alsv.empty()))
                 {
                     SWSS_LOG_ERROR("Route %s has both nexthop_group and ips/aliases", key.c_str());
                     it = consumer.m_toSync.erase(it);
@@ -650,32 +896,25 @@ void RouteOrch::doTask(Consumer& consumer)
                  * based on the IPs and aliases.  Otherwise, get the key from
                  * the NhgOrch.
                  */
-                vector<string> ipv;
-                vector<string> alsv;
-                vector<string> mpls_nhv;
-                vector<string> vni_labelv;
-                vector<string> rmacv;
+                vector<string>& ipv = route.ipv;
+                vector<string>& alsv = route.alsv;
+                vector<string>& mpls_nhv = route.mpls_nhv;
+                vector<string>& vni_labelv = route.vni_labelv;
+                vector<string>& rmacv = route.rmacv;
                 NextHopGroupKey& nhg = ctx.nhg;
-                vector<string> srv6_segv;
-                vector<string> srv6_src;
+                vector<string>& srv6_segv = route.srv6_segv;
+                vector<string>& srv6_src = route.srv6_src;
 
                 /* Check if the next hop group is owned by the NhgOrch. */
                 if (nhg_index.empty())
                 {
-                    ipv = tokenize(ips, ',');
-                    alsv = tokenize(aliases, ',');
-                    mpls_nhv = tokenize(mpls_nhs, ',');
-                    vni_labelv = tokenize(vni_labels, ',');
-                    rmacv = tokenize(remote_macs, ',');
-                    srv6_segv = tokenize(srv6_segments, ',');
-                    srv6_src = tokenize(srv6_source, ',');
-
                     /*
-                    * For backward compatibility, adjust ip string from old format to
-                    * new format. Meanwhile it can deal with some abnormal cases.
+                    * For backward compatibility, ip string from old format were
+                    * adjusted to new format by parseRoute(). Meanwhile it can deal
+                    * with some abnormal cases.
                     */
 
-                    /* Resize the ip vector to match ifname vector
+                    /* The ip vector was resized to match ifname vector
                     * as tokenize(",", ',') will miss the last empty segment. */
                     if (alsv.size() == 0 && !blackhole && !srv6_nh)
                     {
@@ -683,37 +922,24 @@ void RouteOrch::doTask(Consumer& consumer)
                         it = consumer.m_toSync.erase(it);
                         continue;
                     }
-                    else if (alsv.size() != ipv.size())
+                    else if (alsv.size() != route.ipv_size)
                     {
-                        SWSS_LOG_NOTICE("Route %s: resize ipv to match alsv, %zd -> %zd.", key.c_str(), ipv.size(), alsv.size());
-                        ipv.resize(alsv.size());
+                        SWSS_LOG_NOTICE("Route %s: resize ipv to match alsv, %zd -> %zd.", key.c_str(), route.ipv_size, alsv.size());
                     }
 
-                    /* Set the empty ip(s) to zero
+                    /* The empty ip(s) were set to zero
                      * as IpAddress("") will construct a incorrect ip. */
-                    for (auto &ip : ipv)
+                    for (size_t i = 0; i < route.empty_ips; i++)
                     {
-                        if (ip.empty())
-                        {
-                            SWSS_LOG_NOTICE("Route %s: set the empty nexthop ip to zero.", key.c_str());
-                            ip = ip_prefix.isV4() ? "0.0.0.0" : "::";
-                        }
+                        SWSS_LOG_NOTICE("Route %s: set the empty nexthop ip to zero.", key.c_str());
                     }
 
-                    for (auto alias : alsv)
-                    {
-                        /* skip route to management, docker, loopback
-                        * TODO: for route to loopback interface, the proper
-                        * way is to create loopback interface and then create
-                        * route pointing to it, so that we can traps packets to
-                        * CPU */
-                        if (alias == "eth0" || alias == "docker0" ||
-                            alias == "lo" || !alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX))
-                        {
-                            excp_intfs_flag = true;
-                            break;
-                        }
-                    }
+                    /* skip route to management, docker, loopback
+                    * TODO: for route to loopback interface, the proper
+                    * way is to create loopback interface and then create
+                    * route pointing to it, so that we can traps packets to
+                    * CPU */
+                    excp_intfs_flag = route.excp_intfs;
 
                     // TODO: cannot trust m_portsOrch->getPortIdByAlias because sometimes alias is empty
                     if (excp_intfs_flag)
@@ -729,7 +955,11 @@ void RouteOrch::doTask(Consumer& consumer)
 
                     string nhg_str = "";
 
-                    if (blackhole)
+                    if (route.nhg_parsed)
+                    {
+                        nhg = std::move(route.nhg);
+                    }
+                    else if (blackhole)
                     {
                         nhg = NextHopGroupKey();
                     }
@@ -838,6 +1068,8 @@ void RouteOrch::doTask(Consumer& consumer)
                     {
                         if (addRoute(ctx, nhg))
                             it = consumer.m_toSync.erase(it);
+                        else if (!ctx.dependencies.empty() && ctx.object_statuses.empty())
+                            it = consumer.park(it, ctx.dependencies);
                         else
                             it++;
                     }
@@ -855,6 +1087,9 @@ void RouteOrch::doTask(Consumer& consumer)
                 {
                     if (addRoute(ctx, nhg))
                         it = consumer.m_toSync.erase(it);
+                    /* Nothing is queued in the bulker, wait for the next hop or interface */
+                    else if (!ctx.dependencies.empty() && ctx.object_statuses.empty())
+                        it = consumer.park(it, ctx.dependencies);
                     else
                         it++;
                 }
@@ -886,6 +1121,12 @@ void RouteOrch::doTask(Consumer& consumer)
             }
         }
 
+        // Create the next hops queued by the routes when the loop stopped early
+        m_neighOrch->flushNextHops();
+
+        // Fill the shared next hop groups before the routes point to them
+        flushPicNextHops();
+
         // Flush the route bulker, so routes will be written to syncd and ASIC
         gRouteBulker.flush();
 
@@ -962,120 +1203,268 @@ void RouteOrch::doTask(Consumer& consumer)
         }
 
         /* Remove next hop group if the reference count decreases to zero */
-        for (auto& it_nhg : m_bulkNhgReducedRefCnt)
-        {
-            if (it_nhg.first.is_overlay_nexthop() && it_nhg.second != 0)
-            {
-                removeOverlayNextHops(it_nhg.second, it_nhg.first);
-            }
-            else if (it_nhg.first.is_srv6_nexthop())
-            {
-                if(it_nhg.first.getSize() > 1)
-                {
-                    if(m_syncdNextHopGroups[it_nhg.first].ref_count == 0)
-                    {
-                      removeNextHopGroup(it_nhg.first);
-                    }
-                    else
-                    {
-                      SWSS_LOG_ERROR("SRV6 ECMP %s REF count is not zero", it_nhg.first.to_string().c_str());
-                    }
-                }
-            }
-            else if (m_syncdNextHopGroups[it_nhg.first].ref_count == 0)
-            {
-                removeNextHopGroup(it_nhg.first);
-            }
-        }
+        removeReducedRefCntNextHopGroups();
     }
 }
 
-void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPrefix &prefix, const NextHopGroupKey &nexthops, bool add)
+void RouteOrch::removeReducedRefCntNextHopGroups()
 {
     SWSS_LOG_ENTER();
 
-    for (auto& entry : m_nextHopObservers)
+    for (auto& it_nhg : m_bulkNhgReducedRefCnt)
     {
-        if (vrf_id != entry.first.first || !prefix.isAddressInSubnet(entry.first.second))
+        if (it_nhg.first.is_overlay_nexthop() && it_nhg.second != 0)
         {
-            continue;
+            removeOverlayNextHops(it_nhg.second, it_nhg.first);
         }
-
-        if (add)
+        else if (it_nhg.first.is_srv6_nexthop())
         {
-            bool update_required = false;
-            NextHopUpdate update = { vrf_id, entry.first.second, prefix, nexthops };
-
-            /* Table should not be empty. Default route should always exists. */
-            assert(!entry.second.routeTable.empty());
-
-            auto route = entry.second.routeTable.find(prefix);
-            if (route == entry.second.routeTable.end())
-            {
-                /* If added route is best match update observers */
-                if (entry.second.routeTable.rbegin()->first < prefix)
-                {
-                    update_required = true;
-                }
-
-                entry.second.routeTable.emplace(prefix, RouteNhg(nexthops, ""));
-            }
-            else
+            if(it_nhg.first.getSize() > 1)
             {
-                if (route->second.nhg_key != nexthops)
+                if(m_syncdNextHopGroups[it_nhg.first].ref_count == 0)
                 {
-                    route->second.nhg_key = nexthops;
-                    /* If changed route is best match update observers */
-                    if (entry.second.routeTable.rbegin()->first == route->first)
-                    {
-                        update_required = true;
-                    }
+                  removeNextHopGroup(it_nhg.first);
                 }
-            }
-
-            if (update_required)
-            {
-                for (auto observer : entry.second.observers)
+                else
                 {
-                    observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
+                  SWSS_LOG_ERROR("SRV6 ECMP %s REF count is not zero", it_nhg.first.to_string().c_str());
                 }
             }
         }
-        else
+        else if (m_syncdNextHopGroups[it_nhg.first].ref_count == 0)
         {
-            auto route = entry.second.routeTable.find(prefix);
-            if (route != entry.second.routeTable.end())
-            {
-                /* If removed route was best match find another best match route */
-                if (route->first == entry.second.routeTable.rbegin()->first)
-                {
-                    entry.second.routeTable.erase(route);
-
-                    /* Table should not be empty. Default route should always exists. */
-                    assert(!entry.second.routeTable.empty());
-
-                    auto route = entry.second.routeTable.rbegin();
-                    NextHopUpdate update = { vrf_id, entry.first.second, route->first, route->second.nhg_key };
-
-                    for (auto observer : entry.second.observers)
-                    {
-                        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                    }
-                }
-                else
-                {
-                    entry.second.routeTable.erase(route);
-                }
-            }
+            removeNextHopGroup(it_nhg.first);
         }
     }
+
+    removeUnusedPicNextHops();
 }
 
-void RouteOrch::increaseNextHopRefCount(const NextHopGroupKey &nexthops)
+void RouteOrch::refreshRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix)
 {
-    /* Return when there is no next hop (dropped) */
-    if (nexthops.getSize() == 0)
-    {
+    auto it_route_table = m_syncdRoutes.find(vrf_id);
+    if (it_route_table == m_syncdRoutes.end())
+    {
+        return;
+    }
+
+    auto it_route = it_route_table->second.find(ip_prefix);
+    if (it_route != it_route_table->second.end())
+    {
+        it_route->second.epoch = m_routeEpoch;
+    }
+}
+
+void RouteOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_resyncSweep)
+    {
+        timer.stop();
+        return;
+    }
+
+    sweepStaleRoutes();
+}
+
+/*
+ * Removes one slice of the routes not refreshed in the current epoch, starting
+ * at the sweep cursor. The routes are walked in place, so nothing is copied
+ * and no key string is built for the routes that are kept.
+ */
+void RouteOrch::sweepStaleRoutes()
+{
+    SWSS_LOG_ENTER();
+
+    std::deque<RouteBulkContext> stale;
+    size_t scanned = 0;
+    bool done = true;
+
+    for (auto it_table = m_syncdRoutes.lower_bound(m_resyncSweepCursor.vrf_id);
+         done && it_table != m_syncdRoutes.end(); ++it_table)
+    {
+        auto& routes = it_table->second;
+        auto it_route = it_table->first == m_resyncSweepCursor.vrf_id ?
+            routes.lower_bound(m_resyncSweepCursor.prefix) : routes.begin();
+
+        for (; it_route != routes.end(); ++it_route)
+        {
+            if (scanned == ROUTE_SWEEP_SCAN_SIZE || stale.size() == gMaxBulkSize)
+            {
+                m_resyncSweepCursor = { it_table->first, it_route->first };
+                done = false;
+                break;
+            }
+
+            scanned++;
+            if (it_route->second.epoch == m_routeEpoch)
+            {
+                continue;
+            }
+
+            stale.emplace_back();
+            stale.back().vrf_id = it_table->first;
+            stale.back().ip_prefix = it_route->first;
+        }
+    }
+
+    for (auto& ctx : stale)
+    {
+        /* Nothing queued in the bulker and the route is still there */
+        if (!removeRoute(ctx) && ctx.object_statuses.empty())
+        {
+            SWSS_LOG_WARN("Failed to remove stale route %s, vrf_id 0x%" PRIx64,
+                          ctx.ip_prefix.to_string().c_str(), ctx.vrf_id);
+            m_resyncSweepFailed++;
+        }
+    }
+
+    gRouteBulker.flush();
+
+    m_bulkNhgReducedRefCnt.clear();
+    for (auto& ctx : stale)
+    {
+        if (ctx.object_statuses.empty())
+        {
+            continue;
+        }
+
+        if (removeRoutePost(ctx))
+        {
+            m_resyncSweepRemoved++;
+        }
+        else
+        {
+            m_resyncSweepFailed++;
+        }
+    }
+    removeReducedRefCntNextHopGroups();
+
+    if (!done)
+    {
+        return;
+    }
+
+    if (m_resyncSweepFailed && ++m_resyncSweepPasses < ROUTE_SWEEP_MAX_PASSES)
+    {
+        /* Go over the routes again for the removals that failed */
+        SWSS_LOG_INFO("Failed to remove %zu stale routes, sweep again", m_resyncSweepFailed);
+        m_resyncSweepFailed = 0;
+        m_resyncSweepCursor = { SAI_NULL_OBJECT_ID, IpPrefix() };
+        return;
+    }
+
+    if (m_resyncSweepFailed)
+    {
+        SWSS_LOG_ERROR("Failed to remove %zu stale routes after resync, giving up after %u passes",
+                       m_resyncSweepFailed, ROUTE_SWEEP_MAX_PASSES);
+    }
+    SWSS_LOG_NOTICE("Removed %zu stale routes after resync", m_resyncSweepRemoved);
+    m_resyncSweep = false;
+    m_resyncSweepTimer->stop();
+}
+
+void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPrefix &prefix, const NextHopGroupKey &nexthops, bool add)
+{
+    SWSS_LOG_ENTER();
+
+    auto it_trie = m_nextHopObserverTries.find(vrf_id);
+    if (it_trie == m_nextHopObserverTries.end())
+    {
+        return;
+    }
+
+    /* The observers may attach or detach from their update */
+    vector<Host> hosts;
+    it_trie->second.forEachWithin(prefix, [&hosts](const NextHopObserverTable::iterator &entry) {
+        hosts.push_back(entry->first);
+    });
+
+    for (auto& host : hosts)
+    {
+        auto it_entry = m_nextHopObservers.find(host);
+        if (it_entry == m_nextHopObservers.end())
+        {
+            continue;
+        }
+        auto& entry = *it_entry;
+
+        if (add)
+        {
+            bool update_required = false;
+            NextHopUpdate update = { vrf_id, entry.first.second, prefix, nexthops };
+
+            /* Table should not be empty. Default route should always exists. */
+            assert(!entry.second.routeTable.empty());
+
+            auto route = entry.second.routeTable.find(prefix);
+            if (route == entry.second.routeTable.end())
+            {
+                /* If added route is best match update observers */
+                if (entry.second.routeTable.rbegin()->first < prefix)
+                {
+                    update_required = true;
+                }
+
+                entry.second.routeTable.emplace(prefix, RouteNhg(nexthops, ""));
+            }
+            else
+            {
+                if (route->second.nhg_key != nexthops)
+                {
+                    route->second.nhg_key = nexthops;
+                    /* If changed route is best match update observers */
+                    if (entry.second.routeTable.rbegin()->first == route->first)
+                    {
+                        update_required = true;
+                    }
+                }
+            }
+
+            if (update_required)
+            {
+                for (auto observer : entry.second.observers)
+                {
+                    observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
+                }
+            }
+        }
+        else
+        {
+            auto route = entry.second.routeTable.find(prefix);
+            if (route != entry.second.routeTable.end())
+            {
+                /* If removed route was best match find another best match route */
+                if (route->first == entry.second.routeTable.rbegin()->first)
+                {
+                    entry.second.routeTable.erase(route);
+
+                    /* Table should not be empty. Default route should always exists. */
+                    assert(!entry.second.routeTable.empty());
+
+                    auto route = entry.second.routeTable.rbegin();
+                    NextHopUpdate update = { vrf_id, entry.first.second, route->first, route->second.nhg_key };
+
+                    for (auto observer : entry.second.observers)
+                    {
+                        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
+                    }
+                }
+                else
+                {
+                    entry.second.routeTable.erase(route);
+                }
+            }
+        }
+    }
+}
+
+void RouteOrch::increaseNextHopRefCount(const NextHopGroupKey &nexthops)
+{
+    /* Return when there is no next hop (dropped) */
+    if (nexthops.getSize() == 0)
+    {
         return;
     }
     else if (nexthops.getSize() == 1)
@@ -1138,6 +1527,25 @@ const NextHopGroupKey RouteOrch::getSyncdRouteNhgKey(sai_object_id_t vrf_id, con
     return nhg;
 }
 
+bool RouteOrch::getLongestMatchRoute(sai_object_id_t vrf_id, const IpAddress& address, IpPrefix& prefix, RouteNhg& route_nhg) const
+{
+    auto it_trie = m_routeTries.find(vrf_id);
+    if (it_trie == m_routeTries.end())
+    {
+        return false;
+    }
+
+    auto route = it_trie->second.longestMatch(address);
+    if (!route)
+    {
+        return false;
+    }
+
+    prefix = (*route)->first;
+    route_nhg = (*route)->second;
+    return true;
+}
+
 bool RouteOrch::createFineGrainedNextHopGroup(sai_object_id_t &next_hop_group_id, vector<sai_attribute_t> &nhg_attrs)
 {
     SWSS_LOG_ENTER();
@@ -1487,6 +1895,162 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
     return true;
 }
 
+/*
+ * Turns the next hop group of current into the one of nexthops by creating the
+ * members that are new and only then removing the members that are gone, so
+ * that traffic keeps flowing through the group. The group keeps its SAI object
+ * and is re-keyed in m_syncdNextHopGroups. Returns false, leaving the group as
+ * it was, when the new members cannot be created.
+ */
+bool RouteOrch::updateNextHopGroupInPlace(const NextHopGroupKey &current, const NextHopGroupKey &nexthops)
+{
+    SWSS_LOG_ENTER();
+
+    auto& next_hop_group_entry = m_syncdNextHopGroups.at(current);
+    sai_object_id_t next_hop_group_id = next_hop_group_entry.next_hop_group_id;
+
+    /* A next hop whose weight changes is replaced by a new member */
+    vector<NextHopKey> added;
+    vector<NextHopKey> removed;
+    for (const auto& nh : nexthops.getNextHops())
+    {
+        auto it = current.getNextHops().find(nh);
+        if (it == current.getNextHops().end() || it->weight != nh.weight)
+        {
+            added.push_back(nh);
+        }
+    }
+    for (const auto& nh : current.getNextHops())
+    {
+        auto it = nexthops.getNextHops().find(nh);
+        if (it == nexthops.getNextHops().end() || it->weight != nh.weight)
+        {
+            removed.push_back(nh);
+        }
+    }
+
+    /* Members are not created for next hops of down interfaces */
+    vector<NextHopKey> created;
+    for (const auto& nh : added)
+    {
+        if (!m_neighOrch->isNextHopFlagSet(nh, NHFLAGS_IFDOWN))
+        {
+            created.push_back(nh);
+        }
+    }
+
+    vector<sai_object_id_t> nhgm_ids(created.size());
+    for (size_t i = 0; i < created.size(); i++)
+    {
+        vector<sai_attribute_t> nhgm_attrs;
+
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        nhgm_attr.value.oid = next_hop_group_id;
+        nhgm_attrs.push_back(nhgm_attr);
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = m_neighOrch->getNextHopId(created[i]);
+        nhgm_attrs.push_back(nhgm_attr);
+
+        if (created[i].weight)
+        {
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
+            nhgm_attr.value.s32 = created[i].weight;
+            nhgm_attrs.push_back(nhgm_attr);
+        }
+
+        gNextHopGroupMemberBulker.create_entry(&nhgm_ids[i],
+                                               (uint32_t)nhgm_attrs.size(),
+                                               nhgm_attrs.data());
+    }
+    gNextHopGroupMemberBulker.flush();
+
+    if (find(nhgm_ids.begin(), nhgm_ids.end(), SAI_NULL_OBJECT_ID) != nhgm_ids.end())
+    {
+        SWSS_LOG_WARN("Failed to create the new members of next hop group %s, recreate it as %s",
+                      current.to_string().c_str(), nexthops.to_string().c_str());
+
+        vector<sai_status_t> statuses(nhgm_ids.size());
+        for (size_t i = 0; i < nhgm_ids.size(); i++)
+        {
+            if (nhgm_ids[i] != SAI_NULL_OBJECT_ID)
+            {
+                gNextHopGroupMemberBulker.remove_entry(&statuses[i], nhgm_ids[i]);
+            }
+        }
+        gNextHopGroupMemberBulker.flush();
+        return false;
+    }
+
+    vector<sai_object_id_t> next_hop_ids;
+    auto& nhgm = next_hop_group_entry.nhopgroup_members;
+    for (const auto& nh : removed)
+    {
+        auto it = nhgm.find(nh);
+        if (it == nhgm.end())
+        {
+            continue;
+        }
+        if (!m_neighOrch->isNextHopFlagSet(nh, NHFLAGS_IFDOWN))
+        {
+            next_hop_ids.push_back(it->second.next_hop_id);
+        }
+        nhgm.erase(it);
+    }
+
+    vector<sai_status_t> statuses(next_hop_ids.size());
+    for (size_t i = 0; i < next_hop_ids.size(); i++)
+    {
+        gNextHopGroupMemberBulker.remove_entry(&statuses[i], next_hop_ids[i]);
+    }
+    gNextHopGroupMemberBulker.flush();
+
+    for (size_t i = 0; i < created.size(); i++)
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        nhgm[created[i]].next_hop_id = nhgm_ids[i];
+        nhgm[created[i]].seq_id = 0;
+    }
+
+    for (size_t i = 0; i < next_hop_ids.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop group member[%zu] %" PRIx64 ", rv:%d",
+                           i, next_hop_ids[i], statuses[i]);
+            handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
+            continue;
+        }
+
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+    }
+
+    for (const auto& nh : added)
+    {
+        m_neighOrch->increaseNextHopRefCount(nh);
+    }
+    for (const auto& nh : removed)
+    {
+        m_neighOrch->decreaseNextHopRefCount(nh);
+        /* Remove any MPLS-specific NH that was created */
+        if (nh.isMplsNextHop() && m_neighOrch->getNextHopRefCount(nh) == 0)
+        {
+            m_neighOrch->removeMplsNextHop(nh);
+        }
+    }
+
+    SWSS_LOG_NOTICE("Update next hop group %s to %s in place, %zu members added, %zu removed",
+                    current.to_string().c_str(), nexthops.to_string().c_str(),
+                    created.size(), next_hop_ids.size());
+
+    NextHopGroupEntry entry = std::move(next_hop_group_entry);
+    m_syncdNextHopGroups.erase(current);
+    m_syncdNextHopGroups[nexthops] = std::move(entry);
+
+    return true;
+}
+
 void RouteOrch::addNextHopRoute(const NextHopKey& nextHop, const RouteKey& routeKey)
 {
     auto it = m_nextHops.find((nextHop));
@@ -1526,6 +2090,10 @@ void RouteOrch::removeNextHopRoute(const NextHopKey& nextHop, const RouteKey& ro
         if (it->second.empty())
         {
             m_nextHops.erase(nextHop);
+            if (m_picNextHops.find(nextHop) != m_picNextHops.end())
+            {
+                m_bulkPicUnused.insert(nextHop);
+            }
         }
     }
     else
@@ -1539,6 +2107,22 @@ bool RouteOrch::updateNextHopRoutes(const NextHopKey& nextHop, uint32_t& numRout
     numRoutes = 0;
     auto it = m_nextHops.find((nextHop));
 
+    /* The routes share a next hop group, only its member is replaced */
+    auto it_pic = m_picNextHops.find(nextHop);
+    if (it_pic != m_picNextHops.end())
+    {
+        if (!updatePicNextHop(nextHop, it_pic->second))
+        {
+            return false;
+        }
+
+        if (it != m_nextHops.end())
+        {
+            numRoutes = (uint32_t)it->second.size();
+        }
+        return true;
+    }
+
     if (it == m_nextHops.end())
     {
         SWSS_LOG_INFO("No routes found for NH %s", nextHop.ip_address.to_string().c_str());
@@ -1580,6 +2164,278 @@ bool RouteOrch::updateNextHopRoutes(const NextHopKey& nextHop, uint32_t& numRout
     return true;
 }
 
+sai_object_id_t RouteOrch::getPicNextHopGroupId(const NextHopKey& nextHop) const
+{
+    auto it_pic = m_picNextHops.find(nextHop);
+    if (it_pic == m_picNextHops.end())
+    {
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    return it_pic->second.next_hop_group_id;
+}
+
+/*
+ * Returns the id the single path routes of a MUX neighbor point to: the next
+ * hop group shared by these routes, created along the first of them. Only the
+ * next hops MuxOrch switches over through updateNextHopRoutes() get a group.
+ * The next hop id is returned when routes already point to the next hop
+ * itself, or when creating the group would take more than half of the next
+ * hop groups.
+ *
+ * SAI has no bulk creation of next hop groups, the group is created here and
+ * its member is queued in the member bulker, flushed by flushPicNextHops()
+ * before the routes.
+ *
+ * The group holds no reference on the next hop: the routes using it do, and
+ * it is removed in the same bulk as its last route. MuxOrch only gives back
+ * the references of the routes when it disables the neighbor.
+ */
+sai_object_id_t RouteOrch::addPicNextHop(const NextHopKey& nextHop, sai_object_id_t next_hop_id)
+{
+    SWSS_LOG_ENTER();
+
+    auto it_pic = m_picNextHops.find(nextHop);
+    if (it_pic != m_picNextHops.end())
+    {
+        return it_pic->second.next_hop_group_id;
+    }
+
+    if (m_nextHops.find(nextHop) != m_nextHops.end())
+    {
+        return next_hop_id;
+    }
+
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+    if (mux_orch == nullptr || mux_orch->getNexthopMuxName(nextHop).empty())
+    {
+        return next_hop_id;
+    }
+
+    /* Leave at least half of the next hop groups to the ECMP routes */
+    if (2 * (m_nextHopGroupCount + NhgOrch::getSyncedNhgCount()) >= m_maxNextHopGroupCount)
+    {
+        SWSS_LOG_INFO("Not enough next hop groups to share next hop %s",
+                      nextHop.to_string().c_str());
+        return next_hop_id;
+    }
+
+    sai_attribute_t nhg_attr;
+    nhg_attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+    nhg_attr.value.s32 = SAI_NEXT_HOP_GROUP_TYPE_ECMP;
+
+    sai_object_id_t next_hop_group_id;
+    sai_status_t status = sai_next_hop_group_api->create_next_hop_group(&next_hop_group_id,
+                                                                        gSwitchId, 1, &nhg_attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create next hop group for next hop %s, rv:%d",
+                       nextHop.to_string().c_str(), status);
+        return next_hop_id;
+    }
+
+    SWSS_LOG_INFO("Create shared next hop group for next hop %s", nextHop.to_string().c_str());
+
+    m_nextHopGroupCount++;
+    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+
+    auto& pic = m_picNextHops[nextHop];
+    pic = { next_hop_group_id, SAI_NULL_OBJECT_ID, next_hop_id };
+
+    vector<sai_attribute_t> nhgm_attrs(2);
+    nhgm_attrs[0].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+    nhgm_attrs[0].value.oid = next_hop_group_id;
+    nhgm_attrs[1].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+    nhgm_attrs[1].value.oid = next_hop_id;
+
+    /* The entries of m_picNextHops do not move, the member id is set by the flush */
+    gNextHopGroupMemberBulker.create_entry(&pic.member_id,
+                                           (uint32_t)nhgm_attrs.size(),
+                                           nhgm_attrs.data());
+    m_bulkPicMembers.push_back(nextHop);
+
+    /* Released at the end of the bulk unless a route is added with it */
+    m_bulkPicUnused.insert(nextHop);
+
+    return next_hop_group_id;
+}
+
+/*
+ * Creates the members of the shared next hop groups added by the bulk. A
+ * member that failed is created again on its own, and otherwise by the next
+ * update of the next hop.
+ */
+void RouteOrch::flushPicNextHops()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_bulkPicMembers.empty())
+    {
+        return;
+    }
+
+    gNextHopGroupMemberBulker.flush();
+
+    for (const auto& nextHop : m_bulkPicMembers)
+    {
+        auto it_pic = m_picNextHops.find(nextHop);
+        if (it_pic == m_picNextHops.end())
+        {
+            continue;
+        }
+
+        auto& pic = it_pic->second;
+        if (pic.member_id != SAI_NULL_OBJECT_ID)
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+            continue;
+        }
+
+        SWSS_LOG_ERROR("Failed to create next hop group member for next hop %s",
+                       nextHop.to_string().c_str());
+        pic.next_hop_id = SAI_NULL_OBJECT_ID;
+        updatePicNextHop(nextHop, pic);
+    }
+
+    m_bulkPicMembers.clear();
+}
+
+/*
+ * Points the shared next hop group to the current id of the next hop. A SAI
+ * member cannot change its next hop, so the new member is added before the
+ * old one is removed and the group never drops the traffic.
+ */
+bool RouteOrch::updatePicNextHop(const NextHopKey& nextHop, PicNextHopEntry& pic)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t next_hop_id = m_neighOrch->getNextHopId(nextHop);
+    if (next_hop_id == pic.next_hop_id)
+    {
+        return true;
+    }
+
+    SWSS_LOG_INFO("Update shared next hop group for next hop %s", nextHop.to_string().c_str());
+
+    vector<sai_attribute_t> nhgm_attrs(2);
+    nhgm_attrs[0].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+    nhgm_attrs[0].value.oid = pic.next_hop_group_id;
+    nhgm_attrs[1].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+    nhgm_attrs[1].value.oid = next_hop_id;
+
+    sai_object_id_t member_id;
+    sai_status_t status = sai_next_hop_group_api->create_next_hop_group_member(&member_id, gSwitchId,
+                                                                               (uint32_t)nhgm_attrs.size(),
+                                                                               nhgm_attrs.data());
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create next hop group member for next hop %s, rv:%d",
+                       nextHop.to_string().c_str(), status);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+        return false;
+    }
+
+    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+
+    sai_object_id_t old_member_id = pic.member_id;
+    pic.member_id = member_id;
+    pic.next_hop_id = next_hop_id;
+
+    /* The member of the group failed to be created */
+    if (old_member_id == SAI_NULL_OBJECT_ID)
+    {
+        return true;
+    }
+
+    status = sai_next_hop_group_api->remove_next_hop_group_member(old_member_id);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to remove next hop group member %" PRIx64 " for next hop %s, rv:%d",
+                       old_member_id, nextHop.to_string().c_str(), status);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+
+    return true;
+}
+
+bool RouteOrch::removePicNextHop(const NextHopKey& nextHop)
+{
+    SWSS_LOG_ENTER();
+
+    auto it_pic = m_picNextHops.find(nextHop);
+    if (it_pic == m_picNextHops.end())
+    {
+        return true;
+    }
+
+    SWSS_LOG_INFO("Remove shared next hop group for next hop %s", nextHop.to_string().c_str());
+
+    sai_status_t status;
+    if (it_pic->second.member_id != SAI_NULL_OBJECT_ID)
+    {
+        status = sai_next_hop_group_api->remove_next_hop_group_member(it_pic->second.member_id);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop group member %" PRIx64 " for next hop %s, rv:%d",
+                           it_pic->second.member_id, nextHop.to_string().c_str(), status);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+
+        it_pic->second.member_id = SAI_NULL_OBJECT_ID;
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+    }
+
+    status = sai_next_hop_group_api->remove_next_hop_group(it_pic->second.next_hop_group_id);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to remove next hop group %" PRIx64 " for next hop %s, rv:%d",
+                       it_pic->second.next_hop_group_id, nextHop.to_string().c_str(), status);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    m_nextHopGroupCount--;
+    gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+
+    m_picNextHops.erase(it_pic);
+
+    return true;
+}
+
+/* Removes the shared next hop groups no route points to after the bulk */
+void RouteOrch::removeUnusedPicNextHops()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto it = m_bulkPicUnused.begin(); it != m_bulkPicUnused.end();)
+    {
+        if (m_nextHops.find(*it) == m_nextHops.end() && !removePicNextHop(*it))
+        {
+            it++;
+            continue;
+        }
+
+        it = m_bulkPicUnused.erase(it);
+    }
+}
+
 void RouteOrch::addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
 {
     SWSS_LOG_ENTER();
@@ -1621,6 +2477,95 @@ void RouteOrch::addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextH
     addRoute(ctx, tmp_next_hop);
 }
 
+/*
+ * The members of the next hop group of a route can be changed in place when
+ * the route is the only user of the group, including the routes of the current
+ * bulk, and when the new members can be created right away.
+ */
+bool RouteOrch::canUpdateNextHopGroupInPlace(const RouteBulkContext& ctx, const RouteNhg& route_nhg, const NextHopGroupKey& nextHops)
+{
+    if (!gNhgInPlaceUpdate || m_switchOrch->checkOrderedEcmpEnable())
+    {
+        return false;
+    }
+
+    const NextHopGroupKey& current = route_nhg.nhg_key;
+    if (!route_nhg.nhg_index.empty() || !ctx.nhg_index.empty() || current.getSize() <= 1 ||
+        current.is_overlay_nexthop() || current.is_srv6_nexthop() ||
+        nextHops.is_overlay_nexthop() || nextHops.is_srv6_nexthop())
+    {
+        return false;
+    }
+
+    if (m_fgNhgOrch->syncdContainsFgNhg(ctx.vrf_id, ctx.ip_prefix))
+    {
+        return false;
+    }
+
+    auto it_nhg = m_syncdNextHopGroups.find(current);
+    if (it_nhg == m_syncdNextHopGroups.end() || it_nhg->second.ref_count != 1 ||
+        m_bulkNhgInUse.find(current) != m_bulkNhgInUse.end())
+    {
+        return false;
+    }
+
+    sai_route_entry_t route_entry;
+    route_entry.vr_id = ctx.vrf_id;
+    route_entry.switch_id = gSwitchId;
+    copy(route_entry.destination, ctx.ip_prefix);
+    if (gRouteBulker.bulk_entry_pending_removal(route_entry))
+    {
+        return false;
+    }
+
+    for (const auto& nh : nextHops.getNextHops())
+    {
+        if (!m_neighOrch->hasNextHop(nh))
+        {
+            return false;
+        }
+    }
+
+    /*
+     * addNextHopGroup() keeps the members of next hops sharing a next hop id
+     * together, the group is recreated when such a next hop is added or removed
+     */
+    map<sai_object_id_t, uint32_t> current_ids;
+    map<sai_object_id_t, uint32_t> new_ids;
+    for (const auto& nh : current.getNextHops())
+    {
+        if (m_neighOrch->hasNextHop(nh))
+        {
+            current_ids[m_neighOrch->getNextHopId(nh)]++;
+        }
+    }
+    for (const auto& nh : nextHops.getNextHops())
+    {
+        new_ids[m_neighOrch->getNextHopId(nh)]++;
+    }
+
+    for (const auto& nh : nextHops.getNextHops())
+    {
+        auto it = current.getNextHops().find(nh);
+        if ((it == current.getNextHops().end() || it->weight != nh.weight) &&
+            new_ids[m_neighOrch->getNextHopId(nh)] > 1)
+        {
+            return false;
+        }
+    }
+    for (const auto& nh : current.getNextHops())
+    {
+        auto it = nextHops.getNextHops().find(nh);
+        if ((it == nextHops.getNextHops().end() || it->weight != nh.weight) &&
+            m_neighOrch->hasNextHop(nh) && current_ids[m_neighOrch->getNextHopId(nh)] > 1)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
 {
     SWSS_LOG_ENTER();
@@ -1710,6 +2655,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
             {
                 SWSS_LOG_INFO("Failed to get next hop %s for %s",
                         nextHops.to_string().c_str(), ipPrefix.to_string().c_str());
+                ctx.dependencies.push_back(nexthop.alias);
                 return false;
             }
         }
@@ -1718,14 +2664,22 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
             if (m_neighOrch->hasNextHop(nexthop))
             {
                 next_hop_id = m_neighOrch->getNextHopId(nexthop);
+                if (gRoutePic && !overlay_nh && !srv6_nh && !nexthop.isMplsNextHop())
+                {
+                    next_hop_id = addPicNextHop(nexthop, next_hop_id);
+                }
             }
             /* For non-existent MPLS NH, check if IP neighbor NH exists */
             else if (nexthop.isMplsNextHop() &&
                      m_neighOrch->isNeighborResolved(nexthop))
             {
-                /* since IP neighbor NH exists, neighbor is resolved, add MPLS NH */
-                m_neighOrch->addNextHop(nexthop);
-                next_hop_id = m_neighOrch->getNextHopId(nexthop);
+                /* since IP neighbor NH exists, neighbor is resolved, add MPLS NH
+                 * with the next hop bulker, the route waits until it is created */
+                if (m_neighOrch->queueNextHop(nexthop))
+                {
+                    ctx.dependencies.push_back(nexthop.to_string());
+                }
+                return false;
             }
             /* IP neighbor is not yet resolved */
             else
@@ -1760,6 +2714,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
                     SWSS_LOG_INFO("Failed to get next hop %s for %s, resolving neighbor",
                             nextHops.to_string().c_str(), ipPrefix.to_string().c_str());
                     m_neighOrch->resolveNeighbor(nexthop);
+                    ctx.dependencies.push_back(NextHopKey(nexthop.ip_address, nexthop.alias).to_string());
                     return false;
                 }
             }
@@ -1771,6 +2726,20 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
         /* Check if there is already an existing next hop group */
         if (!hasNextHopGroup(nextHops))
         {
+            /* Change the members of the group of the route if it is its only user,
+             * the route entry itself is left untouched */
+            if (it_route != m_syncdRoutes.at(vrf_id).end() &&
+                canUpdateNextHopGroupInPlace(ctx, it_route->second, nextHops) &&
+                updateNextHopGroupInPlace(it_route->second.nhg_key, nextHops))
+            {
+                it_route->second.nhg_key = nextHops;
+                it_route->second.epoch = m_routeEpoch;
+                m_bulkNhgInUse.insert(nextHops);
+
+                notifyNextHopChangeObservers(vrf_id, ipPrefix, nextHops, true);
+                return true;
+            }
+
             if(srv6_nh)
             {
                 sai_object_id_t temp_nh_id;
@@ -1781,6 +2750,24 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
                     return false;
                 }
             }
+            /* Queue the MPLS next hops of resolved neighbors in the next hop
+             * bulker, the route waits until they are created */
+            if (!overlay_nh && !srv6_nh)
+            {
+                for (const auto& nh : nextHops.getNextHops())
+                {
+                    if (nh.isMplsNextHop() && !m_neighOrch->hasNextHop(nh) &&
+                        m_neighOrch->isNeighborResolved(nh) && m_neighOrch->queueNextHop(nh))
+                    {
+                        ctx.dependencies.push_back(nh.to_string());
+                    }
+                }
+                if (!ctx.dependencies.empty())
+                {
+                    return false;
+                }
+            }
+
             /* Try to create a new next hop group */
             if (!addNextHopGroup(nextHops))
             {
@@ -1837,6 +2824,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
         }
 
         next_hop_id = m_syncdNextHopGroups[nextHops].next_hop_group_id;
+        m_bulkNhgInUse.insert(nextHops);
     }
 
     /* Sync the route entry */
@@ -2222,7 +3210,12 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         gFlowCounterRouteOrch->handleRouteAdd(vrf_id, ipPrefix);
     }
 
-    m_syncdRoutes[vrf_id][ipPrefix] = RouteNhg(nextHops, ctx.nhg_index);
+    auto it_syncd = m_syncdRoutes[vrf_id].emplace(ipPrefix, RouteNhg()).first;
+    m_routeTries[vrf_id].insert(ipPrefix, it_syncd);
+
+    auto& route_nhg = it_syncd->second;
+    route_nhg = RouteNhg(nextHops, ctx.nhg_index);
+    route_nhg.epoch = m_routeEpoch;
 
     notifyNextHopChangeObservers(vrf_id, ipPrefix, nextHops, true);
 
@@ -2423,6 +3416,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
     if (ipPrefix.isDefaultRoute() && vrf_id == gVirtualRouterId)
     {
         it_route_table->second[ipPrefix] = RouteNhg();
+        it_route_table->second[ipPrefix].epoch = m_routeEpoch;
 
         /* Notify about default route next hop change */
         notifyNextHopChangeObservers(vrf_id, ipPrefix, it_route_table->second[ipPrefix].nhg_key, true);
@@ -2431,6 +3425,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
     {
         gFlowCounterRouteOrch->handleRouteRemove(vrf_id, ipPrefix);
         it_route_table->second.erase(ipPrefix);
+        m_routeTries[vrf_id].erase(ipPrefix);
 
         /* Notify about the route next hop removal */
         notifyNextHopChangeObservers(vrf_id, ipPrefix, NextHopGroupKey(), false);
@@ -2438,6 +3433,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
         if (it_route_table->second.size() == 0)
         {
             m_syncdRoutes.erase(vrf_id);
+            m_routeTries.erase(vrf_id);
             m_vrfOrch->decreaseVrfRefCount(vrf_id);
         }
     }
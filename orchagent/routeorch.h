@@ -15,7 +15,12 @@
 #include "nexthopgroupkey.h"
 #include "bulker.h"
 #include "fgnhgorch.h"
+#include "parsepool.h"
+#include "prefixtrie.h"
+#include "timer.h"
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
@@ -64,6 +69,9 @@ struct RouteNhg
      */
     std::string nhg_index;
 
+    /* Resync epoch in which the route was last added or refreshed */
+    uint32_t epoch = 0;
+
     RouteNhg() = default;
     RouteNhg(const NextHopGroupKey& key, const std::string& index) :
         nhg_key(key), nhg_index(index) {}
@@ -88,7 +96,7 @@ struct RouteKey
 };
 
 /* NextHopGroupTable: NextHopGroupKey, NextHopGroupEntry */
-typedef std::map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
+typedef std::unordered_map<NextHopGroupKey, NextHopGroupEntry, NextHopGroupKeyHash> NextHopGroupTable;
 /* RouteTable: destination network, NextHopGroupKey */
 typedef std::map<IpPrefix, RouteNhg> RouteTable;
 /* RouteTables: vrf_id, RouteTable */
@@ -102,7 +110,21 @@ typedef std::pair<sai_object_id_t, IpAddress> Host;
 /* NextHopObserverTable: Host, next hop observer entry */
 typedef std::map<Host, NextHopObserverEntry> NextHopObserverTable;
 /* Single Nexthop to Routemap */
-typedef std::map<NextHopKey, std::set<RouteKey>> NextHopRouteTable;
+typedef std::unordered_map<NextHopKey, std::set<RouteKey>, NextHopKeyHash> NextHopRouteTable;
+
+/*
+ * Next hop group with a single member shared by the routes of one MUX next
+ * hop, so that a switchover changes all of them by replacing the member.
+ */
+struct PicNextHopEntry
+{
+    sai_object_id_t next_hop_group_id;      // shared next hop group id
+    sai_object_id_t member_id;              // id of the only member
+    sai_object_id_t next_hop_id;            // next hop the member points to
+};
+
+/* PicNextHopTable: next hop, shared next hop group */
+typedef std::unordered_map<NextHopKey, PicNextHopEntry, NextHopKeyHash> PicNextHopTable;
 
 struct NextHopObserverEntry
 {
@@ -121,6 +143,8 @@ struct RouteBulkContext
     bool                                excp_intfs_flag;
     // using_temp_nhg will track if the NhgOrch's owned NHG is temporary or not
     bool                                using_temp_nhg;
+    // dependencies the route waits on (next hops or router interface) when it cannot be added
+    std::vector<std::string>            dependencies;
 
     RouteBulkContext()
         : excp_intfs_flag(false), using_temp_nhg(false)
@@ -139,6 +163,50 @@ struct RouteBulkContext
         excp_intfs_flag = false;
         vrf_id = SAI_NULL_OBJECT_ID;
         using_temp_nhg = false;
+        dependencies.clear();
+    }
+};
+
+/*
+ * Typed content of an APP_ROUTE_TABLE entry, produced by RouteOrch::parseRoute()
+ * from the strings of the entry only. It is filled either inline by doTask()
+ * or ahead of time by the parse pool.
+ */
+struct ParsedRoute
+{
+    std::string                         vrf_name;           // Empty for the default VRF
+    bool                                prefix_parsed;
+    IpPrefix                            ip_prefix;
+
+    std::string                         weights;
+    std::string                         nhg_index;
+    bool                                overlay_nh;
+    bool                                blackhole;
+    bool                                srv6_nh;
+
+    // Next hop fields split on ',', filled only without nhg_index
+    std::vector<std::string>            ipv;
+    std::vector<std::string>            alsv;
+    std::vector<std::string>            mpls_nhv;
+    std::vector<std::string>            vni_labelv;
+    std::vector<std::string>            rmacv;
+    std::vector<std::string>            srv6_segv;
+    std::vector<std::string>            srv6_src;
+    // Size of the nexthop field before ipv is resized to match alsv
+    size_t                              ipv_size;
+    // Empty next hop IPs set to zero in ipv
+    size_t                              empty_ips;
+    // Route to management, docker or loopback interface
+    bool                                excp_intfs;
+
+    // Next hop group key, when it does not depend on the interfaces state
+    bool                                nhg_parsed;
+    NextHopGroupKey                     nhg;
+
+    ParsedRoute()
+        : prefix_parsed(false), overlay_nh(false), blackhole(false), srv6_nh(false),
+          ipv_size(0), empty_ips(0), excp_intfs(false), nhg_parsed(false)
+    {
     }
 };
 
@@ -191,10 +259,12 @@ public:
 
     bool addNextHopGroup(const NextHopGroupKey&);
     bool removeNextHopGroup(const NextHopGroupKey&);
+    bool updateNextHopGroupInPlace(const NextHopGroupKey& current, const NextHopGroupKey& nexthops);
 
     void addNextHopRoute(const NextHopKey&, const RouteKey&);
     void removeNextHopRoute(const NextHopKey&, const RouteKey&);
     bool updateNextHopRoutes(const NextHopKey&, uint32_t&);
+    sai_object_id_t getPicNextHopGroupId(const NextHopKey&) const;
 
     bool validnexthopinNextHopGroup(const NextHopKey&, uint32_t&);
     bool invalidnexthopinNextHopGroup(const NextHopKey&, uint32_t&);
@@ -219,6 +289,9 @@ public:
     void decreaseNextHopGroupCount();
     bool checkNextHopGroupCount();
     const RouteTables& getSyncdRoutes() const { return m_syncdRoutes; }
+    bool getLongestMatchRoute(sai_object_id_t vrf_id, const IpAddress& address, IpPrefix& prefix, RouteNhg& route_nhg) const;
+
+    static void parseRoute(const KeyOpFieldsValuesTuple &t, ParsedRoute &route);
 
 private:
     SwitchOrch *m_switchOrch;
@@ -232,6 +305,20 @@ private:
     unsigned int m_maxNextHopGroupCount;
     bool m_resync;
 
+    /*
+     * Routes not refreshed since the last resync started are stale. Once the
+     * resync completes they are removed a slice at a time from the sweep
+     * timer, the cursor being the next route to examine. The routes which
+     * fail to be removed are tried again in a few more passes.
+     */
+    uint32_t m_routeEpoch;
+    bool m_resyncSweep;
+    uint32_t m_resyncSweepPasses;
+    size_t m_resyncSweepFailed;
+    size_t m_resyncSweepRemoved;
+    RouteKey m_resyncSweepCursor;
+    SelectableTimer *m_resyncSweepTimer;
+
     shared_ptr<DBConnector> m_stateDb;
     unique_ptr<swss::Table> m_stateDefaultRouteTb;
 
@@ -239,22 +326,49 @@ private:
     LabelRouteTables m_syncdLabelRoutes;
     NextHopGroupTable m_syncdNextHopGroups;
     NextHopRouteTable m_nextHops;
+    PicNextHopTable m_picNextHops;
 
     std::set<std::pair<NextHopGroupKey, sai_object_id_t>> m_bulkNhgReducedRefCnt;
     /* m_bulkNhgReducedRefCnt: nexthop, vrf_id */
 
+    /* Next hop groups the routes of the current bulk point to */
+    std::unordered_set<NextHopGroupKey, NextHopGroupKeyHash> m_bulkNhgInUse;
+
+    /* Next hops whose shared next hop group may have no route left */
+    std::unordered_set<NextHopKey, NextHopKeyHash> m_bulkPicUnused;
+
+    /* Next hops whose shared next hop group member is queued in the bulker */
+    std::vector<NextHopKey> m_bulkPicMembers;
+
     NextHopObserverTable m_nextHopObservers;
 
+    /* Longest prefix match indexes of m_syncdRoutes and of the observed hosts, per VRF */
+    std::map<sai_object_id_t, PrefixTrie<RouteTable::iterator>> m_routeTries;
+    std::map<sai_object_id_t, PrefixTrie<NextHopObserverTable::iterator>> m_nextHopObserverTries;
+
+    /* Wakes routes parked on next hops and router interfaces */
+    DependencyObserver m_dependencyObserver{this};
+
     EntityBulker<sai_route_api_t>           gRouteBulker;
     EntityBulker<sai_mpls_api_t>            gLabelRouteBulker;
     ObjectBulker<sai_next_hop_group_api_t>  gNextHopGroupMemberBulker;
 
+    /* Pre-parses the APP_ROUTE_TABLE entries, null when disabled */
+    unique_ptr<ParsePool> m_parsePool;
+
     void addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
+    bool canUpdateNextHopGroupInPlace(const RouteBulkContext& ctx, const RouteNhg& route_nhg, const NextHopGroupKey& nextHops);
     bool addRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
     bool removeRoute(RouteBulkContext& ctx);
     bool addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops);
     bool removeRoutePost(const RouteBulkContext& ctx);
 
+    sai_object_id_t addPicNextHop(const NextHopKey&, sai_object_id_t next_hop_id);
+    void flushPicNextHops();
+    bool updatePicNextHop(const NextHopKey&, PicNextHopEntry&);
+    bool removePicNextHop(const NextHopKey&);
+    void removeUnusedPicNextHops();
+
     void addTempLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
     bool addLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
     bool removeLabelRoute(LabelRouteBulkContext& ctx);
@@ -263,7 +377,14 @@ private:
 
     void updateDefRouteState(string ip, bool add=false);
 
+    void refreshRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix);
+    void sweepStaleRoutes();
+    void removeReducedRefCntNextHopGroups();
+
     void doTask(Consumer& consumer);
+    void doTask(SelectableTimer &timer);
+    void parseRoutes(Consumer& consumer, std::vector<ParsedRoute>& routes,
+                     std::unordered_map<const KeyOpFieldsValuesTuple *, ParsedRoute *>& parsed);
     void doLabelTask(Consumer& consumer);
 
     const NhgBase &getNhg(const std::string& nhg_index);
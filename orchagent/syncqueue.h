@@ -0,0 +1,528 @@
+#ifndef SWSS_SYNCQUEUE_H
+#define SWSS_SYNCQUEUE_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "table.h"
+
+/*
+ * SyncQueue is the hash indexed task queue used as SyncMap, with the subset of
+ * the std::multimap interface the orchs use:
+ *
+ * 1. Tasks are kept in insertion order, the tasks of one key are always
+ *    adjacent and in FIFO order (e.g. DEL then SET).
+ * 2. Keys are indexed by an open addressing hash table holding a pointer to
+ *    the first task of each key, lookups are O(1) instead of O(log n) string
+ *    compares.
+ * 3. Nodes are carved out of fixed size chunks and recycled through a free
+ *    list, a steady stream of tasks does not hit the allocator.
+ *
+ * add() implements the Consumer::addToSync() semantics: a DEL overwrites all
+ * tasks of the key, a SET is merged in place into the pending SET of the key.
+ *
+ * Each task remembers when it was queued and whether it was already handed to
+ * the orch, for the consumer statistics. Both survive a merge and transfer().
+ */
+class SyncQueue
+{
+public:
+    typedef std::string key_type;
+    typedef swss::KeyOpFieldsValuesTuple mapped_type;
+    typedef std::pair<const std::string, swss::KeyOpFieldsValuesTuple> value_type;
+    typedef size_t size_type;
+    typedef std::chrono::steady_clock::time_point time_point;
+
+private:
+    struct Link
+    {
+        Link *prev;
+        Link *next;
+    };
+
+    struct Node : public Link
+    {
+        template <typename... Args>
+        Node(size_t h, time_point q, Args&&... args) :
+            hash(h), queued(q), value(std::forward<Args>(args)...)
+        {
+        }
+
+        size_t hash;
+        time_point queued;
+        bool attempted = false;
+        value_type value;
+    };
+
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef SyncQueue::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const value_type*, value_type*>::type pointer;
+        typedef typename std::conditional<Const, const value_type&, value_type&>::type reference;
+
+        Iterator() : m_link(nullptr)
+        {
+        }
+
+        /* iterator converts to const_iterator */
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        Iterator(const Iterator<false> &o) : m_link(o.m_link)
+        {
+        }
+
+        reference operator*() const { return static_cast<Node *>(m_link)->value; }
+        pointer operator->() const { return &static_cast<Node *>(m_link)->value; }
+
+        Iterator& operator++() { m_link = m_link->next; return *this; }
+        Iterator operator++(int) { Iterator t = *this; m_link = m_link->next; return t; }
+        Iterator& operator--() { m_link = m_link->prev; return *this; }
+        Iterator operator--(int) { Iterator t = *this; m_link = m_link->prev; return t; }
+
+        template <bool C>
+        bool operator==(const Iterator<C> &o) const { return m_link == o.m_link; }
+        template <bool C>
+        bool operator!=(const Iterator<C> &o) const { return m_link != o.m_link; }
+
+    private:
+        friend class SyncQueue;
+        template <bool> friend class Iterator;
+
+        explicit Iterator(Link *link) : m_link(link)
+        {
+        }
+
+        Link *m_link;
+    };
+
+public:
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    SyncQueue()
+    {
+        m_head.prev = m_head.next = &m_head;
+    }
+
+    ~SyncQueue()
+    {
+        clear();
+    }
+
+    SyncQueue(const SyncQueue&) = delete;
+    SyncQueue& operator=(const SyncQueue&) = delete;
+
+    iterator begin() { return iterator(m_head.next); }
+    iterator end() { return iterator(&m_head); }
+    const_iterator begin() const { return const_iterator(m_head.next); }
+    const_iterator end() const { return const_iterator(const_cast<Link *>(&m_head)); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void clear()
+    {
+        Link *link = m_head.next;
+        while (link != &m_head)
+        {
+            Link *next = link->next;
+            freeNode(static_cast<Node *>(link));
+            link = next;
+        }
+        m_head.prev = m_head.next = &m_head;
+        m_buckets.assign(m_buckets.size(), nullptr);
+        m_size = 0;
+        m_keys = 0;
+    }
+
+    iterator find(const std::string &key)
+    {
+        size_t idx;
+        return iterator(lookup(key, hashOf(key), idx) ? m_buckets[idx] : static_cast<Link *>(&m_head));
+    }
+
+    const_iterator find(const std::string &key) const
+    {
+        return const_cast<SyncQueue *>(this)->find(key);
+    }
+
+    size_type count(const std::string &key) const
+    {
+        auto range = const_cast<SyncQueue *>(this)->equal_range(key);
+        return static_cast<size_type>(std::distance(range.first, range.second));
+    }
+
+    /* Unlike multimap, a missing key returns an empty range at end() */
+    std::pair<iterator, iterator> equal_range(const std::string &key)
+    {
+        iterator first = find(key);
+        if (first == end())
+        {
+            return std::make_pair(first, first);
+        }
+        return std::make_pair(first, iterator(runEnd(static_cast<Node *>(first.m_link))));
+    }
+
+    /* Append a task after the pending tasks of the same key */
+    template <typename... Args>
+    iterator emplace(const std::string &key, Args&&... args)
+    {
+        return iterator(linkNode(allocNode(hashOf(key), std::chrono::steady_clock::now(),
+                                       std::piecewise_construct,
+                                       std::forward_as_tuple(key),
+                                       std::forward_as_tuple(std::forward<Args>(args)...))));
+    }
+
+    /*
+     * Move the tasks [first, last) of 'from' to this queue, keeping when they
+     * were queued and whether they were attempted.
+     * Returns: the iterator of 'from' following the moved tasks
+     */
+    iterator transfer(SyncQueue &from, const_iterator first, const_iterator last)
+    {
+        while (first != last)
+        {
+            Node *node = static_cast<Node *>(first.m_link);
+            Node *moved = linkNode(allocNode(node->hash, node->queued,
+                                         std::piecewise_construct,
+                                         std::forward_as_tuple(node->value.first),
+                                         std::forward_as_tuple(std::move(node->value.second))));
+            moved->attempted = node->attempted;
+            first = from.erase(first);
+        }
+        return iterator(last.m_link);
+    }
+
+    /* Time the task was first queued, merges into a pending SET keep it */
+    time_point queuedAt(const_iterator pos) const
+    {
+        return static_cast<const Node *>(pos.m_link)->queued;
+    }
+
+    /* Queue time of the oldest task, time_point::max() when empty */
+    time_point oldestQueued() const
+    {
+        time_point oldest = time_point::max();
+        for (const Link *link = m_head.next; link != &m_head; link = link->next)
+        {
+            oldest = std::min(oldest, static_cast<const Node *>(link)->queued);
+        }
+        return oldest;
+    }
+
+    /*
+     * Mark all tasks as attempted, e.g. before they are handed to doTask.
+     * Returns: the number of tasks already attempted, i.e. retried
+     */
+    size_type markAttempted()
+    {
+        size_type retries = 0;
+        for (Link *link = m_head.next; link != &m_head; link = link->next)
+        {
+            Node *node = static_cast<Node *>(link);
+            retries += node->attempted;
+            node->attempted = true;
+        }
+        return retries;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        Node *node = static_cast<Node *>(pos.m_link);
+        Link *next = node->next;
+
+        if (isRunHead(node))
+        {
+            size_t idx;
+            lookup(node->value.first, node->hash, idx);
+            if (next != &m_head && sameKey(static_cast<Node *>(next), node))
+            {
+                m_buckets[idx] = static_cast<Node *>(next);
+            }
+            else
+            {
+                eraseBucket(idx);
+            }
+        }
+
+        unlink(node);
+        freeNode(node);
+        m_size--;
+
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while (first != last)
+        {
+            first = erase(first);
+        }
+        return iterator(last.m_link);
+    }
+
+    size_type erase(const std::string &key)
+    {
+        auto range = equal_range(key);
+        size_type n = static_cast<size_type>(std::distance(range.first, range.second));
+        erase(range.first, range.second);
+        return n;
+    }
+
+    /*
+     * Add a task with the Consumer::addToSync() semantics.
+     * There are at most two tasks per key: DEL, SET or DEL then SET.
+     */
+    void add(const swss::KeyOpFieldsValuesTuple &entry)
+    {
+        const std::string &key = kfvKey(entry);
+        const std::string &op = kfvOp(entry);
+
+        auto range = equal_range(key);
+
+        /* If a new task comes we directly put it into the queue */
+        if (range.first == range.second)
+        {
+            emplace(key, entry);
+            return;
+        }
+
+        /* if a DEL task comes, we overwrite the old key */
+        if (op == DEL_COMMAND)
+        {
+            erase(range.first, range.second);
+            emplace(key, entry);
+            return;
+        }
+
+        /* Merge the SET into the pending SET if any */
+        auto iter = range.first;
+        for (; iter != range.second; ++iter)
+        {
+            if (kfvOp(iter->second) == SET_COMMAND)
+            {
+                break;
+            }
+        }
+
+        if (iter == range.second)
+        {
+            emplace(key, entry);
+            return;
+        }
+
+        auto &existing_values = kfvFieldsValues(iter->second);
+        for (const auto &fv : kfvFieldsValues(entry))
+        {
+            auto iu = existing_values.begin();
+            while (iu != existing_values.end())
+            {
+                if (fvField(*iu) == fvField(fv))
+                    iu = existing_values.erase(iu);
+                else
+                    iu++;
+            }
+            existing_values.push_back(fv);
+        }
+        kfvOp(iter->second) = op;
+    }
+
+private:
+    static const size_t NODES_PER_CHUNK = 1024;
+    static const size_t MIN_BUCKETS = 16;
+
+    typedef typename std::aligned_storage<sizeof(Node), alignof(Node)>::type NodeStorage;
+
+    Link m_head;
+    size_type m_size = 0;
+    size_type m_keys = 0;
+
+    /* Open addressing table, each bucket points to the first task of a key */
+    std::vector<Node *> m_buckets;
+
+    /* Arena of nodes */
+    std::vector<std::unique_ptr<NodeStorage[]>> m_chunks;
+    size_t m_chunkUsed = NODES_PER_CHUNK;
+    std::vector<Node *> m_freeNodes;
+
+    static size_t hashOf(const std::string &key)
+    {
+        return std::hash<std::string>()(key);
+    }
+
+    static bool sameKey(const Node *a, const Node *b)
+    {
+        return a->hash == b->hash && a->value.first == b->value.first;
+    }
+
+    bool isRunHead(const Node *node) const
+    {
+        return node->prev == &m_head || !sameKey(static_cast<const Node *>(node->prev), node);
+    }
+
+    /* Return the link following the tasks of the key starting at 'node' */
+    Link *runEnd(Node *node) const
+    {
+        Link *link = node->next;
+        while (link != &m_head && sameKey(static_cast<Node *>(link), node))
+        {
+            link = link->next;
+        }
+        return link;
+    }
+
+    /*
+     * Probe for the key, on return 'idx' is the bucket holding the key,
+     * or the empty bucket where it should be inserted.
+     */
+    bool lookup(const std::string &key, size_t h, size_t &idx) const
+    {
+        if (m_buckets.empty())
+        {
+            idx = 0;
+            return false;
+        }
+
+        size_t mask = m_buckets.size() - 1;
+        for (idx = h & mask; m_buckets[idx]; idx = (idx + 1) & mask)
+        {
+            const Node *node = m_buckets[idx];
+            if (node->hash == h && node->value.first == key)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insertBucket(size_t idx, Node *node)
+    {
+        /* Keep load factor under 1/2 */
+        if ((m_keys + 1) * 2 > m_buckets.size())
+        {
+            rehash(m_buckets.empty() ? MIN_BUCKETS : m_buckets.size() * 2);
+            lookup(node->value.first, node->hash, idx);
+        }
+        m_buckets[idx] = node;
+        m_keys++;
+    }
+
+    /* Backward shift deletion, no tombstones are left behind */
+    void eraseBucket(size_t idx)
+    {
+        size_t mask = m_buckets.size() - 1;
+        size_t hole = idx;
+        for (size_t next = (hole + 1) & mask; m_buckets[next]; next = (next + 1) & mask)
+        {
+            size_t home = m_buckets[next]->hash & mask;
+            /* Move the entry if its home is not in (hole, next] */
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                m_buckets[hole] = m_buckets[next];
+                hole = next;
+            }
+        }
+        m_buckets[hole] = nullptr;
+        m_keys--;
+    }
+
+    void rehash(size_t count)
+    {
+        std::vector<Node *> buckets(count, nullptr);
+        size_t mask = count - 1;
+        for (auto node : m_buckets)
+        {
+            if (!node)
+            {
+                continue;
+            }
+            size_t idx = node->hash & mask;
+            while (buckets[idx])
+            {
+                idx = (idx + 1) & mask;
+            }
+            buckets[idx] = node;
+        }
+        m_buckets.swap(buckets);
+    }
+
+    /* Link a new node after the pending tasks of its key, or at the tail */
+    Node *linkNode(Node *node)
+    {
+        size_t idx;
+        if (lookup(node->value.first, node->hash, idx))
+        {
+            linkBefore(runEnd(m_buckets[idx]), node);
+        }
+        else
+        {
+            linkBefore(&m_head, node);
+            insertBucket(idx, node);
+        }
+        m_size++;
+
+        return node;
+    }
+
+    void linkBefore(Link *pos, Link *link)
+    {
+        link->prev = pos->prev;
+        link->next = pos;
+        pos->prev->next = link;
+        pos->prev = link;
+    }
+
+    void unlink(Link *link)
+    {
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+    }
+
+    template <typename... Args>
+    Node *allocNode(Args&&... args)
+    {
+        void *mem;
+        if (!m_freeNodes.empty())
+        {
+            mem = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        }
+        else
+        {
+            if (m_chunkUsed == NODES_PER_CHUNK)
+            {
+                m_chunks.emplace_back(new NodeStorage[NODES_PER_CHUNK]);
+                m_chunkUsed = 0;
+            }
+            mem = &m_chunks.back()[m_chunkUsed++];
+        }
+        return new (mem) Node(std::forward<Args>(args)...);
+    }
+
+    void freeNode(Node *node)
+    {
+        node->~Node();
+        m_freeNodes.push_back(node);
+    }
+};
+
+#endif /* SWSS_SYNCQUEUE_H */
@@ -0,0 +1,57 @@
+#ifndef SWSS_TASKDEPENDENCY_H
+#define SWSS_TASKDEPENDENCY_H
+
+#include <string>
+
+#include "orch.h"
+#include "observer.h"
+
+struct DependencyUpdate
+{
+    std::string dependency;
+};
+
+/*
+ * Publishes that a dependency (e.g. a next hop, a port alias, a table name)
+ * has been created or changed. It is kept apart from the Subject of the
+ * publishing Orch so that existing observers never see this update type.
+ */
+class DependencySubject : public Subject
+{
+public:
+    void publish(const std::string &dependency)
+    {
+        if (m_observers.empty())
+        {
+            return;
+        }
+
+        DependencyUpdate update = { dependency };
+        notify(SUBJECT_TYPE_DEPENDENCY_CHANGE, static_cast<void *>(&update));
+    }
+};
+
+/* Wakes the tasks of an Orch parked on a published dependency */
+class DependencyObserver : public Observer
+{
+public:
+    DependencyObserver(Orch *orch) : m_orch(orch)
+    {
+    }
+
+    void update(SubjectType type, void *cntx) override
+    {
+        if (type != SUBJECT_TYPE_DEPENDENCY_CHANGE)
+        {
+            return;
+        }
+
+        DependencyUpdate *update = static_cast<DependencyUpdate *>(cntx);
+        m_orch->wakeParkedTasks(update->dependency);
+    }
+
+private:
+    Orch *m_orch;
+};
+
+#endif /* SWSS_TASKDEPENDENCY_H */
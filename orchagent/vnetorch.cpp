@@ -1340,20 +1340,18 @@ void VNetRouteOrch::attach(Observer* observer, const IpAddress& dstAddr)
      * IP address */
     if (insert_result.second)
     {
+        next_hop_observer_trie_.insert(dstAddr, observerEntry);
+
         /* Find the prefixes that cover the destination IP */
-        for (auto route : syncd_routes_)
-        {
-            if (route.first.isAddressInSubnet(dstAddr))
-            {
-                SWSS_LOG_INFO("Prefix %s covers destination address",
-                    route.first.to_string().c_str());
+        syncd_route_trie_.forEachCovering(dstAddr, [&](const VNetRouteTable::iterator &route) {
+            SWSS_LOG_INFO("Prefix %s covers destination address",
+                route->first.to_string().c_str());
 
-                observerEntry->second.routeTable.emplace(
-                    route.first,
-                    route.second
-                );
-            }
-        }
+            observerEntry->second.routeTable.emplace(
+                route->first,
+                route->second
+            );
+        });
     }
 
     observerEntry->second.observers.push_back(observer);
@@ -1418,16 +1416,26 @@ void VNetRouteOrch::detach(Observer* observer, const IpAddress& dstAddr)
             observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, reinterpret_cast<void*>(&update));
         }
     }
+    next_hop_observer_trie_.erase(dstAddr);
     next_hop_observers_.erase(observerEntry);
 }
 
 void VNetRouteOrch::addRoute(const std::string& vnet, const IpPrefix& ipPrefix, const nextHop& nh)
 {
     SWSS_LOG_ENTER();
-    for (auto& next_hop_observer : next_hop_observers_)
+
+    /* The observers may attach or detach from their update */
+    vector<IpAddress> destinations;
+    next_hop_observer_trie_.forEachWithin(ipPrefix, [&destinations](const VNetNextHopObserverTable::iterator &entry) {
+        destinations.push_back(entry->first);
+    });
+
+    for (auto& destination : destinations)
     {
-        if (ipPrefix.isAddressInSubnet(next_hop_observer.first))
+        auto observer_itr = next_hop_observers_.find(destination);
+        if (observer_itr != next_hop_observers_.end())
         {
+            auto& next_hop_observer = *observer_itr;
             auto route_insert_result = next_hop_observer.second.routeTable.emplace(ipPrefix, VNetEntry());
 
             auto vnet_result_result = route_insert_result.first->second.emplace(vnet, nh);
@@ -1459,7 +1467,9 @@ void VNetRouteOrch::addRoute(const std::string& vnet, const IpPrefix& ipPrefix,
             }
         }
     }
-    syncd_routes_.emplace(ipPrefix, VNetEntry()).first->second[vnet] = nh;
+    auto route_itr = syncd_routes_.emplace(ipPrefix, VNetEntry()).first;
+    route_itr->second[vnet] = nh;
+    syncd_route_trie_.insert(ipPrefix, route_itr);
 }
 
 void VNetRouteOrch::delRoute(const IpPrefix& ipPrefix)
@@ -1473,45 +1483,52 @@ void VNetRouteOrch::delRoute(const IpPrefix& ipPrefix)
         assert(false);
         return;
     }
-    auto next_hop_observer = next_hop_observers_.begin();
-    while(next_hop_observer != next_hop_observers_.end())
+    vector<IpAddress> destinations;
+    next_hop_observer_trie_.forEachWithin(ipPrefix, [&destinations](const VNetNextHopObserverTable::iterator &entry) {
+        destinations.push_back(entry->first);
+    });
+
+    for (auto& destination : destinations)
     {
-        if (ipPrefix.isAddressInSubnet(next_hop_observer->first))
+        auto next_hop_observer = next_hop_observers_.find(destination);
+        if (next_hop_observer == next_hop_observers_.end())
         {
-            auto itr = next_hop_observer->second.routeTable.find(ipPrefix);
-            if ( itr == next_hop_observer->second.routeTable.end())
-            {
-                SWSS_LOG_ERROR(
-                    "Failed to find any ip(%s) belong to this route(%s).",
-                    next_hop_observer->first.to_string().c_str(),
-                    ipPrefix.to_string().c_str());
-                assert(false);
-                continue;
-            }
-            if (itr->second.empty())
-            {
-                continue;
-            }
-            for (auto& observer : next_hop_observer->second.observers)
-            {
-                VNetNextHopUpdate update = {
-                    DEL_COMMAND,
-                    itr->second.rbegin()->first, // vnet name
-                    next_hop_observer->first, // destination
-                    itr->first, // prefix
-                    itr->second.rbegin()->second // nexthop
-                };
-                observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, reinterpret_cast<void*>(&update));
-            }
-            next_hop_observer->second.routeTable.erase(itr);
-            if (next_hop_observer->second.routeTable.empty())
-            {
-                next_hop_observer = next_hop_observers_.erase(next_hop_observer);
-                continue;
-            }
+            continue;
+        }
+
+        auto itr = next_hop_observer->second.routeTable.find(ipPrefix);
+        if ( itr == next_hop_observer->second.routeTable.end())
+        {
+            SWSS_LOG_ERROR(
+                "Failed to find any ip(%s) belong to this route(%s).",
+                next_hop_observer->first.to_string().c_str(),
+                ipPrefix.to_string().c_str());
+            assert(false);
+            continue;
+        }
+        if (itr->second.empty())
+        {
+            continue;
+        }
+        for (auto& observer : next_hop_observer->second.observers)
+        {
+            VNetNextHopUpdate update = {
+                DEL_COMMAND,
+                itr->second.rbegin()->first, // vnet name
+                next_hop_observer->first, // destination
+                itr->first, // prefix
+                itr->second.rbegin()->second // nexthop
+            };
+            observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, reinterpret_cast<void*>(&update));
+        }
+        next_hop_observer->second.routeTable.erase(itr);
+        if (next_hop_observer->second.routeTable.empty())
+        {
+            next_hop_observer_trie_.erase(destination);
+            next_hop_observers_.erase(next_hop_observer);
         }
-        next_hop_observer++;
     }
+    syncd_route_trie_.erase(ipPrefix);
     syncd_routes_.erase(route_itr);
 }
 
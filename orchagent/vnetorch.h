@@ -14,6 +14,7 @@
 #include "observer.h"
 #include "nexthopgroupkey.h"
 #include "bfdorch.h"
+#include "prefixtrie.h"
 
 #define VNET_BITMAP_SIZE 32
 #define VNET_TUNNEL_SIZE 40960
@@ -377,6 +378,9 @@ private:
 
     VNetRouteTable syncd_routes_;
     VNetNextHopObserverTable next_hop_observers_;
+    /* Longest prefix match indexes of syncd_routes_ and next_hop_observers_ */
+    PrefixTrie<VNetRouteTable::iterator> syncd_route_trie_;
+    PrefixTrie<VNetNextHopObserverTable::iterator> next_hop_observer_trie_;
     std::map<std::string, VNetNextHopGroupInfoTable> syncd_nexthop_groups_;
     std::map<std::string, VNetTunnelRouteTable> syncd_tunnel_routes_;
     BfdSessionTable bfd_sessions_;
@@ -1292,6 +1292,16 @@ void VxlanTunnelOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (m_pendingAddToFlexCntr.empty())
+    {
+        return;
+    }
+
+    vector<FieldValueTuple> tunnelNameFvs;
+    vector<FieldValueTuple> tunnelTypeFvs;
+    auto tunnel_stats = generateTunnelCounterStats();
+    FlexCounterBatch batch({ tunnel_stat_manager });
+
     for (auto it = m_pendingAddToFlexCntr.begin(); it != m_pendingAddToFlexCntr.end(); )
     {
         string value;
@@ -1300,17 +1310,11 @@ void VxlanTunnelOrch::doTask(SelectableTimer &timer)
         if (m_vidToRidTable->hget("", id, value))
         {
             SWSS_LOG_INFO("Registering %s, id %s", it->second.c_str(), id.c_str());
-            vector<FieldValueTuple> tunnelNameFvs;
-            vector<FieldValueTuple> tunnelTypeFvs;
             string type = "SAI_TUNNEL_TYPE_VXLAN";
 
             tunnelNameFvs.emplace_back(it->second, id);
             tunnelTypeFvs.emplace_back(id, type);
 
-            m_tunnelNameTable->set("", tunnelNameFvs);
-            m_tunnelTypeTable->set("", tunnelTypeFvs);
-            auto tunnel_stats = generateTunnelCounterStats();
-
             tunnel_stat_manager->setCounterIdList(it->first, CounterType::TUNNEL,
                                                   tunnel_stats);
             it = m_pendingAddToFlexCntr.erase(it);
@@ -1320,6 +1324,12 @@ void VxlanTunnelOrch::doTask(SelectableTimer &timer)
             ++it;
         }
     }
+
+    if (!tunnelNameFvs.empty())
+    {
+        m_tunnelNameTable->set("", tunnelNameFvs);
+        m_tunnelTypeTable->set("", tunnelTypeFvs);
+    }
 }
 void VxlanTunnelOrch::addTunnelToFlexCounter(sai_object_id_t oid, const string &name)
 {
@@ -315,6 +315,7 @@ namespace aclorch_test
             sai_api_query(SAI_API_BRIDGE, (void **)&sai_bridge_api);
             sai_api_query(SAI_API_PORT, (void **)&sai_port_api);
             sai_api_query(SAI_API_VLAN, (void **)&sai_vlan_api);
+            sai_api_query(SAI_API_LAG, (void **)&sai_lag_api);
             sai_api_query(SAI_API_ROUTE, (void **)&sai_route_api);
             sai_api_query(SAI_API_MPLS, (void **)&sai_mpls_api);
             sai_api_query(SAI_API_ACL, (void **)&sai_acl_api);
@@ -484,6 +485,7 @@ namespace aclorch_test
             sai_acl_api = nullptr;
             sai_port_api = nullptr;
             sai_vlan_api = nullptr;
+            sai_lag_api = nullptr;
             sai_bridge_api = nullptr;
             sai_route_api = nullptr;
             sai_mpls_api = nullptr;
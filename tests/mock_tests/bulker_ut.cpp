@@ -143,3 +143,162 @@ namespace bulker_test
         ASSERT_FALSE(gRouteBulker.bulk_entry_pending_removal(route_entry_non_remove));
     }
 }
+
+namespace bulker_neighbor_test
+{
+    using namespace std;
+
+    size_t create_neighbor_entry_calls;
+
+    sai_status_t bulk_create_neighbor_entries_unsupported(uint32_t, const sai_neighbor_entry_t *, const uint32_t *,
+            const sai_attribute_t **, sai_bulk_op_error_mode_t, sai_status_t *)
+    {
+        return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+
+    sai_status_t create_neighbor_entry_counted(const sai_neighbor_entry_t *, uint32_t, const sai_attribute_t *)
+    {
+        create_neighbor_entry_calls++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    TEST(NeighborBulkerTest, FallbackToSingleCreate)
+    {
+        sai_neighbor_api_t neighbor_api = {};
+        neighbor_api.create_neighbor_entries = bulk_create_neighbor_entries_unsupported;
+        neighbor_api.create_neighbor_entry = create_neighbor_entry_counted;
+        create_neighbor_entry_calls = 0;
+
+        EntityBulker<sai_neighbor_api_t> neighBulker(&neighbor_api, 1000);
+        deque<sai_status_t> object_statuses;
+
+        sai_attribute_t neighbor_attr;
+        neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_NO_HOST_ROUTE;
+        neighbor_attr.value.booldata = true;
+
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            sai_neighbor_entry_t neighbor_entry = {};
+            neighbor_entry.rif_id = 0x6000000000001;
+            neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+            neighbor_entry.ip_address.addr.ip4 = htonl(0x0a000001 + i);
+
+            object_statuses.emplace_back(SAI_STATUS_FAILURE);
+            neighBulker.create_entry(&object_statuses.back(), &neighbor_entry, 1, &neighbor_attr);
+        }
+        ASSERT_EQ(neighBulker.creating_entries_count(), 2);
+
+        neighBulker.flush();
+
+        // Bulk create is not implemented, each entry is created on its own
+        EXPECT_EQ(create_neighbor_entry_calls, 2);
+        EXPECT_EQ(neighBulker.creating_entries_count(), 0);
+        for (auto status : object_statuses)
+        {
+            EXPECT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+    }
+}
+
+namespace bulker_next_hop_test
+{
+    using namespace std;
+
+    vector<sai_object_id_t> created_next_hops;
+
+    sai_status_t bulk_create_next_hops_unsupported(sai_object_id_t, uint32_t, const uint32_t *,
+            const sai_attribute_t **, sai_bulk_op_error_mode_t, sai_object_id_t *, sai_status_t *)
+    {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    sai_status_t create_next_hop_counted(sai_object_id_t *next_hop_id, sai_object_id_t, uint32_t attr_count,
+            const sai_attribute_t *)
+    {
+        if (attr_count == 0)
+        {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+        *next_hop_id = 0x4000000000001 + created_next_hops.size();
+        created_next_hops.push_back(*next_hop_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    TEST(NextHopBulkerTest, FallbackToSingleCreate)
+    {
+        sai_next_hop_api_t next_hop_api = {};
+        next_hop_api.create_next_hops = bulk_create_next_hops_unsupported;
+        next_hop_api.create_next_hop = create_next_hop_counted;
+        created_next_hops.clear();
+
+        ObjectBulker<sai_next_hop_api_t> nextHopBulker(&next_hop_api, 0x21000000000000, 1000);
+
+        sai_attribute_t next_hop_attr;
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+
+        sai_object_id_t next_hop_ids[2];
+        sai_status_t object_statuses[2];
+        nextHopBulker.create_entry(&next_hop_ids[0], 1, &next_hop_attr, &object_statuses[0]);
+        nextHopBulker.create_entry(&next_hop_ids[1], 1, &next_hop_attr, &object_statuses[1]);
+        ASSERT_EQ(nextHopBulker.creating_entries_count(), 2);
+        EXPECT_EQ(next_hop_ids[0], SAI_NULL_OBJECT_ID);
+        EXPECT_EQ(object_statuses[0], SAI_STATUS_NOT_EXECUTED);
+
+        nextHopBulker.flush();
+
+        // Bulk create is not supported, each next hop is created on its own
+        ASSERT_EQ(created_next_hops.size(), 2);
+        EXPECT_EQ(nextHopBulker.creating_entries_count(), 0);
+        for (size_t i = 0; i < 2; i++)
+        {
+            EXPECT_EQ(next_hop_ids[i], created_next_hops[i]);
+            EXPECT_EQ(object_statuses[i], SAI_STATUS_SUCCESS);
+        }
+    }
+}
+
+namespace bulker_bridge_port_test
+{
+    using namespace std;
+
+    size_t create_bridge_port_calls;
+
+    sai_status_t create_bridge_port_counted(sai_object_id_t *bridge_port_id, sai_object_id_t, uint32_t,
+            const sai_attribute_t *)
+    {
+        *bridge_port_id = 0x3a000000000001 + create_bridge_port_calls++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    TEST(BridgePortBulkerTest, CreateWithoutBulkApi)
+    {
+        sai_bridge_api_t bridge_api = {};
+        bridge_api.create_bridge_port = create_bridge_port_counted;
+        create_bridge_port_calls = 0;
+
+        ObjectBulker<sai_bridge_api_t> bridgePortBulker(&bridge_api, 0x21000000000000, 1000);
+        EXPECT_EQ(bridgePortBulker.create_entries, nullptr);
+
+        sai_attribute_t bridge_port_attr;
+        bridge_port_attr.id = SAI_BRIDGE_PORT_ATTR_TYPE;
+        bridge_port_attr.value.s32 = SAI_BRIDGE_PORT_TYPE_PORT;
+
+        sai_object_id_t bridge_port_ids[2];
+        sai_status_t object_statuses[2];
+        bridgePortBulker.create_entry(&bridge_port_ids[0], 1, &bridge_port_attr, &object_statuses[0]);
+        bridgePortBulker.create_entry(&bridge_port_ids[1], 1, &bridge_port_attr, &object_statuses[1]);
+        ASSERT_EQ(bridgePortBulker.creating_entries_count(), 2);
+
+        bridgePortBulker.flush();
+
+        // The SAI has no bulk API for bridge ports, each one is created on its own
+        ASSERT_EQ(create_bridge_port_calls, 2);
+        EXPECT_EQ(bridgePortBulker.creating_entries_count(), 0);
+        for (size_t i = 0; i < 2; i++)
+        {
+            EXPECT_NE(bridge_port_ids[i], SAI_NULL_OBJECT_ID);
+            EXPECT_EQ(object_statuses[i], SAI_STATUS_SUCCESS);
+        }
+    }
+}
@@ -1,10 +1,13 @@
 #include "ut_helper.h"
 #include "mock_orchagent_main.h"
 #include "mock_table.h"
+#include "orchdaemon.h"
 
 #include <sstream>
+#include <thread>
 
 extern PortsOrch *gPortsOrch;
+extern uint32_t gConsumerTimeBudgetMsecs;
 
 namespace consumer_test
 {
@@ -72,6 +75,91 @@ namespace consumer_test
         }
     };
 
+    /* Table handing out the entries pushed by the test, POP_BATCH_SIZE at a time */
+    struct FakeConsumerTable : public swss::ConsumerTableBase
+    {
+        FakeConsumerTable(swss::DBConnector *db, const string &tableName) :
+            swss::ConsumerTableBase(db, tableName, 10)
+        {
+        }
+
+        void pops(deque<KeyOpFieldsValuesTuple> &vkco, const string &prefix = swss::EMPTY_PREFIX) override
+        {
+            vkco.clear();
+            while (!m_entries.empty() && vkco.size() < static_cast<size_t>(POP_BATCH_SIZE))
+            {
+                vkco.push_back(m_entries.front());
+                m_entries.pop_front();
+            }
+        }
+
+        void push(size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                m_entries.push_back(KeyOpFieldsValuesTuple("key" + to_string(m_next++), SET_COMMAND, { { "field", "value" } }));
+            }
+        }
+
+        deque<KeyOpFieldsValuesTuple> m_entries;
+        size_t m_next = 0;
+    };
+
+    /* Orch counting its drains, its tasks are completed once ready */
+    struct RetryOrch : public Orch
+    {
+        RetryOrch(swss::DBConnector *db, const string &table) : Orch(vector<TableConnector>())
+        {
+            addExecutor(new Consumer(new FakeConsumerTable(db, table), this, table));
+        }
+
+        void doTask(Consumer &consumer) override
+        {
+            drains++;
+            if (ready)
+            {
+                consumer.m_toSync.clear();
+            }
+        }
+
+        void addTask()
+        {
+            auto *consumer = dynamic_cast<Consumer *>(m_consumerMap.begin()->second.get());
+            consumer->addToSync(KeyOpFieldsValuesTuple("key", SET_COMMAND, { { "field", "value" } }));
+        }
+
+        bool ready = true;
+        size_t drains = 0;
+    };
+
+    /* Orch spending 100us per task, with a bulk table and a latency sensitive one */
+    struct BudgetOrch : public Orch
+    {
+        BudgetOrch(swss::DBConnector *db) : Orch(vector<TableConnector>())
+        {
+            for (const string table : { "TEST_BULK_TABLE", APP_NEIGH_TABLE_NAME })
+            {
+                addExecutor(new Consumer(new FakeConsumerTable(db, table), this, table));
+            }
+        }
+
+        void doTask(Consumer &consumer) override
+        {
+            this_thread::sleep_for(chrono::microseconds(100) * consumer.m_toSync.size());
+            consumer.m_toSync.clear();
+        }
+
+        Consumer *getConsumer(const string &table)
+        {
+            return dynamic_cast<Consumer *>(getExecutor(table));
+        }
+
+        FakeConsumerTable *getTable(const string &table)
+        {
+            return static_cast<FakeConsumerTable *>(getConsumer(table)->getConsumerTable());
+        }
+    };
+
     TEST_F(ConsumerTest, ConsumerAddToSync_Set)
     {
 
@@ -322,4 +410,227 @@ namespace consumer_test
         validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
 
     }
+
+    TEST_F(ConsumerTest, ConsumerPark_Set_Unpark_On_New_Set)
+    {
+        // Test case, SET is parked on a dependency, then a new SET for the same key comes
+        auto entrya = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f3, v3a } } });
+
+        consumer->addToSync(entrya);
+        auto it = consumer->park(consumer->m_toSync.begin(), "dependency");
+
+        // parked task is out of m_toSync but still reported as pending
+        ASSERT_TRUE(it == consumer->m_toSync.end());
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(consumer->getParkedTaskCount(), 1);
+
+        vector<string> ts;
+        consumer->dumpPendingTasks(ts);
+        ASSERT_EQ(ts.size(), 1);
+
+        // expect the parked SET merged with the new one
+        consumer->addToSync(entryb);
+        ASSERT_EQ(consumer->getParkedTaskCount(), 0);
+
+        exp_kofv = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a },
+                    { f3, v3a } } });
+        validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
+    }
+
+    TEST_F(ConsumerTest, ConsumerPark_Del_Set_Order)
+    {
+        // Test case, DEL then SET are parked together, then a new SET comes
+        auto entrya = KeyOpFieldsValuesTuple(
+            { key,
+                DEL_COMMAND,
+                { { } } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+
+        auto entryc = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1b } } });
+
+        kofv_q.push_back(entrya);
+        kofv_q.push_back(entryb);
+        consumer->addToSync(kofv_q);
+
+        consumer->park(consumer->m_toSync.begin(), "dependency");
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(consumer->getParkedTaskCount(), 1);
+
+        consumer->addToSync(entryc);
+
+        // expect DEL then SET with new values
+        exp_kofv = entrya;
+        validate_syncmap(consumer->m_toSync, 2, key, exp_kofv);
+
+        exp_kofv = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f2, v2a },
+                    { f1, v1b } } });
+        validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
+    }
+
+    TEST_F(ConsumerTest, ConsumerStats_Histogram)
+    {
+        StatsHistogram histogram;
+        histogram.add(0);
+        histogram.add(1);
+        histogram.add(5);
+        histogram.add(100000000);
+
+        vector<FieldValueTuple> fvs;
+        histogram.toFieldValues("TEST", fvs);
+
+        map<string, string> values(fvs.begin(), fvs.end());
+        ASSERT_EQ(values["TEST_LE_1"], "2");
+        ASSERT_EQ(values["TEST_LE_10"], "1");
+        ASSERT_EQ(values["TEST_LE_100"], "0");
+        ASSERT_EQ(values["TEST_GT_10000000"], "1");
+        ASSERT_EQ(values["TEST_COUNT"], "4");
+        ASSERT_EQ(values["TEST_SUM"], "100000006");
+    }
+
+    TEST_F(ConsumerTest, ConsumerStats_OldestPending)
+    {
+        ASSERT_EQ(consumer->getOldestPendingMsecs(), 0);
+
+        auto entry = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a } } });
+        consumer->addToSync(entry);
+        auto queued = consumer->m_toSync.queuedAt(consumer->m_toSync.begin());
+
+        // parked tasks are not pending
+        consumer->park(consumer->m_toSync.begin(), "dependency");
+        ASSERT_EQ(consumer->getOldestPendingMsecs(), 0);
+
+        // the woken task is as old as when it was first queued
+        consumer->wake("dependency");
+        consumer->restoreWokenTasks();
+        ASSERT_EQ(consumer->m_toSync.size(), 1);
+        ASSERT_EQ(consumer->m_toSync.queuedAt(consumer->m_toSync.begin()), queued);
+
+        // and so is it once merged with a newer SET
+        entry = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f2, v2a } } });
+        consumer->addToSync(entry);
+        ASSERT_EQ(consumer->m_toSync.queuedAt(consumer->m_toSync.begin()), queued);
+
+        vector<string> ts;
+        consumer->dumpStats(ts);
+        ASSERT_EQ(ts.size(), 1);
+        ASSERT_EQ(ts[0].find(consumer->getStatsKey()), 0);
+        ASSERT_NE(ts[0].find("|OLDEST_PENDING_MS:"), string::npos);
+        ASSERT_NE(ts[0].find("|RETRIES:0"), string::npos);
+    }
+
+    TEST_F(ConsumerTest, ConsumerTimeBudget_ShrinksPops)
+    {
+        auto batchSize = gBatchSize;
+        auto timeBudget = gConsumerTimeBudgetMsecs;
+        gBatchSize = 10;
+        gConsumerTimeBudgetMsecs = 1;
+
+        auto *orch = new BudgetOrch(m_app_db.get());
+        {
+            OrchDaemon daemon(m_app_db.get(), m_config_db.get(), m_state_db.get(), nullptr);
+            daemon.addOrchList(orch);
+            daemon.setConsumerTimeBudget();
+
+            for (const string table : { "TEST_BULK_TABLE", APP_NEIGH_TABLE_NAME })
+            {
+                auto *consumer = orch->getConsumer(table);
+
+                // Nothing is known yet, the first execute() pops the whole table in 100ms
+                orch->getTable(table)->push(1000);
+                consumer->execute();
+                ASSERT_EQ(consumer->getLastPopCount(), 1000);
+                ASSERT_FALSE(consumer->hasMoreData());
+
+                orch->getTable(table)->push(1000);
+                consumer->execute();
+                if (table == APP_NEIGH_TABLE_NAME)
+                {
+                    // Latency sensitive tables are not throttled
+                    ASSERT_EQ(consumer->getLastPopCount(), 1000);
+                    ASSERT_FALSE(consumer->hasMoreData());
+                }
+                else
+                {
+                    // Over budget, the consumer pops less and leaves the rest in the table
+                    ASSERT_LT(consumer->getLastPopCount(), 1000);
+                    ASSERT_GE(consumer->getLastPopCount(), 10);
+                    ASSERT_TRUE(consumer->hasMoreData());
+                }
+            }
+        }
+
+        gBatchSize = batchSize;
+        gConsumerTimeBudgetMsecs = timeBudget;
+    }
+
+    TEST_F(ConsumerTest, OrchDaemon_DrainsDirtyOrchs)
+    {
+        auto *producer = new RetryOrch(m_app_db.get(), "TEST_PRODUCER_TABLE");
+        auto *dependent = new RetryOrch(m_app_db.get(), "TEST_DEPENDENT_TABLE");
+        auto *idle = new RetryOrch(m_app_db.get(), "TEST_IDLE_TABLE");
+
+        OrchDaemon daemon(m_app_db.get(), m_config_db.get(), m_state_db.get(), nullptr);
+        daemon.addOrchList(producer);
+        daemon.addOrchList(dependent);
+        daemon.addOrchList(idle);
+
+        // Only the dirty Orch is drained, its task waits on the producer
+        dependent->ready = false;
+        dependent->addTask();
+        Portal::OrchDaemonInternal::doPendingTasks(daemon, false);
+        ASSERT_EQ(producer->drains, 0);
+        ASSERT_EQ(dependent->drains, 1);
+        ASSERT_EQ(idle->drains, 0);
+        ASSERT_EQ(daemon.getLastVisitedOrchs(), 1);
+        ASSERT_EQ(daemon.getLastSkippedOrchs(), 2);
+
+        // Clean Orchs are skipped, the pending task waits for a retry
+        Portal::OrchDaemonInternal::doPendingTasks(daemon, false);
+        ASSERT_EQ(dependent->drains, 1);
+        ASSERT_EQ(daemon.getLastVisitedOrchs(), 0);
+
+        // The retry drains the Orchs holding pending tasks only
+        Portal::OrchDaemonInternal::doPendingTasks(daemon, true);
+        ASSERT_EQ(dependent->drains, 2);
+        ASSERT_EQ(idle->drains, 0);
+
+        // A producer completing tasks gets the pending tasks after it retried at once
+        dependent->ready = true;
+        producer->addTask();
+        Portal::OrchDaemonInternal::doPendingTasks(daemon, false);
+        ASSERT_EQ(producer->drains, 1);
+        ASSERT_EQ(dependent->drains, 3);
+        ASSERT_FALSE(dependent->hasPendingTasks());
+        ASSERT_EQ(idle->drains, 0);
+    }
 }
@@ -109,7 +109,7 @@ namespace fdb_syncd_flush_test
 
         m_portsOrch->m_portList[alias] = vlan;
         m_portsOrch->m_port_ref_count[alias] = 0;
-        m_portsOrch->saiOidToAlias[oid] = alias;
+        m_portsOrch->saiOidToPort[oid] = &m_portsOrch->m_portList[alias];
     }
 
     void setUpPort(PortsOrch* m_portsOrch){
@@ -123,7 +123,7 @@ namespace fdb_syncd_flush_test
         port.m_hif_id = 0xd00000000056e;
 
         m_portsOrch->m_portList[alias] = port;
-        m_portsOrch->saiOidToAlias[oid] =  alias;
+        m_portsOrch->saiOidToPort[oid] = &m_portsOrch->m_portList[alias];
     }
 
     void setUpVlanMember(PortsOrch* m_portsOrch){
@@ -132,7 +132,7 @@ namespace fdb_syncd_flush_test
         
         /* Add Bridge Port */
         m_portsOrch->m_portList[ETH0].m_bridge_port_id = bridge_port_id;
-        m_portsOrch->saiOidToAlias[bridge_port_id] = ETH0;
+        m_portsOrch->saiOidToPort[bridge_port_id] = &m_portsOrch->m_portList[ETH0];
         m_portsOrch->m_portList[VLAN40].m_members.insert(ETH0);
     }
 
@@ -362,7 +362,7 @@ namespace fdb_syncd_flush_test
 
         /* Delete the bridge_port_oid in the internal OA cache */
         m_portsOrch->m_portList[ETH0].m_bridge_port_id = SAI_NULL_OBJECT_ID;
-        m_portsOrch->saiOidToAlias.erase(bridge_port_oid);
+        m_portsOrch->saiOidToPort.erase(bridge_port_oid);
 
         /* Event 2: Generate a FDB Flush per port and per vlan */
         vector<uint8_t> flush_mac_addr = {0, 0, 0, 0, 0, 0};
@@ -421,4 +421,202 @@ namespace fdb_syncd_flush_test
         ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "port", port), false);
         ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "type", entry_type), false);
     }
+
+    uint32_t removed_fdb_entries;
+    uint32_t remove_fdb_entries_calls;
+
+    sai_status_t remove_fdb_entries_counted(uint32_t object_count, const sai_fdb_entry_t *fdb_entry,
+            sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        remove_fdb_entries_calls++;
+        removed_fdb_entries += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /* Test the APP_FDB_TABLE removals of a pass are done in one bulk */
+    TEST_F(FdbOrchTest, BulkRemoveFdbEntries)
+    {
+        ASSERT_NE(m_portsOrch, nullptr);
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+        m_portsOrch->m_initDone = true;
+
+        /* Two provisioned FDB entries on Ethernet0 */
+        vector<string> macs = { "7c:fe:90:12:22:ec", "7c:fe:90:12:22:ed" };
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        for (const auto& mac : macs)
+        {
+            FdbEntry entry;
+            entry.mac = MacAddress(mac);
+            entry.bv_id = m_portsOrch->m_portList[VLAN40].m_vlan_info.vlan_oid;
+
+            FdbData fdbData;
+            fdbData.bridge_port_id = m_portsOrch->m_portList[ETH0].m_bridge_port_id;
+            fdbData.type = "static";
+            fdbData.origin = FDB_ORIGIN_PROVISIONED;
+            fdbData.vni = 0;
+            m_fdborch->m_entries.set(entry, fdbData);
+
+            entries.push_back({string(VLAN40) + ":" + mac, DEL_COMMAND, { {} }});
+        }
+        m_portsOrch->m_portList[ETH0].m_fdb_count = 2;
+        m_portsOrch->m_portList[VLAN40].m_fdb_count = 2;
+
+        removed_fdb_entries = 0;
+        remove_fdb_entries_calls = 0;
+        m_fdborch->gFdbBulker.remove_entries = remove_fdb_entries_counted;
+
+        auto consumer = dynamic_cast<Consumer *>(m_fdborch->getExecutor(APP_FDB_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(m_fdborch.get())->doTask();
+
+        /* Both entries are removed with one bulk call */
+        ASSERT_EQ(remove_fdb_entries_calls, 1);
+        ASSERT_EQ(removed_fdb_entries, 2);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_TRUE(m_fdborch->m_entries.empty());
+
+        /* Counters are updated for each entry of the bulk */
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 0);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 0);
+    }
+
+    struct FdbBatchObserver : public Observer
+    {
+        vector<FdbUpdate> updates;
+        int batches = 0;
+
+        void update(SubjectType type, void *cntx) override
+        {
+            if (type == SUBJECT_TYPE_FDB_CHANGE)
+            {
+                updates.push_back(*static_cast<FdbUpdate *>(cntx));
+            }
+            else if (type == SUBJECT_TYPE_FDB_BATCH_CHANGE)
+            {
+                auto batch = static_cast<FdbBatchUpdate *>(cntx);
+                updates.insert(updates.end(), batch->updates.begin(), batch->updates.end());
+                batches++;
+            }
+        }
+    };
+
+    /* Test the coalescing of the events of one fdb_event notification */
+    TEST_F(FdbOrchTest, BatchFdbEvents)
+    {
+        ASSERT_NE(m_portsOrch, nullptr);
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+
+        FdbBatchObserver observer;
+        m_fdborch->attach(&observer);
+
+        sai_object_id_t bridge_port_id = m_portsOrch->m_portList[ETH0].m_bridge_port_id;
+        sai_object_id_t bv_id = m_portsOrch->m_portList[VLAN40].m_vlan_info.vlan_oid;
+
+        // 7c:fe:90:12:22:ec is learnt twice, 7c:fe:90:12:22:ed is learnt and aged
+        vector<sai_fdb_event_t> types = { SAI_FDB_EVENT_LEARNED, SAI_FDB_EVENT_LEARNED,
+                                          SAI_FDB_EVENT_LEARNED, SAI_FDB_EVENT_AGED };
+        vector<uint8_t> last_bytes = { 236, 236, 237, 237 };
+
+        vector<sai_attribute_t> attrs(types.size());
+        vector<sai_fdb_event_notification_data_t> events(types.size());
+        for (size_t i = 0; i < types.size(); i++)
+        {
+            uint8_t mac_addr[] = {124, 254, 144, 18, 34, last_bytes[i]};
+            attrs[i].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+            attrs[i].value.oid = bridge_port_id;
+
+            events[i].event_type = types[i];
+            memcpy(events[i].fdb_entry.mac_address, mac_addr, sizeof(sai_mac_t));
+            events[i].fdb_entry.bv_id = bv_id;
+            events[i].attr_count = 1;
+            events[i].attr = &attrs[i];
+        }
+
+        m_fdborch->handleFdbEvents(events.data(), (uint32_t)events.size());
+
+        /* Only the first learn is applied */
+        ASSERT_EQ(m_fdborch->m_entries.size(), 1);
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 1);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 1);
+
+        string port;
+        ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "port", port), true);
+        ASSERT_EQ(port, "Ethernet0");
+        ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ed", "port", port), false);
+
+        /* The observers get a single batch */
+        ASSERT_EQ(observer.batches, 1);
+        ASSERT_EQ(observer.updates.size(), 1);
+        ASSERT_TRUE(observer.updates[0].add);
+
+        m_fdborch->detach(&observer);
+    }
+}
+
+namespace fdb_syncd_flush_test
+{
+    size_t countByBridgePort(const FdbEntryTable& table, sai_object_id_t bridge_port_id)
+    {
+        size_t count = 0;
+        table.forEachByBridgePort(bridge_port_id, [&](const FdbEntry&, const FdbData& data)
+        {
+            EXPECT_EQ(data.bridge_port_id, bridge_port_id);
+            count++;
+        });
+        return count;
+    }
+
+    size_t countByBvId(const FdbEntryTable& table, sai_object_id_t bv_id)
+    {
+        size_t count = 0;
+        table.forEachByBvId(bv_id, [&](const FdbEntry& entry, const FdbData&)
+        {
+            EXPECT_EQ(entry.bv_id, bv_id);
+            count++;
+        });
+        return count;
+    }
+
+    /* The secondary indices follow the moves and removals of the entries */
+    TEST(FdbEntryTableTest, SecondaryIndices)
+    {
+        FdbEntryTable table;
+
+        FdbEntry entry;
+        entry.mac = MacAddress("7c:fe:90:12:22:ec");
+        entry.bv_id = 0x26000000000796;
+        entry.port_name = ETH0;
+
+        FdbData fdbData;
+        fdbData.bridge_port_id = 0x3a000000002c33;
+        fdbData.type = "dynamic";
+        fdbData.origin = FDB_ORIGIN_LEARN;
+
+        table.set(entry, fdbData);
+        ASSERT_EQ(countByBridgePort(table, 0x3a000000002c33), 1);
+        ASSERT_EQ(countByBvId(table, 0x26000000000796), 1);
+
+        /* MAC move, the key keeps its port name */
+        fdbData.bridge_port_id = 0x3a000000002c34;
+        entry.port_name = "Ethernet4";
+        table.set(entry, fdbData);
+        ASSERT_EQ(table.size(), 1);
+        ASSERT_EQ(countByBridgePort(table, 0x3a000000002c33), 0);
+        ASSERT_EQ(countByBridgePort(table, 0x3a000000002c34), 1);
+        ASSERT_EQ(table.find(entry)->first.port_name, ETH0);
+
+        ASSERT_EQ(table.erase(entry), 1);
+        ASSERT_EQ(table.erase(entry), 0);
+        ASSERT_TRUE(table.empty());
+        ASSERT_EQ(countByBridgePort(table, 0x3a000000002c34), 0);
+        ASSERT_EQ(countByBvId(table, 0x26000000000796), 0);
+    }
 }
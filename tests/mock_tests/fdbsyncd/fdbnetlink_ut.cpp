@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include <string.h>
+#include <arpa/inet.h>
+#include <net/ethernet.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include "fdbsyncd/fdbnetlink.h"
+
+namespace fdbnetlink_ut
+{
+    using namespace std;
+    using namespace swss;
+
+    const unsigned int ifindex = 7;
+    const uint8_t mac[ETHER_ADDR_LEN] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+
+    struct FdbNetlinkTest : public ::testing::Test
+    {
+        struct nl_msg *msg = nullptr;
+
+        void TearDown() override
+        {
+            if (msg)
+            {
+                nlmsg_free(msg);
+            }
+        }
+
+        const struct ndmsg *ndm()
+        {
+            return static_cast<const struct ndmsg *>(nlmsg_data(nlmsg_hdr(msg)));
+        }
+
+        struct nlattr *attr(int type)
+        {
+            return nlmsg_find_attr(nlmsg_hdr(msg), sizeof(struct ndmsg), type);
+        }
+
+        void checkEntry(int vlan)
+        {
+            struct nlattr *lladdr = attr(NDA_LLADDR);
+            ASSERT_NE(lladdr, nullptr);
+            ASSERT_EQ(nla_len(lladdr), ETHER_ADDR_LEN);
+            EXPECT_EQ(memcmp(nla_data(lladdr), mac, ETHER_ADDR_LEN), 0);
+
+            struct nlattr *vid = attr(NDA_VLAN);
+            ASSERT_NE(vid, nullptr);
+            EXPECT_EQ(nla_get_u16(vid), vlan);
+
+            EXPECT_EQ(ndm()->ndm_family, PF_BRIDGE);
+            EXPECT_EQ(ndm()->ndm_ifindex, static_cast<int>(ifindex));
+        }
+
+        void checkVtep(int family, const string &vtep)
+        {
+            uint8_t addr[sizeof(struct in6_addr)];
+            ASSERT_EQ(inet_pton(family, vtep.c_str(), addr), 1);
+            size_t len = family == AF_INET ? sizeof(struct in_addr) : sizeof(struct in6_addr);
+
+            struct nlattr *dst = attr(NDA_DST);
+            ASSERT_NE(dst, nullptr);
+            ASSERT_EQ(static_cast<size_t>(nla_len(dst)), len);
+            EXPECT_EQ(memcmp(nla_data(dst), addr, len), 0);
+        }
+    };
+
+    TEST_F(FdbNetlinkTest, ReplaceFdb)
+    {
+        msg = FdbNetlink::buildMessage(RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_REPLACE, "00:11:22:33:44:55",
+                                       ifindex, "static", true, 100, "", 1);
+        ASSERT_NE(msg, nullptr);
+
+        EXPECT_EQ(nlmsg_hdr(msg)->nlmsg_type, RTM_NEWNEIGH);
+        EXPECT_EQ(nlmsg_hdr(msg)->nlmsg_flags, NLM_F_REQUEST | NLM_F_CREATE | NLM_F_REPLACE);
+        EXPECT_EQ(nlmsg_hdr(msg)->nlmsg_seq, 1u);
+        EXPECT_EQ(ndm()->ndm_flags, NTF_MASTER);
+        EXPECT_EQ(ndm()->ndm_state, NUD_NOARP | NUD_REACHABLE);
+        checkEntry(100);
+        EXPECT_EQ(attr(NDA_DST), nullptr);
+    }
+
+    TEST_F(FdbNetlinkTest, ReplaceDynamicFdb)
+    {
+        msg = FdbNetlink::buildMessage(RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_REPLACE, "00:11:22:33:44:55",
+                                       ifindex, "dynamic", true, 4095, "", 2);
+        ASSERT_NE(msg, nullptr);
+
+        EXPECT_EQ(ndm()->ndm_state, NUD_REACHABLE);
+        checkEntry(4095);
+    }
+
+    TEST_F(FdbNetlinkTest, DelFdb)
+    {
+        msg = FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44:55",
+                                       ifindex, "static", true, 100, "", 3);
+        ASSERT_NE(msg, nullptr);
+
+        EXPECT_EQ(nlmsg_hdr(msg)->nlmsg_type, RTM_DELNEIGH);
+        EXPECT_EQ(nlmsg_hdr(msg)->nlmsg_flags, NLM_F_REQUEST);
+        EXPECT_EQ(ndm()->ndm_flags, NTF_MASTER);
+        checkEntry(100);
+        EXPECT_EQ(attr(NDA_DST), nullptr);
+    }
+
+    TEST_F(FdbNetlinkTest, DelVxlanFdbIpv4Vtep)
+    {
+        msg = FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44:55",
+                                       ifindex, "", false, 200, "10.1.1.1", 4);
+        ASSERT_NE(msg, nullptr);
+
+        EXPECT_EQ(nlmsg_hdr(msg)->nlmsg_type, RTM_DELNEIGH);
+        EXPECT_EQ(ndm()->ndm_flags, NTF_SELF);
+        EXPECT_EQ(ndm()->ndm_state, NUD_NOARP);
+        checkEntry(200);
+        checkVtep(AF_INET, "10.1.1.1");
+    }
+
+    TEST_F(FdbNetlinkTest, DelVxlanFdbIpv6Vtep)
+    {
+        msg = FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44:55",
+                                       ifindex, "", false, 200, "2001:db8::1", 5);
+        ASSERT_NE(msg, nullptr);
+
+        EXPECT_EQ(ndm()->ndm_flags, NTF_SELF);
+        checkEntry(200);
+        checkVtep(AF_INET6, "2001:db8::1");
+    }
+
+    TEST_F(FdbNetlinkTest, InvalidEntry)
+    {
+        EXPECT_EQ(FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44:55",
+                                           ifindex, "", false, 200, "10.1.1", 6), nullptr);
+        EXPECT_EQ(FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44:55",
+                                           ifindex, "", false, 200, "2001:db8::1::2", 6), nullptr);
+        EXPECT_EQ(FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44",
+                                           ifindex, "static", true, 100, "", 6), nullptr);
+        EXPECT_EQ(FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44:55",
+                                           ifindex, "static", true, 0, "", 6), nullptr);
+        EXPECT_EQ(FdbNetlink::buildMessage(RTM_DELNEIGH, 0, "00:11:22:33:44:55",
+                                           ifindex, "static", true, 4096, "", 6), nullptr);
+    }
+}
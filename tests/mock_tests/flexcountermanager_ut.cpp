@@ -0,0 +1,145 @@
+#define private public // make the batch state of FlexCounterManager available
+#define protected public
+#include "flex_counter_manager.h"
+#undef protected
+#undef private
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+extern std::vector<std::string> *mockAppendedCommands;
+extern size_t mockReplyCount;
+
+namespace flexcountermanager_test
+{
+    using namespace std;
+
+    const unordered_set<string> port_stats = { "SAI_PORT_STAT_IF_IN_OCTETS" };
+
+    struct FlexCounterManagerTest : public ::testing::Test
+    {
+        vector<string> commands;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            mockAppendedCommands = &commands;
+        }
+
+        void TearDown() override
+        {
+            mockAppendedCommands = nullptr;
+            ::testing_db::reset();
+        }
+
+        size_t countCommands(const string &table)
+        {
+            size_t count = 0;
+            for (const auto &command : commands)
+            {
+                if (command.find(table + "_KEY_VALUE_OP_QUEUE") != string::npos)
+                {
+                    count++;
+                }
+            }
+            return count;
+        }
+    };
+
+    TEST_F(FlexCounterManagerTest, WritesAreSentOnCommit)
+    {
+        FlexCounterManager manager("TEST_GROUP", StatsMode::READ, 1000, false);
+
+        manager.beginBatch();
+        auto replies = mockReplyCount;
+        manager.setCounterIdList(0x1000000000001, CounterType::PORT, port_stats);
+        manager.setCounterIdList(0x1000000000002, CounterType::PORT, port_stats);
+        ASSERT_EQ(countCommands(FLEX_COUNTER_TABLE), 2u);
+        ASSERT_EQ(mockReplyCount, replies);
+
+        manager.commitBatch();
+        ASSERT_EQ(mockReplyCount, replies + 2);
+        ASSERT_EQ(manager.batch_depth, 0u);
+
+        // Out of a batch each write is sent on its own
+        manager.clearCounterIdList(0x1000000000001);
+        ASSERT_EQ(mockReplyCount, replies + 3);
+    }
+
+    TEST_F(FlexCounterManagerTest, NestedBatchesCommitOnOutermost)
+    {
+        FlexCounterManager manager("TEST_GROUP", StatsMode::READ, 1000, false);
+
+        manager.beginBatch();
+        manager.beginBatch();
+        auto replies = mockReplyCount;
+        manager.setCounterIdList(0x1000000000001, CounterType::PORT, port_stats);
+
+        manager.commitBatch();
+        ASSERT_EQ(manager.batch_depth, 1u);
+        ASSERT_EQ(mockReplyCount, replies);
+
+        manager.commitBatch();
+        ASSERT_EQ(manager.batch_depth, 0u);
+        ASSERT_EQ(mockReplyCount, replies + 1);
+
+        // A commit without batch is ignored
+        manager.commitBatch();
+        ASSERT_EQ(manager.batch_depth, 0u);
+    }
+
+    TEST_F(FlexCounterManagerTest, GroupConfigurationWrittenOncePerBatch)
+    {
+        FlexCounterManager manager("TEST_GROUP", StatsMode::READ, 1000, false);
+        commands.clear();
+
+        manager.beginBatch();
+        manager.reapplyGroupConfiguration();
+        manager.reapplyGroupConfiguration();
+        manager.reapplyGroupConfiguration();
+        ASSERT_EQ(countCommands(FLEX_COUNTER_GROUP_TABLE), 0u);
+        ASSERT_TRUE(manager.group_configuration_pending);
+
+        manager.commitBatch();
+        ASSERT_EQ(countCommands(FLEX_COUNTER_GROUP_TABLE), 1u);
+        ASSERT_FALSE(manager.group_configuration_pending);
+
+        manager.reapplyGroupConfiguration();
+        ASSERT_EQ(countCommands(FLEX_COUNTER_GROUP_TABLE), 2u);
+    }
+
+    TEST_F(FlexCounterManagerTest, FlexCounterBatchCommitsOnScopeExit)
+    {
+        FlexCounterManager port_manager("TEST_PORT_GROUP", StatsMode::READ, 1000, false);
+        FlexCounterManager queue_manager("TEST_QUEUE_GROUP", StatsMode::READ, 1000, false);
+        auto replies = mockReplyCount;
+
+        {
+            FlexCounterBatch batch({ &port_manager, &queue_manager });
+            {
+                FlexCounterBatch inner({ &port_manager });
+                port_manager.setCounterIdList(0x1000000000001, CounterType::PORT, port_stats);
+            }
+            ASSERT_EQ(port_manager.batch_depth, 1u);
+            ASSERT_EQ(queue_manager.batch_depth, 1u);
+
+            queue_manager.setCounterIdList(0x15000000000001, CounterType::QUEUE,
+                                           { "SAI_QUEUE_STAT_PACKETS" });
+            ASSERT_EQ(mockReplyCount, replies);
+        }
+
+        ASSERT_EQ(port_manager.batch_depth, 0u);
+        ASSERT_EQ(queue_manager.batch_depth, 0u);
+        ASSERT_EQ(mockReplyCount, replies + 2);
+    }
+
+    TEST_F(FlexCounterManagerTest, ManagersOfADbSharePipeline)
+    {
+        FlexCounterManager port_manager("TEST_PORT_GROUP", StatsMode::READ, 1000, false);
+        FlexCounterManager queue_manager("TEST_QUEUE_GROUP", StatsMode::READ, 1000, false);
+        FlexCounterManager gb_manager("GB_FLEX_COUNTER_DB", "TEST_GB_GROUP", StatsMode::READ, 1000, false);
+
+        ASSERT_EQ(port_manager.flex_counter_pipeline, queue_manager.flex_counter_pipeline);
+        ASSERT_NE(port_manager.flex_counter_pipeline, gb_manager.flex_counter_pipeline);
+    }
+}
@@ -0,0 +1,125 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "flushpolicyorch.h"
+#include "bulker.h"
+
+namespace flushpolicyorch_test
+{
+    using namespace std;
+
+    struct FlushPolicyOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_config_db;
+        unique_ptr<FlushPolicyOrch> m_flushPolicyOrch;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_flushPolicyOrch = unique_ptr<FlushPolicyOrch>(
+                new FlushPolicyOrch(m_config_db.get(), CFG_SAIREDIS_FLUSH_POLICY_TABLE_NAME));
+        }
+
+        void TearDown() override
+        {
+            m_flushPolicyOrch.reset();
+            ::testing_db::reset();
+        }
+
+        void setPolicy(const vector<FieldValueTuple> &fvs)
+        {
+            auto consumer = dynamic_cast<Consumer *>(m_flushPolicyOrch->getExecutor(CFG_SAIREDIS_FLUSH_POLICY_TABLE_NAME));
+            consumer->addToSync(KeyOpFieldsValuesTuple("global", SET_COMMAND, fvs));
+            static_cast<Orch *>(m_flushPolicyOrch.get())->doTask();
+        }
+    };
+
+    TEST_F(FlushPolicyOrchTest, NothingPendingWithoutOperations)
+    {
+        FlushReason reason;
+
+        ASSERT_FALSE(m_flushPolicyOrch->hasPendingOperations());
+        ASSERT_FALSE(m_flushPolicyOrch->needFlush(reason));
+        ASSERT_EQ(m_flushPolicyOrch->getSelectTimeout(1000), 1000);
+
+        // Executing timers and notifications that write nothing accounts nothing
+        m_flushPolicyOrch->addBulkerOperations();
+        ASSERT_FALSE(m_flushPolicyOrch->hasPendingOperations());
+    }
+
+    TEST_F(FlushPolicyOrchTest, BulkerOperationsArePending)
+    {
+        FlushReason reason;
+
+        bulkerCounters().add(3, sizeof(sai_route_entry_t), 6);
+        m_flushPolicyOrch->addBulkerOperations();
+        ASSERT_TRUE(m_flushPolicyOrch->hasPendingOperations());
+
+        // The select timeout is shortened to the default max_age_ms
+        ASSERT_LE(m_flushPolicyOrch->getSelectTimeout(1000), 50);
+
+        m_flushPolicyOrch->onFlush(FlushReason::FORCED);
+        ASSERT_FALSE(m_flushPolicyOrch->hasPendingOperations());
+        ASSERT_FALSE(m_flushPolicyOrch->needFlush(reason));
+        ASSERT_EQ(m_flushPolicyOrch->getSelectTimeout(1000), 1000);
+
+        // Operations already accounted are not accounted again
+        m_flushPolicyOrch->addBulkerOperations();
+        ASSERT_FALSE(m_flushPolicyOrch->hasPendingOperations());
+    }
+
+    TEST_F(FlushPolicyOrchTest, FlushOnThresholds)
+    {
+        FlushReason reason;
+
+        setPolicy({ { "max_ops", "10" }, { "max_bytes", "100" }, { "max_age_ms", "60000" } });
+
+        m_flushPolicyOrch->addOperations(9, 10);
+        ASSERT_FALSE(m_flushPolicyOrch->needFlush(reason));
+        m_flushPolicyOrch->addOperations(1, 10);
+        ASSERT_TRUE(m_flushPolicyOrch->needFlush(reason));
+        ASSERT_EQ(reason, FlushReason::OPS);
+        m_flushPolicyOrch->onFlush(reason);
+
+        m_flushPolicyOrch->addOperations(1, 100);
+        ASSERT_TRUE(m_flushPolicyOrch->needFlush(reason));
+        ASSERT_EQ(reason, FlushReason::BYTES);
+        m_flushPolicyOrch->onFlush(reason);
+
+        setPolicy({ { "max_age_ms", "0" } });
+        m_flushPolicyOrch->addOperations(1, 1);
+        ASSERT_EQ(m_flushPolicyOrch->getSelectTimeout(1000), 0);
+        ASSERT_TRUE(m_flushPolicyOrch->needFlush(reason));
+        ASSERT_EQ(reason, FlushReason::AGE);
+    }
+
+    TEST_F(FlushPolicyOrchTest, InvalidValuesAreRejected)
+    {
+        FlushReason reason;
+
+        setPolicy({ { "max_ops", "10" }, { "max_age_ms", "60000" }, { "flush_on_idle", "true" } });
+        ASSERT_TRUE(m_flushPolicyOrch->getFlushOnIdle());
+
+        // Each invalid value is ignored, the previous one is kept
+        setPolicy({ { "max_ops", "0" }, { "max_bytes", "lots" }, { "max_age_ms", "soon" }, { "flush_on_idle", "yes" } });
+        ASSERT_TRUE(m_flushPolicyOrch->getFlushOnIdle());
+
+        m_flushPolicyOrch->addOperations(9, 0);
+        ASSERT_FALSE(m_flushPolicyOrch->needFlush(reason));
+        m_flushPolicyOrch->addOperations(1, 0);
+        ASSERT_TRUE(m_flushPolicyOrch->needFlush(reason));
+        ASSERT_EQ(reason, FlushReason::OPS);
+
+        // DEL restores the defaults
+        auto consumer = dynamic_cast<Consumer *>(m_flushPolicyOrch->getExecutor(CFG_SAIREDIS_FLUSH_POLICY_TABLE_NAME));
+        consumer->addToSync(KeyOpFieldsValuesTuple("global", DEL_COMMAND, {}));
+        static_cast<Orch *>(m_flushPolicyOrch.get())->doTask();
+        ASSERT_FALSE(m_flushPolicyOrch->getFlushOnIdle());
+        if (m_flushPolicyOrch->needFlush(reason))
+        {
+            ASSERT_EQ(reason, FlushReason::AGE);
+        }
+    }
+}
@@ -1,12 +1,21 @@
 #include <stdlib.h>
 #include <hiredis/hiredis.h>
 #include <iostream>
+#include <string>
+#include <vector>
 
 // Add a global redisReply for user to mock
 redisReply *mockReply = nullptr;
 
+// Set by the user to record the commands appended to a context
+std::vector<std::string> *mockAppendedCommands = nullptr;
+
+// Number of replies read, a pipeline is flushed when its replies are read
+size_t mockReplyCount = 0;
+
 int redisGetReply(redisContext *c, void **reply)
 {
+    mockReplyCount++;
     if (mockReply == nullptr)
     {
         *reply = calloc(sizeof(redisReply), 1);
@@ -21,6 +30,10 @@ int redisGetReply(redisContext *c, void **reply)
 
 int redisAppendFormattedCommand(redisContext *c, const char *cmd, size_t len)
 {
+    if (mockAppendedCommands)
+    {
+        mockAppendedCommands->emplace_back(cmd, len);
+    }
     return 0;
 }
 
@@ -0,0 +1,76 @@
+#include "ut_helper.h"
+#include "nexthopgroupkey.h"
+
+namespace nexthopgroupkey_test
+{
+    using namespace std;
+
+    TEST(NextHopGroupKeyTest, CopiesShareInternedContents)
+    {
+        size_t interned = NextHopGroupKey::getInternedCount();
+
+        NextHopGroupKey a("192.0.2.1@Ethernet0,192.0.2.3@Ethernet4");
+        NextHopGroupKey b("192.0.2.3@Ethernet4,192.0.2.1@Ethernet0");
+        EXPECT_EQ(a, b);
+        EXPECT_EQ(a.getHash(), b.getHash());
+
+        {
+            NextHopGroupKey c = a;
+            NextHopGroupKey d = b;
+            EXPECT_EQ(&c.getNextHops(), &d.getNextHops());
+            EXPECT_EQ(NextHopGroupKey::getInternedCount(), interned + 1);
+        }
+
+        /* Contents stay interned while a and b still refer to them */
+        EXPECT_EQ(&a.getNextHops(), &b.getNextHops());
+        EXPECT_EQ(NextHopGroupKey::getInternedCount(), interned + 1);
+    }
+
+    TEST(NextHopGroupKeyTest, ReleasesUnreferencedContents)
+    {
+        size_t interned = NextHopGroupKey::getInternedCount();
+        {
+            NextHopGroupKey a("192.0.2.5@Ethernet8");
+            NextHopGroupKey b = a;
+            EXPECT_EQ(NextHopGroupKey::getInternedCount(), interned + 1);
+        }
+        EXPECT_EQ(NextHopGroupKey::getInternedCount(), interned);
+    }
+
+    TEST(NextHopGroupKeyTest, ModifyingCopyLeavesOriginalUntouched)
+    {
+        NextHopGroupKey a("192.0.2.1@Ethernet0,192.0.2.3@Ethernet4");
+        NextHopGroupKey b = a;
+
+        b.remove("192.0.2.3@Ethernet4");
+        EXPECT_EQ(a.getSize(), 2);
+        EXPECT_EQ(b.getSize(), 1);
+        EXPECT_NE(a, b);
+        EXPECT_EQ(b, NextHopGroupKey("192.0.2.1@Ethernet0"));
+        EXPECT_EQ(b.getHash(), NextHopGroupKey("192.0.2.1@Ethernet0").getHash());
+
+        b.add("192.0.2.3@Ethernet4");
+        EXPECT_EQ(a, b);
+        EXPECT_EQ(a.getHash(), b.getHash());
+        EXPECT_FALSE(a < b);
+        EXPECT_FALSE(b < a);
+    }
+
+    TEST(NextHopGroupKeyTest, WeightsAreCompared)
+    {
+        NextHopGroupKey a("192.0.2.1@Ethernet0,192.0.2.3@Ethernet4", string("1,2"));
+        NextHopGroupKey b("192.0.2.1@Ethernet0,192.0.2.3@Ethernet4", string("2,1"));
+        NextHopGroupKey c("192.0.2.1@Ethernet0,192.0.2.3@Ethernet4", string("1,2"));
+
+        EXPECT_NE(a, b);
+        EXPECT_TRUE(a < b || b < a);
+        EXPECT_EQ(a, c);
+        EXPECT_EQ(a.getHash(), c.getHash());
+
+        unordered_map<NextHopGroupKey, int, NextHopGroupKeyHash> groups;
+        groups[a] = 1;
+        groups[b] = 2;
+        EXPECT_EQ(groups.size(), 2);
+        EXPECT_EQ(groups.at(c), 1);
+    }
+}
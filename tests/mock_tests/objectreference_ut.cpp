@@ -0,0 +1,244 @@
+#include "ut_helper.h"
+#include "orch.h"
+
+#include <chrono>
+
+namespace objectreference_test
+{
+    using namespace std;
+
+    struct RefOrch : public Orch
+    {
+        RefOrch() : Orch(vector<TableConnector>())
+        {
+        }
+
+        void doTask(Consumer &consumer) override
+        {
+        }
+
+        using Orch::setObjectReference;
+        using Orch::doesObjectExist;
+        using Orch::removeObject;
+        using Orch::removeMeFromObjsReferencedByMe;
+        using Orch::isObjectBeingReferenced;
+        using Orch::resolveFieldRefValue;
+        using Orch::objectReferenceInfo;
+    };
+
+    struct ObjectReferenceTest : public ::testing::Test
+    {
+        object_reference_map m_profiles;
+        object_reference_map m_queues;
+        object_reference_map m_pgs;
+        type_map m_typeMaps;
+        RefOrch m_orch;
+
+        ObjectReferenceTest()
+        {
+            m_typeMaps[APP_BUFFER_PROFILE_TABLE_NAME] = &m_profiles;
+            m_typeMaps[APP_BUFFER_QUEUE_TABLE_NAME] = &m_queues;
+            m_typeMaps[APP_BUFFER_PG_TABLE_NAME] = &m_pgs;
+        }
+
+        static string profileRef(const string &name)
+        {
+            return string(APP_BUFFER_PROFILE_TABLE_NAME) + delimiter + name;
+        }
+    };
+
+    TEST(ObjectNameSetTest, SetInterface)
+    {
+        ObjectNameSet names;
+
+        EXPECT_TRUE(names.insert("Ethernet8:3-4"));
+        EXPECT_TRUE(names.insert("Ethernet0:3-4"));
+        EXPECT_FALSE(names.insert("Ethernet0:3-4"));
+        EXPECT_EQ(names.size(), 2);
+        EXPECT_EQ(names.count("Ethernet0:3-4"), 1);
+        EXPECT_EQ(names.count("Ethernet4:3-4"), 0);
+
+        vector<string> content(names.begin(), names.end());
+        EXPECT_EQ(content.size(), 2);
+        EXPECT_NE(find(content.begin(), content.end(), "Ethernet8:3-4"), content.end());
+
+        EXPECT_EQ(names.erase("Ethernet8:3-4"), 1);
+        EXPECT_EQ(names.erase("Ethernet8:3-4"), 0);
+        EXPECT_EQ(names.erase("never_interned_name"), 0);
+        EXPECT_EQ(*names.begin(), "Ethernet0:3-4");
+    }
+
+    TEST(ObjectNameSetTest, NamesAreReleased)
+    {
+        auto interned = ObjectNameInterner::size();
+
+        {
+            ObjectNameSet names;
+            names.insert("Ethernet1000:3-4");
+            names.insert("Ethernet1004:3-4");
+
+            ObjectNameSet copy = names;
+            EXPECT_EQ(ObjectNameInterner::size(), interned + 2);
+
+            object_name_id released_id;
+            ASSERT_TRUE(ObjectNameInterner::find("Ethernet1000:3-4", released_id));
+            names.erase("Ethernet1000:3-4");
+            EXPECT_EQ(copy.count("Ethernet1000:3-4"), 1);
+            EXPECT_EQ(ObjectNameInterner::size(), interned + 2);
+
+            // The last set holding the name releases it
+            copy.erase("Ethernet1000:3-4");
+            EXPECT_EQ(ObjectNameInterner::size(), interned + 1);
+            object_name_id id;
+            EXPECT_FALSE(ObjectNameInterner::find("Ethernet1000:3-4", id));
+
+            // The released id is reused by the next name
+            names.insert("Ethernet1008:3-4");
+            ASSERT_TRUE(ObjectNameInterner::find("Ethernet1008:3-4", id));
+            EXPECT_EQ(id, released_id);
+            EXPECT_EQ(*copy.begin(), "Ethernet1004:3-4");
+        }
+
+        EXPECT_EQ(ObjectNameInterner::size(), interned);
+    }
+
+    TEST_F(ObjectReferenceTest, SetReplaceAndRemove)
+    {
+        m_profiles["ingress_lossy_profile"].m_saiObjectId = 0x10;
+        m_profiles["egress_lossy_profile"].m_saiObjectId = 0x20;
+
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet0:0-2", "profile", profileRef("ingress_lossy_profile"));
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet4:0-2", "profile", profileRef("ingress_lossy_profile"));
+        EXPECT_EQ(m_profiles["ingress_lossy_profile"].m_objsDependingOnMe.count("Ethernet0:0-2"), 1);
+        EXPECT_EQ(m_profiles["ingress_lossy_profile"].m_objsDependingOnMe.size(), 2);
+        EXPECT_TRUE(m_orch.isObjectBeingReferenced(m_typeMaps, APP_BUFFER_PROFILE_TABLE_NAME, "ingress_lossy_profile"));
+
+        // Replace the reference of a field
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet0:0-2", "profile", profileRef("egress_lossy_profile"));
+        EXPECT_EQ(m_profiles["ingress_lossy_profile"].m_objsDependingOnMe.count("Ethernet0:0-2"), 0);
+        EXPECT_EQ(m_profiles["egress_lossy_profile"].m_objsDependingOnMe.count("Ethernet0:0-2"), 1);
+        EXPECT_EQ(m_queues["Ethernet0:0-2"].m_objsReferencingByMe["profile"], profileRef("egress_lossy_profile"));
+
+        // Remove a field through the string API
+        string referenced;
+        ASSERT_TRUE(m_orch.doesObjectExist(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet4:0-2", "profile", referenced));
+        m_orch.removeMeFromObjsReferencedByMe(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet4:0-2", "profile", referenced);
+        EXPECT_FALSE(m_orch.isObjectBeingReferenced(m_typeMaps, APP_BUFFER_PROFILE_TABLE_NAME, "ingress_lossy_profile"));
+        EXPECT_FALSE(m_orch.doesObjectExist(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet4:0-2", "profile", referenced));
+
+        m_orch.removeObject(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet0:0-2");
+        EXPECT_EQ(m_queues.count("Ethernet0:0-2"), 0);
+        EXPECT_FALSE(m_orch.isObjectBeingReferenced(m_typeMaps, APP_BUFFER_PROFILE_TABLE_NAME, "egress_lossy_profile"));
+    }
+
+    TEST_F(ObjectReferenceTest, ListOfReferences)
+    {
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_PG_TABLE_NAME, "Ethernet0", "profile_list",
+                                  profileRef("p0") + list_item_delimiter + profileRef("p1"));
+        EXPECT_EQ(m_profiles["p0"].m_objsDependingOnMe.count("Ethernet0"), 1);
+        EXPECT_EQ(m_profiles["p1"].m_objsDependingOnMe.count("Ethernet0"), 1);
+
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_PG_TABLE_NAME, "Ethernet0", "profile_list", profileRef("p1"));
+        EXPECT_EQ(m_profiles["p0"].m_objsDependingOnMe.count("Ethernet0"), 0);
+        EXPECT_EQ(m_profiles["p1"].m_objsDependingOnMe.count("Ethernet0"), 1);
+
+        m_orch.removeObject(m_typeMaps, APP_BUFFER_PG_TABLE_NAME, "Ethernet0");
+        EXPECT_TRUE(m_profiles["p1"].m_objsDependingOnMe.empty());
+    }
+
+    TEST_F(ObjectReferenceTest, NamesAreReleasedWithTheReferences)
+    {
+        auto interned = ObjectNameInterner::size();
+
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet1008:0-2", "profile", profileRef("ut_release_profile"));
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet1000:0-2", "profile", profileRef("ut_release_profile"));
+        EXPECT_EQ(ObjectNameInterner::size(), interned + 3);
+
+        // The first name is reported whatever the order the names were interned in
+        EXPECT_EQ(m_orch.objectReferenceInfo(m_typeMaps, APP_BUFFER_PROFILE_TABLE_NAME, "ut_release_profile"),
+                  string(APP_BUFFER_PROFILE_TABLE_NAME) + " ut_release_profile one object: Ethernet1000:0-2 reference count: 2");
+
+        // Removing what was never referenced interns nothing
+        m_orch.removeMeFromObjsReferencedByMe(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet1004:0-2", "profile", profileRef("ut_unknown_profile"));
+        EXPECT_EQ(ObjectNameInterner::size(), interned + 3);
+
+        m_orch.removeObject(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet1008:0-2");
+        m_orch.removeObject(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet1000:0-2");
+        EXPECT_EQ(ObjectNameInterner::size(), interned);
+    }
+
+    TEST_F(ObjectReferenceTest, ReapplySameReference)
+    {
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet0:3-4", "profile", profileRef("p0"));
+
+        // The referenced profile is recreated, the same reference is applied again
+        m_profiles.erase("p0");
+        m_profiles["p0"].m_saiObjectId = 0x30;
+        m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, "Ethernet0:3-4", "profile", profileRef("p0"));
+        EXPECT_EQ(m_profiles["p0"].m_objsDependingOnMe.count("Ethernet0:3-4"), 1);
+    }
+
+    /*
+     * BUFFER_QUEUE/BUFFER_PG churn through the string API only, so that the
+     * same test can be run against any version of the reference graph.
+     */
+    TEST_F(ObjectReferenceTest, DISABLED_BenchmarkBufferChurn)
+    {
+        const size_t ports = 512;
+        const size_t profiles = 2;
+        const size_t rounds = 20;
+
+        vector<string> profileRefs;
+        for (size_t i = 0; i < profiles; i++)
+        {
+            string name = "pg_lossless_" + to_string(i) + "_profile";
+            m_profiles[name].m_saiObjectId = i + 1;
+            profileRefs.push_back(profileRef(name));
+        }
+
+        vector<string> queues;
+        vector<string> pgs;
+        for (size_t i = 0; i < ports; i++)
+        {
+            string port = "Ethernet" + to_string(i * 4);
+            queues.push_back(port + ":0-2");
+            queues.push_back(port + ":3-4");
+            queues.push_back(port + ":5-7");
+            pgs.push_back(port + ":0");
+            pgs.push_back(port + ":3-4");
+        }
+
+        auto start = chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; round++)
+        {
+            for (size_t i = 0; i < queues.size(); i++)
+            {
+                m_orch.setObjectReference(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, queues[i], "profile", profileRefs[(i + round) % profiles]);
+            }
+            for (size_t i = 0; i < pgs.size(); i++)
+            {
+                m_orch.setObjectReference(m_typeMaps, APP_BUFFER_PG_TABLE_NAME, pgs[i], "profile", profileRefs[(i + round) % profiles]);
+            }
+            if (round % 2)
+            {
+                for (auto &queue : queues)
+                {
+                    m_orch.removeObject(m_typeMaps, APP_BUFFER_QUEUE_TABLE_NAME, queue);
+                }
+                for (auto &pg : pgs)
+                {
+                    m_orch.removeObject(m_typeMaps, APP_BUFFER_PG_TABLE_NAME, pg);
+                }
+            }
+        }
+        auto elapsed = chrono::steady_clock::now() - start;
+
+        for (auto &profile : m_profiles)
+        {
+            EXPECT_TRUE(profile.second.m_objsDependingOnMe.empty());
+        }
+
+        cout << "buffer reference churn: " << rounds * (queues.size() + pgs.size()) << " references in "
+             << chrono::duration_cast<chrono::milliseconds>(elapsed).count() << " ms" << endl;
+    }
+}
@@ -8,6 +8,9 @@
 #include "copporch.h"
 #include "sfloworch.h"
 #include "directory.h"
+#include "neighorch.h"
+#include "fdborch.h"
+#include "orchdaemon.h"
 
 #undef protected
 #undef private
@@ -101,6 +104,38 @@ struct Portal
         }
     };
 
+    struct OrchInternal
+    {
+        static const ConsumerMap &getConsumerMap(const Orch *orch)
+        {
+            return orch->m_consumerMap;
+        }
+    };
+
+    struct NeighOrchInternal
+    {
+        static void setNextHopId(NeighOrch *neighOrch, const NextHopKey &nexthop, sai_object_id_t next_hop_id)
+        {
+            neighOrch->m_syncdNextHops[nexthop].next_hop_id = next_hop_id;
+        }
+    };
+
+    struct FdbOrchInternal
+    {
+        static void handleFdbEvents(FdbOrch *fdbOrch, const sai_fdb_event_notification_data_t *events, uint32_t count)
+        {
+            fdbOrch->handleFdbEvents(events, count);
+        }
+    };
+
+    struct OrchDaemonInternal
+    {
+        static void doPendingTasks(OrchDaemon &daemon, bool retry)
+        {
+            daemon.doPendingTasks(retry);
+        }
+    };
+
     struct DirectoryInternal
     {
         template <typename T>
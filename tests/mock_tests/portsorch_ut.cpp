@@ -14,6 +14,7 @@
 #include <sstream>
 
 extern redisReply *mockReply;
+extern size_t gMaxBulkSize;
 
 namespace portsorch_test
 {
@@ -839,6 +840,10 @@ namespace portsorch_test
             }
         );
 
+        // LAG members are created by the bulker, create them one by one through the spy
+        gPortsOrch->gLagMemberBulker = ObjectBulker<sai_lag_api_t>(sai_lag_api, gSwitchId, gMaxBulkSize);
+        gPortsOrch->gLagMemberBulker.create_entries = nullptr;
+
         gPortsOrch->addExistingData(&lagMemberTable);
 
         static_cast<Orch *>(gPortsOrch)->doTask();
@@ -1062,6 +1067,11 @@ namespace portsorch_test
             }
         );
 
+        // LAG members and bridge ports are created by the bulkers, create them one by one through the spies
+        gPortsOrch->gLagMemberBulker = ObjectBulker<sai_lag_api_t>(sai_lag_api, gSwitchId, gMaxBulkSize);
+        gPortsOrch->gLagMemberBulker.create_entries = nullptr;
+        gPortsOrch->gBridgePortBulker = ObjectBulker<sai_bridge_api_t>(sai_bridge_api, gSwitchId, gMaxBulkSize);
+
         static_cast<Orch *>(gPortsOrch)->doTask();
 
         vector<string> ts;
@@ -1083,4 +1093,216 @@ namespace portsorch_test
 
         ASSERT_FALSE(bridgePortCalledBeforeLagMember); // bridge port created on lag before lag member was created
     }
+
+    /*
+     * The scope of this test is to verify that the VLAN members of several
+     * VLANs and ports are created in one bulk: each port gets a single
+     * bridge port and every member is recorded on its VLAN and port.
+     */
+    TEST_F(PortsOrchTest, VlanMembersAreCreatedInBulk)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table vlanTable = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+        Table vlanMemberTable = Table(m_app_db.get(), APP_VLAN_MEMBER_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Populate pot table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        // 2 VLANs with the same 4 ports, untagged in the first one
+        vector<string> members;
+        for (auto it = ports.begin(); it != ports.end() && members.size() < 4; it++)
+        {
+            members.push_back(it->first);
+        }
+
+        for (auto vlan : {"Vlan5", "Vlan6"})
+        {
+            vlanTable.set(vlan, { {"admin_status", "up"}, {"mtu", "9100"} });
+            for (const auto &member : members)
+            {
+                vlanMemberTable.set(
+                    std::string(vlan) + vlanMemberTable.getTableNameSeparator() + member,
+                    { {"tagging_mode", std::string(vlan) == "Vlan5" ? "untagged" : "tagged"} });
+            }
+        }
+
+        // save original api since we will spy
+        auto orig_bridge_api = sai_bridge_api;
+        sai_bridge_api = new sai_bridge_api_t();
+        memcpy(sai_bridge_api, orig_bridge_api, sizeof(*sai_bridge_api));
+
+        uint32_t bridgePortCount = 0;
+        auto bridgeSpy = SpyOn<SAI_API_BRIDGE, SAI_OBJECT_TYPE_BRIDGE_PORT>(&sai_bridge_api->create_bridge_port);
+        bridgeSpy->callFake([&](sai_object_id_t *oid, sai_object_id_t swoid, uint32_t count, const sai_attribute_t * attrs) -> sai_status_t {
+                bridgePortCount++;
+                return orig_bridge_api->create_bridge_port(oid, swoid, count, attrs);
+            }
+        );
+        gPortsOrch->gBridgePortBulker = ObjectBulker<sai_bridge_api_t>(sai_bridge_api, gSwitchId, gMaxBulkSize);
+
+        gPortsOrch->addExistingData(&vlanTable);
+        gPortsOrch->addExistingData(&vlanMemberTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        gPortsOrch->gBridgePortBulker = ObjectBulker<sai_bridge_api_t>(orig_bridge_api, gSwitchId, gMaxBulkSize);
+        delete sai_bridge_api;
+        sai_bridge_api = orig_bridge_api;
+
+        for (auto tableName: {APP_VLAN_TABLE_NAME, APP_VLAN_MEMBER_TABLE_NAME})
+        {
+            vector<string> ts;
+            auto exec = gPortsOrch->getExecutor(tableName);
+            auto consumer = static_cast<Consumer*>(exec);
+            consumer->dumpPendingTasks(ts);
+            ASSERT_TRUE(ts.empty());
+        }
+
+        // One bridge port per port, shared by the members of both VLANs
+        ASSERT_EQ(bridgePortCount, members.size());
+
+        for (auto vlanAlias : {"Vlan5", "Vlan6"})
+        {
+            Port vlan;
+            ASSERT_TRUE(gPortsOrch->getPort(vlanAlias, vlan));
+            ASSERT_EQ(vlan.m_members.size(), members.size());
+        }
+
+        for (const auto &member : members)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(member, port));
+            ASSERT_NE(port.m_bridge_port_id, SAI_NULL_OBJECT_ID);
+            ASSERT_EQ(port.m_port_vlan_id, 5);
+            ASSERT_EQ(gPortsOrch->m_portVlanMember[member].size(), 2u);
+            ASSERT_NE(gPortsOrch->m_portVlanMember[member][5].vlan_member_id, SAI_NULL_OBJECT_ID);
+            ASSERT_NE(gPortsOrch->m_portVlanMember[member][6].vlan_member_id, SAI_NULL_OBJECT_ID);
+        }
+    }
+
+    TEST_F(PortsOrchTest, FindPortReturnsPortListEntry)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table vlanTable = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+        Table vlanMemberTable = Table(m_app_db.get(), APP_VLAN_MEMBER_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Populate pot table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        vlanTable.set("Vlan5", { {"admin_status", "up"}, {"mtu", "9100"} });
+        vlanMemberTable.set("Vlan5" + vlanMemberTable.getTableNameSeparator() + "Ethernet0", { {"tagging_mode", "untagged"} });
+
+        gPortsOrch->addExistingData(&portTable);
+        gPortsOrch->addExistingData(&vlanTable);
+        gPortsOrch->addExistingData(&vlanMemberTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        const Port *port = gPortsOrch->findPort("Ethernet0");
+        ASSERT_EQ(port, &gPortsOrch->m_portList["Ethernet0"]);
+        ASSERT_EQ(gPortsOrch->findPort(port->m_port_id), port);
+        ASSERT_EQ(gPortsOrch->findPort(port->m_bridge_port_id), port);
+
+        const Port *vlan = gPortsOrch->findPort("Vlan5");
+        ASSERT_NE(vlan, nullptr);
+        ASSERT_EQ(gPortsOrch->findPort(vlan->m_vlan_info.vlan_oid), vlan);
+
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet12345"), nullptr);
+        ASSERT_EQ(gPortsOrch->findPort(SAI_NULL_OBJECT_ID), nullptr);
+
+        // The FDB counter is updated in place
+        ASSERT_TRUE(gPortsOrch->incrFdbCount("Ethernet0", 2));
+        ASSERT_EQ(port->m_fdb_count, 2u);
+        ASSERT_TRUE(gPortsOrch->decrFdbCount("Ethernet0", 1));
+        ASSERT_EQ(port->m_fdb_count, 1u);
+        ASSERT_FALSE(gPortsOrch->incrFdbCount("Ethernet12345", 1));
+    }
+
+    TEST_F(PortsOrchTest, PortsAreInitializedInPhases)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table timingTable = Table(m_state_db.get(), "PORT_INIT_TIMING");
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Populate pot table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+
+        // save original apis since we will spy
+        auto orig_port_api = sai_port_api;
+        sai_port_api = new sai_port_api_t();
+        memcpy(sai_port_api, orig_port_api, sizeof(*sai_port_api));
+        auto orig_hostif_api = sai_hostif_api;
+        sai_hostif_api = new sai_hostif_api_t();
+        memcpy(sai_hostif_api, orig_hostif_api, sizeof(*sai_hostif_api));
+
+        // Record the order of the port gets and host interface creates
+        string calls;
+        auto portSpy = SpyOn<SAI_API_PORT, SAI_OBJECT_TYPE_PORT>(&sai_port_api->get_port_attribute);
+        portSpy->callFake([&](sai_object_id_t oid, uint32_t count, sai_attribute_t * attrs) -> sai_status_t {
+                calls += "g";
+                return orig_port_api->get_port_attribute(oid, count, attrs);
+            }
+        );
+        auto hostifSpy = SpyOn<SAI_API_HOSTIF, SAI_OBJECT_TYPE_HOSTIF>(&sai_hostif_api->create_hostif);
+        hostifSpy->callFake([&](sai_object_id_t *oid, sai_object_id_t swoid, uint32_t count, const sai_attribute_t * attrs) -> sai_status_t {
+                calls += "c";
+                return orig_hostif_api->create_hostif(oid, swoid, count, attrs);
+            }
+        );
+
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        delete sai_port_api;
+        sai_port_api = orig_port_api;
+        delete sai_hostif_api;
+        sai_hostif_api = orig_hostif_api;
+
+        // All the host interfaces are created back to back
+        auto first = calls.find('c');
+        ASSERT_NE(first, string::npos);
+        ASSERT_EQ(calls.substr(first, ports.size()), string(ports.size(), 'c'));
+        ASSERT_EQ(calls.find('c', first + ports.size()), string::npos);
+
+        for (const auto &it : ports)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(it.first, port));
+            ASSERT_TRUE(port.m_init);
+            ASSERT_NE(port.m_hif_id, SAI_NULL_OBJECT_ID);
+        }
+
+        string count;
+        ASSERT_TRUE(timingTable.hget("boot", "ports", count));
+        ASSERT_EQ(count, to_string(ports.size()));
+    }
 }
@@ -0,0 +1,107 @@
+#include "ut_helper.h"
+#include "prefixtrie.h"
+
+#include <map>
+#include <random>
+#include <set>
+
+namespace prefixtrie_test
+{
+    using namespace std;
+
+    TEST(PrefixTrieTest, LongestMatch)
+    {
+        PrefixTrie<int> trie;
+        EXPECT_TRUE(trie.insert(IpPrefix("0.0.0.0/0"), 0));
+        EXPECT_TRUE(trie.insert(IpPrefix("10.0.0.0/8"), 8));
+        EXPECT_TRUE(trie.insert(IpPrefix("10.1.0.0/16"), 16));
+        EXPECT_TRUE(trie.insert(IpPrefix("10.1.2.0/24"), 24));
+        EXPECT_FALSE(trie.insert(IpPrefix("10.1.0.0/16"), 160));
+        EXPECT_EQ(trie.size(), 4u);
+
+        EXPECT_EQ(*trie.longestMatch(IpAddress("10.1.2.3")), 24);
+        EXPECT_EQ(*trie.longestMatch(IpAddress("10.1.3.3")), 160);
+        EXPECT_EQ(*trie.longestMatch(IpAddress("11.0.0.1")), 0);
+        EXPECT_EQ(trie.longestMatch(IpAddress("2001:db8::1")), nullptr);
+        EXPECT_EQ(*trie.find(IpPrefix("10.0.0.0/8")), 8);
+        EXPECT_EQ(trie.find(IpPrefix("10.0.0.0/9")), nullptr);
+
+        vector<int> covering;
+        trie.forEachCovering(IpAddress("10.1.2.3"), [&covering](int value) { covering.push_back(value); });
+        EXPECT_EQ(covering, vector<int>({ 0, 8, 160, 24 }));
+
+        EXPECT_TRUE(trie.erase(IpPrefix("10.1.0.0/16")));
+        EXPECT_FALSE(trie.erase(IpPrefix("10.1.0.0/16")));
+        EXPECT_EQ(*trie.longestMatch(IpAddress("10.1.3.3")), 8);
+        EXPECT_EQ(trie.size(), 3u);
+    }
+
+    TEST(PrefixTrieTest, HostsWithinPrefix)
+    {
+        PrefixTrie<int> trie;
+        trie.insert(IpAddress("192.0.2.1"), 1);
+        trie.insert(IpAddress("192.0.2.130"), 2);
+        trie.insert(IpAddress("198.51.100.1"), 3);
+        trie.insert(IpAddress("2001:db8::1"), 4);
+
+        auto within = [&trie](const string &prefix) {
+            set<int> values;
+            trie.forEachWithin(IpPrefix(prefix), [&values](int value) { values.insert(value); });
+            return values;
+        };
+        EXPECT_EQ(within("192.0.2.0/24"), set<int>({ 1, 2 }));
+        EXPECT_EQ(within("192.0.2.128/25"), set<int>({ 2 }));
+        EXPECT_EQ(within("192.0.2.1/32"), set<int>({ 1 }));
+        EXPECT_EQ(within("0.0.0.0/0"), set<int>({ 1, 2, 3 }));
+        EXPECT_EQ(within("2001:db8::/32"), set<int>({ 4 }));
+        EXPECT_TRUE(within("203.0.113.0/24").empty());
+
+        EXPECT_TRUE(trie.erase(IpAddress("192.0.2.1")));
+        EXPECT_EQ(within("192.0.2.0/24"), set<int>({ 2 }));
+    }
+
+    TEST(PrefixTrieTest, MatchesLinearScan)
+    {
+        mt19937 rng(1);
+        PrefixTrie<int> trie;
+        map<IpPrefix, int> prefixes;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            uint32_t length = static_cast<uint32_t>(rng() % 33);
+            uint32_t address = static_cast<uint32_t>(rng() & 0xfff0ff00u) & (length ? 0xffffffffu << (32 - length) : 0);
+            IpPrefix prefix(IpAddress(htonl(address)).to_string() + "/" + to_string(length));
+            if (rng() % 3 == 0)
+            {
+                EXPECT_EQ(trie.erase(prefix), prefixes.erase(prefix) == 1);
+            }
+            else
+            {
+                EXPECT_EQ(trie.insert(prefix, i), prefixes.find(prefix) == prefixes.end());
+                prefixes[prefix] = i;
+            }
+        }
+        EXPECT_EQ(trie.size(), prefixes.size());
+
+        for (int i = 0; i < 500; i++)
+        {
+            IpAddress address(htonl(static_cast<uint32_t>(rng() & 0xfff0ffffu)));
+            const IpPrefix *best = nullptr;
+            for (auto &prefix : prefixes)
+            {
+                if (prefix.first.isAddressInSubnet(address) &&
+                    (!best || prefix.first.getMaskLength() > best->getMaskLength()))
+                {
+                    best = &prefix.first;
+                }
+            }
+
+            auto match = trie.longestMatch(address);
+            ASSERT_EQ(match != nullptr, best != nullptr);
+            if (best)
+            {
+                EXPECT_EQ(*match, prefixes[*best]);
+            }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#include "ut_helper.h"
+#include "recorder.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+namespace recorder_test
+{
+    using namespace std;
+
+    struct RecorderTest : public ::testing::Test
+    {
+        string m_file;
+        ofstream m_ofs;
+
+        void SetUp() override
+        {
+            m_file = "/tmp/recorder_ut." + to_string(getpid()) + ".rec";
+            remove(m_file.c_str());
+            remove((m_file + ".1").c_str());
+            m_ofs.open(m_file, ofstream::out | ofstream::trunc);
+            ASSERT_TRUE(m_ofs.is_open());
+        }
+
+        void TearDown() override
+        {
+            if (m_ofs.is_open())
+            {
+                m_ofs.close();
+            }
+            remove(m_file.c_str());
+            remove((m_file + ".1").c_str());
+        }
+
+        /* Return the records of a file without their timestamps */
+        vector<string> readRecords(const string &file)
+        {
+            vector<string> records;
+            ifstream ifs(file);
+            string line;
+
+            while (getline(ifs, line))
+            {
+                auto pos = line.find('|');
+                records.push_back(pos == string::npos ? line : line.substr(pos + 1));
+            }
+            return records;
+        }
+    };
+
+    TEST_F(RecorderTest, RecordsInOrderAndFlushesOnStop)
+    {
+        Recorder recorder(m_ofs, m_file);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            recorder.record("record " + to_string(i));
+        }
+
+        // Nothing may be lost between the last wakeup of the writer and stop()
+        recorder.stop();
+
+        auto records = readRecords(m_file);
+        ASSERT_EQ(records.size(), 1000);
+        for (int i = 0; i < 1000; i++)
+        {
+            ASSERT_EQ(records[i], "record " + to_string(i));
+        }
+        ASSERT_EQ(recorder.getDroppedCount(), 0);
+
+        // Recording again restarts the writer
+        recorder.record("record 1000");
+        recorder.stop();
+
+        records = readRecords(m_file);
+        ASSERT_EQ(records.size(), 1001);
+        ASSERT_EQ(records.back(), "record 1000");
+    }
+
+    TEST_F(RecorderTest, ReopenAfterRotate)
+    {
+        Recorder recorder(m_ofs, m_file);
+
+        recorder.record("before rotate");
+
+        // logrotate moves the file away, the writer creates a new one on reopen
+        ASSERT_EQ(rename(m_file.c_str(), (m_file + ".1").c_str()), 0);
+        recorder.reopen();
+
+        for (int i = 0; i < 100 && access(m_file.c_str(), F_OK) != 0; i++)
+        {
+            usleep(10 * 1000);
+        }
+        ASSERT_EQ(access(m_file.c_str(), F_OK), 0);
+
+        recorder.record("after rotate");
+        recorder.stop();
+
+        auto rotated = readRecords(m_file + ".1");
+        ASSERT_EQ(rotated.size(), 1);
+        ASSERT_EQ(rotated[0], "before rotate");
+
+        auto records = readRecords(m_file);
+        ASSERT_EQ(records.size(), 1);
+        ASSERT_EQ(records[0], "after rotate");
+    }
+
+    TEST_F(RecorderTest, DroppedRecordsAreAccounted)
+    {
+        Recorder recorder(m_ofs, m_file, ofstream::out | ofstream::app, 4);
+
+        for (int i = 0; i < 10000; i++)
+        {
+            recorder.record("record " + to_string(i));
+        }
+        recorder.stop();
+
+        // Every record is either written, in order, or counted as dropped
+        size_t written = 0;
+        int last = -1;
+        for (const auto &record : readRecords(m_file))
+        {
+            if (record.find("recorder dropped") == 0)
+            {
+                continue;
+            }
+
+            int i = stoi(record.substr(record.find(' ') + 1));
+            ASSERT_GT(i, last);
+            last = i;
+            written++;
+        }
+        ASSERT_EQ(written + recorder.getDroppedCount(), 10000);
+    }
+}
@@ -0,0 +1,1145 @@
+/*
+ * Offline orchagent benchmark.
+ *
+ * Replays a swss.rec recording, or a synthetic workload of routes,
+ * neighbors, FDB entries and ACL rules, through the real Orch classes on
+ * top of the mocked redis tables and the virtual SAI, and reports the
+ * throughput, the per entry latency, the SAI calls, the bulk batch sizes
+ * and the peak RSS.
+ *
+ * Records are fed to the consumers as fast as possible in batches of
+ * gBatchSize, the timestamps of the recording are not honored. The latency
+ * of an entry is the time from its addToSync() to the end of the drain()
+ * which completed it, entries waiting on a dependency (e.g. routes on their
+ * neighbors) are retried when the replay moves to another table.
+ *
+ * The CPU time of the thread running the Orchs is reported next to the wall
+ * clock time, so that work moved to helper threads (-P) shows up.
+ *
+ * With -x, the routes of a next hop are then moved to another next hop and
+ * the time RouteOrch takes to repair them is reported, with or without the
+ * next hop groups shared by the single path routes (-c).
+ */
+
+#include "portal.h"
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "aclorch.h"
+#include "tokenize.h"
+
+#include <getopt.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+extern AclOrch *gAclOrch;
+extern PolicerOrch *gPolicerOrch;
+extern sai_fdb_api_t *sai_fdb_api;
+extern sai_next_hop_group_api_t *sai_next_hop_group_api;
+extern sai_mirror_api_t *sai_mirror_api;
+extern uint32_t gParseThreads;
+extern bool gRoutePic;
+
+using namespace std;
+using namespace swss;
+
+namespace replay_bench
+{
+    typedef chrono::steady_clock::time_point time_point;
+
+    struct Options
+    {
+        string recordFile;
+        set<string> tables;
+        size_t routes = 10000;
+        size_t neighbors = 1000;
+        size_t fdbs = 1000;
+        size_t learns = 0;
+        size_t aclRules = 100;
+        size_t ecmpWidth = 1;
+        size_t portStride = 4;
+        uint32_t parseThreads = 0;
+        bool repair = false;
+        bool pic = false;
+    };
+
+    static chrono::nanoseconds threadCpuTime()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return chrono::seconds(ts.tv_sec) + chrono::nanoseconds(ts.tv_nsec);
+    }
+
+    /*
+     * SAI calls are counted by replacing the functions of the API tables
+     * with templated trampolines, before the Orchs (and their bulkers)
+     * capture the function pointers.
+     */
+    struct SaiCallStats
+    {
+        string name;
+        bool bulk;
+        uint64_t calls = 0;
+        uint64_t objects = 0;
+        uint64_t maxBatch = 0;
+        StatsHistogram batchSizes;
+
+        SaiCallStats(const string &name, bool bulk) : name(name), bulk(bulk)
+        {
+        }
+
+        void onCall(uint32_t count)
+        {
+            calls++;
+            objects += count;
+            maxBatch = max<uint64_t>(maxBatch, count);
+            batchSizes.add(count);
+        }
+    };
+
+    static deque<SaiCallStats> &saiCallStats()
+    {
+        static deque<SaiCallStats> stats;
+        return stats;
+    }
+
+    template <int id, typename R, typename... Args>
+    struct SaiCallCounter
+    {
+        static R (*original)(Args...);
+        static SaiCallStats *stats;
+
+        static R call(Args... args)
+        {
+            stats->onCall(1);
+            return original(args...);
+        }
+    };
+
+    template <int id, typename R, typename... Args>
+    R (*SaiCallCounter<id, R, Args...>::original)(Args...);
+    template <int id, typename R, typename... Args>
+    SaiCallStats *SaiCallCounter<id, R, Args...>::stats;
+
+    /* Bulk functions taking the object count first */
+    template <int id, typename R, typename... Args>
+    struct SaiBulkCallCounter
+    {
+        static R (*original)(uint32_t, Args...);
+        static SaiCallStats *stats;
+
+        static R call(uint32_t count, Args... args)
+        {
+            stats->onCall(count);
+            return original(count, args...);
+        }
+    };
+
+    template <int id, typename R, typename... Args>
+    R (*SaiBulkCallCounter<id, R, Args...>::original)(uint32_t, Args...);
+    template <int id, typename R, typename... Args>
+    SaiCallStats *SaiBulkCallCounter<id, R, Args...>::stats;
+
+    /* Bulk object creation, taking the switch id and then the object count */
+    template <int id, typename R, typename... Args>
+    struct SaiOidBulkCallCounter
+    {
+        static R (*original)(sai_object_id_t, uint32_t, Args...);
+        static SaiCallStats *stats;
+
+        static R call(sai_object_id_t switch_id, uint32_t count, Args... args)
+        {
+            stats->onCall(count);
+            return original(switch_id, count, args...);
+        }
+    };
+
+    template <int id, typename R, typename... Args>
+    R (*SaiOidBulkCallCounter<id, R, Args...>::original)(sai_object_id_t, uint32_t, Args...);
+    template <int id, typename R, typename... Args>
+    SaiCallStats *SaiOidBulkCallCounter<id, R, Args...>::stats;
+
+    template <int id, typename R, typename... Args>
+    void countSaiCalls(R (**fn)(Args...), const char *name)
+    {
+        typedef SaiCallCounter<id, R, Args...> Counter;
+        if (*fn == nullptr)
+        {
+            return;
+        }
+        saiCallStats().emplace_back(name, false);
+        Counter::stats = &saiCallStats().back();
+        Counter::original = *fn;
+        *fn = Counter::call;
+    }
+
+    template <int id, typename R, typename... Args>
+    void countSaiBulkCalls(R (**fn)(uint32_t, Args...), const char *name)
+    {
+        typedef SaiBulkCallCounter<id, R, Args...> Counter;
+        if (*fn == nullptr)
+        {
+            return;
+        }
+        saiCallStats().emplace_back(name, true);
+        Counter::stats = &saiCallStats().back();
+        Counter::original = *fn;
+        *fn = Counter::call;
+    }
+
+    template <int id, typename R, typename... Args>
+    void countSaiOidBulkCalls(R (**fn)(sai_object_id_t, uint32_t, Args...), const char *name)
+    {
+        typedef SaiOidBulkCallCounter<id, R, Args...> Counter;
+        if (*fn == nullptr)
+        {
+            return;
+        }
+        saiCallStats().emplace_back(name, true);
+        Counter::stats = &saiCallStats().back();
+        Counter::original = *fn;
+        *fn = Counter::call;
+    }
+
+#define COUNT_SAI_CALLS(api, fn) countSaiCalls<__LINE__>(&(api)->fn, #fn)
+#define COUNT_SAI_BULK_CALLS(api, fn) countSaiBulkCalls<__LINE__>(&(api)->fn, #fn)
+#define COUNT_SAI_OID_BULK_CALLS(api, fn) countSaiOidBulkCalls<__LINE__>(&(api)->fn, #fn)
+
+    static void countSaiApiCalls()
+    {
+        COUNT_SAI_CALLS(sai_route_api, create_route_entry);
+        COUNT_SAI_CALLS(sai_route_api, remove_route_entry);
+        COUNT_SAI_CALLS(sai_route_api, set_route_entry_attribute);
+        COUNT_SAI_BULK_CALLS(sai_route_api, create_route_entries);
+        COUNT_SAI_BULK_CALLS(sai_route_api, remove_route_entries);
+        COUNT_SAI_BULK_CALLS(sai_route_api, set_route_entries_attribute);
+
+        COUNT_SAI_CALLS(sai_mpls_api, create_inseg_entry);
+        COUNT_SAI_CALLS(sai_mpls_api, remove_inseg_entry);
+        COUNT_SAI_BULK_CALLS(sai_mpls_api, create_inseg_entries);
+        COUNT_SAI_BULK_CALLS(sai_mpls_api, remove_inseg_entries);
+        COUNT_SAI_BULK_CALLS(sai_mpls_api, set_inseg_entries_attribute);
+
+        COUNT_SAI_CALLS(sai_neighbor_api, create_neighbor_entry);
+        COUNT_SAI_CALLS(sai_neighbor_api, remove_neighbor_entry);
+        COUNT_SAI_CALLS(sai_neighbor_api, set_neighbor_entry_attribute);
+        COUNT_SAI_BULK_CALLS(sai_neighbor_api, create_neighbor_entries);
+        COUNT_SAI_BULK_CALLS(sai_neighbor_api, remove_neighbor_entries);
+        COUNT_SAI_BULK_CALLS(sai_neighbor_api, set_neighbor_entries_attribute);
+
+        COUNT_SAI_CALLS(sai_next_hop_api, create_next_hop);
+        COUNT_SAI_CALLS(sai_next_hop_api, remove_next_hop);
+        COUNT_SAI_OID_BULK_CALLS(sai_next_hop_api, create_next_hops);
+        COUNT_SAI_BULK_CALLS(sai_next_hop_api, remove_next_hops);
+
+        COUNT_SAI_CALLS(sai_next_hop_group_api, create_next_hop_group);
+        COUNT_SAI_CALLS(sai_next_hop_group_api, remove_next_hop_group);
+        COUNT_SAI_CALLS(sai_next_hop_group_api, create_next_hop_group_member);
+        COUNT_SAI_CALLS(sai_next_hop_group_api, remove_next_hop_group_member);
+        COUNT_SAI_OID_BULK_CALLS(sai_next_hop_group_api, create_next_hop_group_members);
+        COUNT_SAI_BULK_CALLS(sai_next_hop_group_api, remove_next_hop_group_members);
+
+        COUNT_SAI_CALLS(sai_router_intfs_api, create_router_interface);
+        COUNT_SAI_CALLS(sai_router_intfs_api, remove_router_interface);
+
+        COUNT_SAI_CALLS(sai_bridge_api, create_bridge_port);
+        COUNT_SAI_CALLS(sai_bridge_api, remove_bridge_port);
+
+        COUNT_SAI_CALLS(sai_vlan_api, create_vlan_member);
+        COUNT_SAI_CALLS(sai_vlan_api, remove_vlan_member);
+        COUNT_SAI_OID_BULK_CALLS(sai_vlan_api, create_vlan_members);
+        COUNT_SAI_BULK_CALLS(sai_vlan_api, remove_vlan_members);
+
+        COUNT_SAI_CALLS(sai_lag_api, create_lag_member);
+        COUNT_SAI_CALLS(sai_lag_api, remove_lag_member);
+        COUNT_SAI_OID_BULK_CALLS(sai_lag_api, create_lag_members);
+        COUNT_SAI_BULK_CALLS(sai_lag_api, remove_lag_members);
+
+        COUNT_SAI_CALLS(sai_fdb_api, create_fdb_entry);
+        COUNT_SAI_CALLS(sai_fdb_api, remove_fdb_entry);
+        COUNT_SAI_BULK_CALLS(sai_fdb_api, create_fdb_entries);
+        COUNT_SAI_BULK_CALLS(sai_fdb_api, remove_fdb_entries);
+        COUNT_SAI_BULK_CALLS(sai_fdb_api, set_fdb_entries_attribute);
+
+        COUNT_SAI_CALLS(sai_acl_api, create_acl_entry);
+        COUNT_SAI_CALLS(sai_acl_api, remove_acl_entry);
+        COUNT_SAI_CALLS(sai_acl_api, create_acl_counter);
+        COUNT_SAI_CALLS(sai_acl_api, remove_acl_counter);
+    }
+
+    /* Replayed entries of one consumer */
+    struct ConsumerBench
+    {
+        Consumer *consumer;
+        /* Entries not completed yet, with the time they were added */
+        unordered_map<string, time_point> inflight;
+        vector<uint64_t> latencies;
+        size_t records = 0;
+        chrono::steady_clock::duration busy { 0 };
+        chrono::nanoseconds cpu { 0 };
+    };
+
+    struct ReplayRecord
+    {
+        ConsumerBench *bench;
+        KeyOpFieldsValuesTuple entry;
+    };
+
+    class Replay
+    {
+    public:
+        Replay(const vector<Orch *> &orchs)
+        {
+            for (auto orch : orchs)
+            {
+                for (auto &executor : Portal::OrchInternal::getConsumerMap(orch))
+                {
+                    auto consumer = dynamic_cast<Consumer *>(executor.second.get());
+                    if (consumer && m_benches.find(consumer->getTableName()) == m_benches.end())
+                    {
+                        m_benches[consumer->getTableName()].consumer = consumer;
+                    }
+                }
+            }
+        }
+
+        bool add(const string &table, const KeyOpFieldsValuesTuple &entry)
+        {
+            auto it = m_benches.find(table);
+            if (it == m_benches.end())
+            {
+                return false;
+            }
+            m_records.push_back({ &it->second, entry });
+            return true;
+        }
+
+        /* Parse a swss.rec line: <timestamp>|<table><sep><key>|<op>|<field>:<value>|... */
+        bool addRecord(const string &line, const set<string> &tables)
+        {
+            auto start = line.find('|');
+            if (start == string::npos)
+            {
+                return false;
+            }
+            start++;
+
+            /* The table name is followed by ':' (APPL_DB) or '|' (CONFIG_DB) */
+            const string *table = nullptr;
+            for (auto &bench : m_benches)
+            {
+                auto &name = bench.first;
+                if (line.compare(start, name.size(), name) == 0 && line.size() > start + name.size() &&
+                    (line[start + name.size()] == ':' || line[start + name.size()] == '|') &&
+                    (!table || name.size() > table->size()))
+                {
+                    table = &name;
+                }
+            }
+            if (!table || (!tables.empty() && tables.find(*table) == tables.end()))
+            {
+                return false;
+            }
+
+            size_t keyStart = start + table->size() + 1;
+            size_t opStart = string::npos;
+            for (const string &op : { string("|") + SET_COMMAND, string("|") + DEL_COMMAND })
+            {
+                size_t pos = keyStart;
+                while ((pos = line.find(op, pos)) != string::npos)
+                {
+                    size_t end = pos + 4;
+                    if (end == line.size() || line[end] == '|')
+                    {
+                        opStart = min(opStart, pos);
+                        break;
+                    }
+                    pos++;
+                }
+            }
+            if (opStart == string::npos)
+            {
+                return false;
+            }
+
+            string key = line.substr(keyStart, opStart - keyStart);
+            string op = line.substr(opStart + 1, 3);
+            vector<FieldValueTuple> fvs;
+
+            size_t pos = opStart + 4;
+            while (pos < line.size())
+            {
+                size_t end = line.find('|', pos + 1);
+                if (end == string::npos)
+                {
+                    end = line.size();
+                }
+                string fv = line.substr(pos + 1, end - pos - 1);
+                auto sep = fv.find(':');
+                if (sep == string::npos)
+                {
+                    fvs.emplace_back(fv, "");
+                }
+                else
+                {
+                    fvs.emplace_back(fv.substr(0, sep), fv.substr(sep + 1));
+                }
+                pos = end;
+            }
+
+            return add(*table, KeyOpFieldsValuesTuple(key, op, fvs));
+        }
+
+        size_t size() const { return m_records.size(); }
+
+        void run()
+        {
+            auto start = chrono::steady_clock::now();
+            auto cpuStart = threadCpuTime();
+
+            size_t i = 0;
+            ConsumerBench *last = nullptr;
+            while (i < m_records.size())
+            {
+                ConsumerBench *bench = m_records[i].bench;
+                if (last && bench != last)
+                {
+                    retryPending();
+                }
+                last = bench;
+
+                deque<KeyOpFieldsValuesTuple> entries;
+                while (i < m_records.size() && m_records[i].bench == bench &&
+                       entries.size() < static_cast<size_t>(gBatchSize))
+                {
+                    entries.push_back(m_records[i++].entry);
+                }
+                bench->records += entries.size();
+
+                auto now = chrono::steady_clock::now();
+                for (auto &entry : entries)
+                {
+                    bench->inflight.emplace(kfvKey(entry), now);
+                }
+                bench->consumer->addToSync(entries);
+                drain(*bench);
+            }
+
+            /* Retry until the pending entries do not make progress anymore */
+            size_t pending = SIZE_MAX;
+            while (pending != countPending() && countPending() != 0)
+            {
+                pending = countPending();
+                retryPending();
+            }
+
+            m_elapsed = chrono::steady_clock::now() - start;
+            m_cpu = threadCpuTime() - cpuStart;
+        }
+
+        void report(ostream &os) const
+        {
+            double secs = chrono::duration<double>(m_elapsed).count();
+            os << fixed << setprecision(3);
+            os << "replayed " << m_records.size() << " records in " << secs << " s, "
+               << static_cast<uint64_t>(static_cast<double>(m_records.size()) / max(secs, 1e-9)) << " records/s, "
+               << chrono::duration<double>(m_cpu).count() << " s main thread CPU" << endl
+               << endl;
+
+            os << left << setw(28) << "TABLE" << right
+               << setw(10) << "RECORDS" << setw(10) << "DONE" << setw(10) << "PENDING"
+               << setw(12) << "DONE/S" << setw(10) << "CPU_MS" << setw(10) << "P50_US" << setw(10) << "P99_US" << setw(10) << "MAX_US" << endl;
+
+            for (auto &it : m_benches)
+            {
+                auto &bench = it.second;
+                if (bench.records == 0)
+                {
+                    continue;
+                }
+
+                vector<uint64_t> latencies = bench.latencies;
+                sort(latencies.begin(), latencies.end());
+                auto percentile = [&](double p) -> uint64_t {
+                    if (latencies.empty())
+                    {
+                        return 0;
+                    }
+                    return latencies[min(latencies.size() - 1, static_cast<size_t>(p * static_cast<double>(latencies.size())))];
+                };
+
+                double busy = chrono::duration<double>(bench.busy).count();
+                os << left << setw(28) << it.first << right
+                   << setw(10) << bench.records
+                   << setw(10) << latencies.size()
+                   << setw(10) << bench.inflight.size()
+                   << setw(12) << static_cast<uint64_t>(static_cast<double>(latencies.size()) / max(busy, 1e-9))
+                   << setw(10) << chrono::duration_cast<chrono::milliseconds>(bench.cpu).count()
+                   << setw(10) << percentile(0.50)
+                   << setw(10) << percentile(0.99)
+                   << setw(10) << (latencies.empty() ? 0 : latencies.back()) << endl;
+            }
+            os << endl;
+
+            os << left << setw(36) << "SAI CALL" << right
+               << setw(10) << "CALLS" << setw(10) << "OBJECTS" << setw(10) << "AVG" << setw(10) << "MAX"
+               << "  BATCH SIZES" << endl;
+            for (auto &stats : saiCallStats())
+            {
+                if (stats.calls == 0)
+                {
+                    continue;
+                }
+
+                os << left << setw(36) << stats.name << right
+                   << setw(10) << stats.calls << setw(10) << stats.objects;
+                if (stats.bulk)
+                {
+                    os << setw(10) << static_cast<double>(stats.objects) / static_cast<double>(stats.calls)
+                       << setw(10) << stats.maxBatch << " ";
+                    vector<FieldValueTuple> fvs;
+                    stats.batchSizes.toFieldValues("", fvs);
+                    for (auto &fv : fvs)
+                    {
+                        /* Bucket counts only, skip the empty ones */
+                        if (fvField(fv).find("_LE_") != 0 && fvField(fv).find("_GT_") != 0)
+                        {
+                            continue;
+                        }
+                        if (fvValue(fv) != "0")
+                        {
+                            os << " " << fvField(fv).substr(1) << ":" << fvValue(fv);
+                        }
+                    }
+                }
+                os << endl;
+            }
+        }
+
+    private:
+        map<string, ConsumerBench> m_benches;
+        vector<ReplayRecord> m_records;
+        chrono::steady_clock::duration m_elapsed { 0 };
+        chrono::nanoseconds m_cpu { 0 };
+
+        void drain(ConsumerBench &bench)
+        {
+            auto start = chrono::steady_clock::now();
+            auto cpuStart = threadCpuTime();
+            bench.consumer->drain();
+            auto now = chrono::steady_clock::now();
+            bench.busy += now - start;
+            bench.cpu += threadCpuTime() - cpuStart;
+
+            auto it = bench.inflight.begin();
+            while (it != bench.inflight.end())
+            {
+                if (bench.consumer->m_toSync.count(it->first) || bench.consumer->isParked(it->first))
+                {
+                    it++;
+                    continue;
+                }
+                bench.latencies.push_back(static_cast<uint64_t>(
+                            chrono::duration_cast<chrono::microseconds>(now - it->second).count()));
+                it = bench.inflight.erase(it);
+            }
+        }
+
+        void retryPending()
+        {
+            for (auto &it : m_benches)
+            {
+                if (!it.second.inflight.empty())
+                {
+                    drain(it.second);
+                }
+            }
+        }
+
+        size_t countPending() const
+        {
+            size_t pending = 0;
+            for (auto &it : m_benches)
+            {
+                pending += it.second.inflight.size();
+            }
+            return pending;
+        }
+    };
+
+    static shared_ptr<DBConnector> m_app_db;
+    static shared_ptr<DBConnector> m_config_db;
+    static shared_ptr<DBConnector> m_state_db;
+    static shared_ptr<DBConnector> m_chassis_app_db;
+
+    static void initSwitch()
+    {
+        map<string, string> profile = {
+            { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+            { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+        };
+
+        if (ut_helper::initSaiApi(profile) != SAI_STATUS_SUCCESS)
+        {
+            throw runtime_error("failed to initialize SAI");
+        }
+        sai_api_query(SAI_API_NEXT_HOP_GROUP, (void **)&sai_next_hop_group_api);
+        sai_api_query(SAI_API_FDB, (void **)&sai_fdb_api);
+        sai_api_query(SAI_API_MIRROR, (void **)&sai_mirror_api);
+
+        countSaiApiCalls();
+
+        sai_attribute_t attr;
+
+        attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+        attr.value.booldata = true;
+        if (sai_switch_api->create_switch(&gSwitchId, 1, &attr) != SAI_STATUS_SUCCESS)
+        {
+            throw runtime_error("failed to create switch");
+        }
+
+        attr.id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+        sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+        gMacAddress = attr.value.mac;
+
+        attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+        sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+        gVirtualRouterId = attr.value.oid;
+    }
+
+    /* Create the Orchs the way OrchDaemon::init does, return the ones replayed into */
+    static vector<Orch *> initOrchs()
+    {
+        m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+        m_config_db = make_shared<DBConnector>("CONFIG_DB", 0);
+        m_state_db = make_shared<DBConnector>("STATE_DB", 0);
+
+        gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+        TableConnector stateDbSwitchTable(m_state_db.get(), "SWITCH_CAPABILITY");
+        TableConnector conf_asic_sensors(m_config_db.get(), CFG_ASIC_SENSORS_TABLE_NAME);
+        TableConnector app_switch_table(m_app_db.get(), APP_SWITCH_TABLE_NAME);
+
+        vector<TableConnector> switch_tables = {
+            conf_asic_sensors,
+            app_switch_table
+        };
+        gSwitchOrch = new SwitchOrch(m_app_db.get(), switch_tables, stateDbSwitchTable);
+
+        const int portsorch_base_pri = 40;
+
+        vector<table_name_with_pri_t> ports_tables = {
+            { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+            { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+            { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+            { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+            { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+        };
+
+        vector<string> flex_counter_tables = {
+            CFG_FLEX_COUNTER_TABLE_NAME
+        };
+        auto* flexCounterOrch = new FlexCounterOrch(m_config_db.get(), flex_counter_tables);
+        gDirectory.set(flexCounterOrch);
+
+        gPortsOrch = new PortsOrch(m_app_db.get(), m_state_db.get(), ports_tables, m_chassis_app_db.get());
+
+        static const vector<string> route_pattern_tables = {
+            CFG_FLOW_COUNTER_ROUTE_PATTERN_TABLE_NAME,
+        };
+        gFlowCounterRouteOrch = new FlowCounterRouteOrch(m_config_db.get(), route_pattern_tables);
+        gDirectory.set(gFlowCounterRouteOrch);
+
+        gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+        gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+        const int fdborch_pri = 20;
+
+        vector<table_name_with_pri_t> app_fdb_tables = {
+            { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+            { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri},
+            { APP_MCLAG_FDB_TABLE_NAME,  fdborch_pri}
+        };
+
+        TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+        TableConnector stateMclagDbFdb(m_state_db.get(), STATE_MCLAG_REMOTE_FDB_TABLE_NAME);
+        gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, stateMclagDbFdb, gPortsOrch);
+
+        gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+        TunnelDecapOrch *tunnel_decap_orch = new TunnelDecapOrch(m_app_db.get(), APP_TUNNEL_DECAP_TABLE_NAME);
+        vector<string> mux_tables = {
+            CFG_MUX_CABLE_TABLE_NAME,
+            CFG_PEER_SWITCH_TABLE_NAME
+        };
+        MuxOrch *mux_orch = new MuxOrch(m_config_db.get(), mux_tables, tunnel_decap_orch, gNeighOrch, gFdbOrch);
+        gDirectory.set(mux_orch);
+
+        const int fgnhgorch_pri = 15;
+
+        vector<table_name_with_pri_t> fgnhg_tables = {
+            { CFG_FG_NHG,                 fgnhgorch_pri },
+            { CFG_FG_NHG_PREFIX,          fgnhgorch_pri },
+            { CFG_FG_NHG_MEMBER,          fgnhgorch_pri }
+        };
+        gFgNhgOrch = new FgNhgOrch(m_config_db.get(), m_app_db.get(), m_state_db.get(), fgnhg_tables, gNeighOrch, gIntfsOrch, gVrfOrch);
+
+        vector<string> srv6_tables = {
+            APP_SRV6_SID_LIST_TABLE_NAME,
+            APP_SRV6_MY_SID_TABLE_NAME
+        };
+        gSrv6Orch = new Srv6Orch(m_app_db.get(), srv6_tables, gSwitchOrch, gVrfOrch, gNeighOrch);
+
+        const int routeorch_pri = 5;
+        vector<table_name_with_pri_t> route_tables = {
+            { APP_ROUTE_TABLE_NAME,        routeorch_pri },
+            { APP_LABEL_ROUTE_TABLE_NAME,  routeorch_pri }
+        };
+        gRouteOrch = new RouteOrch(m_app_db.get(), route_tables, gSwitchOrch, gNeighOrch, gIntfsOrch, gVrfOrch, gFgNhgOrch, gSrv6Orch);
+        gNhgOrch = new NhgOrch(m_app_db.get(), APP_NEXTHOP_GROUP_TABLE_NAME);
+
+        vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                         APP_BUFFER_PROFILE_TABLE_NAME,
+                                         APP_BUFFER_QUEUE_TABLE_NAME,
+                                         APP_BUFFER_PG_TABLE_NAME,
+                                         APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                         APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+        gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+        vector<TableConnector> policer_tables = {
+            TableConnector(m_config_db.get(), CFG_POLICER_TABLE_NAME),
+            TableConnector(m_config_db.get(), CFG_PORT_STORM_CONTROL_TABLE_NAME)
+        };
+        gPolicerOrch = new PolicerOrch(policer_tables, gPortsOrch);
+
+        TableConnector stateDbMirrorSession(m_state_db.get(), STATE_MIRROR_SESSION_TABLE_NAME);
+        TableConnector confDbMirrorSession(m_config_db.get(), CFG_MIRROR_SESSION_TABLE_NAME);
+        gMirrorOrch = new MirrorOrch(stateDbMirrorSession, confDbMirrorSession,
+                                     gPortsOrch, gRouteOrch, gNeighOrch, gFdbOrch, gPolicerOrch);
+
+        vector<TableConnector> acl_table_connectors = {
+            TableConnector(m_config_db.get(), CFG_ACL_TABLE_TYPE_TABLE_NAME),
+            TableConnector(m_config_db.get(), CFG_ACL_TABLE_TABLE_NAME),
+            TableConnector(m_config_db.get(), CFG_ACL_RULE_TABLE_NAME)
+        };
+        gAclOrch = new AclOrch(acl_table_connectors, m_state_db.get(),
+                               gSwitchOrch, gPortsOrch, gMirrorOrch, gNeighOrch, gRouteOrch);
+
+        return { gPortsOrch, gIntfsOrch, gNeighOrch, gRouteOrch, gNhgOrch, gFdbOrch, gBufferOrch, gAclOrch };
+    }
+
+    /* Bring the front panel ports up, return their names */
+    static vector<string> initPorts(const Options &options)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        vector<string> names;
+        for (const auto &it : ut_helper::getInitialSaiPorts())
+        {
+            size_t index = stoul(it.first.substr(string(FRONT_PANEL_PORT_PREFIX).size()));
+            string name = FRONT_PANEL_PORT_PREFIX + to_string(index * options.portStride);
+            portTable.set(name, it.second);
+            names.push_back(name);
+        }
+        sort(names.begin(), names.end(), [](const string &a, const string &b) {
+            return a.size() != b.size() ? a.size() < b.size() : a < b;
+        });
+
+        portTable.set("PortConfigDone", { { "count", to_string(names.size()) } });
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        return names;
+    }
+
+    static string ipv4(uint32_t ip)
+    {
+        return to_string(ip >> 24) + "." + to_string((ip >> 16) & 0xff) + "." +
+               to_string((ip >> 8) & 0xff) + "." + to_string(ip & 0xff);
+    }
+
+    static string mac(uint32_t prefix, uint32_t id)
+    {
+        char buf[18];
+        snprintf(buf, sizeof(buf), "%02x:%02x:%02x:%02x:%02x:%02x", (prefix >> 8) & 0xff, prefix & 0xff,
+                 (id >> 24) & 0xff, (id >> 16) & 0xff, (id >> 8) & 0xff, id & 0xff);
+        return buf;
+    }
+
+    /*
+     * The first half of the ports are routed, one /16 subnet per port with
+     * the neighbors spread over them. The second half are untagged members
+     * of Vlan1000 which learns the FDB entries. Routes are /24 prefixes
+     * from 100.0.0.0 with 'ecmpWidth' next hops each, ACL rules match a
+     * source IP in an ingress L3 table bound to the first port.
+     */
+    static void generateWorkload(Replay &replay, const Options &options, const vector<string> &ports)
+    {
+        size_t routed = max<size_t>(1, ports.size() / 2);
+        vector<string> members(ports.begin() + static_cast<ptrdiff_t>(routed), ports.end());
+
+        for (size_t i = 0; i < routed; i++)
+        {
+            replay.add(APP_INTF_TABLE_NAME, KeyOpFieldsValuesTuple(ports[i], SET_COMMAND, { { "NULL", "NULL" } }));
+            replay.add(APP_INTF_TABLE_NAME, KeyOpFieldsValuesTuple(ports[i] + ":" + ipv4((10u << 24) + (static_cast<uint32_t>(i) << 16) + 1) + "/16",
+                                                                   SET_COMMAND, { { "scope", "global" }, { "family", "IPv4" } }));
+        }
+
+        vector<pair<string, string>> nexthops;
+        for (size_t n = 0; n < options.neighbors; n++)
+        {
+            size_t port = n % routed;
+            uint32_t host = static_cast<uint32_t>(n / routed) + 2;
+            string ip = ipv4((10u << 24) + (static_cast<uint32_t>(port) << 16) + host);
+            replay.add(APP_NEIGH_TABLE_NAME, KeyOpFieldsValuesTuple(ports[port] + ":" + ip, SET_COMMAND,
+                                                                    { { "neigh", mac(0x000a, static_cast<uint32_t>(n)) }, { "family", "IPv4" } }));
+            nexthops.emplace_back(ip, ports[port]);
+        }
+
+        if (options.routes && nexthops.size() < options.ecmpWidth)
+        {
+            cerr << "not enough neighbors for " << options.ecmpWidth << " next hops per route, skipping routes" << endl;
+        }
+        else
+        {
+            for (size_t r = 0; r < options.routes; r++)
+            {
+                string nhs;
+                string ifnames;
+                for (size_t w = 0; w < options.ecmpWidth; w++)
+                {
+                    auto &nh = nexthops[(r * options.ecmpWidth + w) % nexthops.size()];
+                    nhs += (w ? "," : "") + nh.first;
+                    ifnames += (w ? "," : "") + nh.second;
+                }
+                string prefix = ipv4((100u << 24) + (static_cast<uint32_t>(r) << 8)) + "/24";
+                replay.add(APP_ROUTE_TABLE_NAME, KeyOpFieldsValuesTuple(prefix, SET_COMMAND, { { "nexthop", nhs }, { "ifname", ifnames } }));
+            }
+        }
+
+        if ((options.fdbs || options.learns) && !members.empty())
+        {
+            replay.add(APP_VLAN_TABLE_NAME, KeyOpFieldsValuesTuple("Vlan1000", SET_COMMAND, { { "admin_status", "up" }, { "mtu", "9100" } }));
+            for (auto &member : members)
+            {
+                replay.add(APP_VLAN_MEMBER_TABLE_NAME, KeyOpFieldsValuesTuple("Vlan1000:" + member, SET_COMMAND, { { "tagging_mode", "untagged" } }));
+            }
+            for (size_t f = 0; f < options.fdbs; f++)
+            {
+                replay.add(APP_FDB_TABLE_NAME, KeyOpFieldsValuesTuple("Vlan1000:" + mac(0x0200, static_cast<uint32_t>(f)), SET_COMMAND,
+                                                                      { { "port", members[f % members.size()] }, { "type", "dynamic" } }));
+            }
+        }
+
+        if (options.aclRules)
+        {
+            replay.add(CFG_ACL_TABLE_TABLE_NAME, KeyOpFieldsValuesTuple("BENCH_ACL", SET_COMMAND,
+                                                                        { { ACL_TABLE_DESCRIPTION, "replay benchmark" },
+                                                                          { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                                                                          { ACL_TABLE_STAGE, STAGE_INGRESS },
+                                                                          { ACL_TABLE_PORTS, ports[0] } }));
+            for (size_t a = 0; a < options.aclRules; a++)
+            {
+                replay.add(CFG_ACL_RULE_TABLE_NAME, KeyOpFieldsValuesTuple("BENCH_ACL|RULE_" + to_string(a), SET_COMMAND,
+                                                                           { { RULE_PRIORITY, to_string(9999 - a % 9999) },
+                                                                             { MATCH_SRC_IP, ipv4((20u << 24) + static_cast<uint32_t>(a)) + "/32" },
+                                                                             { ACTION_PACKET_ACTION, PACKET_ACTION_DROP } }));
+            }
+        }
+    }
+
+    /*
+     * Feed 'learns' FDB learn notifications on Vlan1000 to FdbOrch in batches
+     * of gBatchSize, as the notification consumer does, and report the rate
+     */
+    static void benchLearns(const Options &options, const vector<string> &ports, ostream &os)
+    {
+        Port vlan;
+        if (!gPortsOrch->getPort("Vlan1000", vlan))
+        {
+            cerr << "Vlan1000 is not created, skipping FDB learns" << endl;
+            return;
+        }
+
+        vector<sai_object_id_t> bridgePorts;
+        for (size_t i = max<size_t>(1, ports.size() / 2); i < ports.size(); i++)
+        {
+            Port port;
+            if (gPortsOrch->getPort(ports[i], port) && port.m_bridge_port_id != SAI_NULL_OBJECT_ID)
+            {
+                bridgePorts.push_back(port.m_bridge_port_id);
+            }
+        }
+        if (bridgePorts.empty())
+        {
+            cerr << "Vlan1000 has no members, skipping FDB learns" << endl;
+            return;
+        }
+
+        vector<sai_attribute_t> attrs(options.learns);
+        vector<sai_fdb_event_notification_data_t> events(options.learns);
+        for (size_t l = 0; l < options.learns; l++)
+        {
+            attrs[l].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+            attrs[l].value.oid = bridgePorts[l % bridgePorts.size()];
+
+            auto &event = events[l];
+            event.event_type = SAI_FDB_EVENT_LEARNED;
+            event.fdb_entry.switch_id = gSwitchId;
+            event.fdb_entry.bv_id = vlan.m_vlan_info.vlan_oid;
+            memcpy(event.fdb_entry.mac_address, MacAddress(mac(0x0400, static_cast<uint32_t>(l))).getMac(), sizeof(sai_mac_t));
+            event.attr_count = 1;
+            event.attr = &attrs[l];
+        }
+
+        auto start = chrono::steady_clock::now();
+        auto cpuStart = threadCpuTime();
+        for (size_t l = 0; l < events.size(); l += static_cast<size_t>(gBatchSize))
+        {
+            size_t count = min(events.size() - l, static_cast<size_t>(gBatchSize));
+            Portal::FdbOrchInternal::handleFdbEvents(gFdbOrch, &events[l], static_cast<uint32_t>(count));
+        }
+        auto cpu = threadCpuTime() - cpuStart;
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        os << endl << "FDB learns: " << events.size() << " in " << fixed << setprecision(3) << elapsed << "s, "
+           << setprecision(0) << (elapsed > 0 ? static_cast<double>(events.size()) / elapsed : 0) << "/s, cpu "
+           << setprecision(3) << chrono::duration<double>(cpu).count() << "s" << endl;
+    }
+
+    static uint64_t totalSaiCalls()
+    {
+        uint64_t calls = 0;
+        for (auto &stats : saiCallStats())
+        {
+            calls += stats.calls;
+        }
+        return calls;
+    }
+
+    /*
+     * Point the SAI next hop of the first next hop of the routes to the one
+     * of another next hop, as a mux switchover swaps the next hop of a
+     * neighbor, and time RouteOrch repairing the routes of the first one
+     */
+    static void benchRepair(ostream &os)
+    {
+        auto routeTables = gRouteOrch->getSyncdRoutes().find(gVirtualRouterId);
+        if (routeTables == gRouteOrch->getSyncdRoutes().end())
+        {
+            cerr << "no routes, skipping next hop repair" << endl;
+            return;
+        }
+
+        NextHopKey failed, backup;
+        size_t routes = 0;
+        for (auto &route : routeTables->second)
+        {
+            auto &nhg = route.second.nhg_key;
+            if (nhg.getSize() != 1 || nhg.hasIntfNextHop() || !route.second.nhg_index.empty())
+            {
+                continue;
+            }
+
+            NextHopKey nexthop = *nhg.getNextHops().begin();
+            if (!routes)
+            {
+                failed = nexthop;
+            }
+            if (nexthop == failed)
+            {
+                routes++;
+            }
+            else if (backup.ip_address.isZero())
+            {
+                backup = nexthop;
+            }
+        }
+        if (!routes || backup.ip_address.isZero())
+        {
+            cerr << "routes need two next hops, skipping next hop repair" << endl;
+            return;
+        }
+
+        Portal::NeighOrchInternal::setNextHopId(gNeighOrch, failed, gNeighOrch->getNextHopId(backup));
+
+        uint64_t calls = totalSaiCalls();
+        uint32_t repaired = 0;
+        auto start = chrono::steady_clock::now();
+        bool status = gRouteOrch->updateNextHopRoutes(failed, repaired);
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        os << endl << "next hop repair" << (gRoutePic ? " (shared next hop groups)" : "") << ": "
+           << repaired << " of " << routes << " routes behind " << failed.to_string() << " in "
+           << fixed << setprecision(6) << elapsed << "s, " << totalSaiCalls() - calls << " SAI calls"
+           << (status ? "" : ", failed") << endl;
+    }
+
+    static string peakRss()
+    {
+        ifstream status("/proc/self/status");
+        string line;
+        while (getline(status, line))
+        {
+            if (line.compare(0, 6, "VmHWM:") == 0)
+            {
+                auto start = line.find_first_not_of(" \t", 6);
+                return start == string::npos ? "" : line.substr(start);
+            }
+        }
+        return "unknown";
+    }
+
+    static void usage()
+    {
+        cout << "usage: replay_bench [-r swss.rec [-T table,...]] [-R routes] [-N neighbors] [-F fdb_entries]" << endl
+             << "                    [-L fdb_learns] [-A acl_rules] [-e ecmp_width] [-b batch_size] [-p port_stride] [-P parse_threads]" << endl
+             << "                    [-x [-c]]" << endl
+             << "    -r swss.rec: replay the recording instead of the synthetic workload" << endl
+             << "    -T tables: replay only the records of these tables" << endl
+             << "    -R routes: number of routes (default 10000)" << endl
+             << "    -N neighbors: number of neighbors (default 1000)" << endl
+             << "    -F fdb_entries: number of FDB entries (default 1000)" << endl
+             << "    -L fdb_learns: number of FDB learn notifications fed after the replay (default 0)" << endl
+             << "    -A acl_rules: number of ACL rules (default 100)" << endl
+             << "    -e ecmp_width: number of next hops per route (default 1)" << endl
+             << "    -b batch_size: entries added to a consumer at once (default 128)" << endl
+             << "    -p port_stride: front panel ports are named Ethernet<index * stride> (default 4)" << endl
+             << "    -P parse_threads: threads pre-parsing the route entries (default 0)" << endl
+             << "    -x: time the repair of the routes of a next hop moved to another one after the replay" << endl
+             << "    -c: share a next hop group per next hop among its single path routes" << endl;
+    }
+}
+
+using namespace replay_bench;
+
+int main(int argc, char **argv)
+{
+    Options options;
+    int opt;
+
+    try
+    {
+        while ((opt = getopt(argc, argv, "r:T:R:N:F:L:A:e:b:p:P:xch")) != -1)
+        {
+            switch (opt)
+            {
+                case 'r':
+                    options.recordFile = optarg;
+                    break;
+                case 'T':
+                    for (auto &table : tokenize(optarg, ','))
+                    {
+                        options.tables.insert(table);
+                    }
+                    break;
+                case 'R':
+                    options.routes = stoul(optarg);
+                    break;
+                case 'N':
+                    options.neighbors = stoul(optarg);
+                    break;
+                case 'F':
+                    options.fdbs = stoul(optarg);
+                    break;
+                case 'L':
+                    options.learns = stoul(optarg);
+                    break;
+                case 'A':
+                    options.aclRules = stoul(optarg);
+                    break;
+                case 'e':
+                    options.ecmpWidth = max<size_t>(1, stoul(optarg));
+                    break;
+                case 'b':
+                    gBatchSize = max(1, stoi(optarg));
+                    break;
+                case 'p':
+                    options.portStride = max<size_t>(1, stoul(optarg));
+                    break;
+                case 'P':
+                    options.parseThreads = static_cast<uint32_t>(stoul(optarg));
+                    break;
+                case 'x':
+                    options.repair = true;
+                    break;
+                case 'c':
+                    options.pic = true;
+                    break;
+                default:
+                    usage();
+                    return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << "invalid argument: " << e.what() << endl;
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    /* Recording and logging would dominate the measurements */
+    gSwssRecord = false;
+    gSairedisRecord = false;
+    Logger::getInstance().setMinPrio(Logger::SWSS_ERROR);
+
+    gParseThreads = options.parseThreads;
+    gRoutePic = options.pic;
+
+    initSwitch();
+    auto orchs = initOrchs();
+    auto ports = initPorts(options);
+
+    Replay replay(orchs);
+    if (!options.recordFile.empty())
+    {
+        ifstream rec(options.recordFile);
+        if (!rec.is_open())
+        {
+            cerr << "failed to open " << options.recordFile << endl;
+            return EXIT_FAILURE;
+        }
+
+        string line;
+        size_t skipped = 0;
+        while (getline(rec, line))
+        {
+            if (!replay.addRecord(line, options.tables))
+            {
+                skipped++;
+            }
+        }
+        cout << options.recordFile << ": " << replay.size() << " records, " << skipped << " lines skipped" << endl;
+    }
+    else
+    {
+        generateWorkload(replay, options, ports);
+        cout << "synthetic workload: " << options.routes << " routes (" << options.ecmpWidth << " next hops), "
+             << options.neighbors << " neighbors, " << options.fdbs << " FDB entries, "
+             << options.aclRules << " ACL rules on " << ports.size() << " ports" << endl;
+    }
+
+    replay.run();
+    replay.report(cout);
+    if (options.learns)
+    {
+        benchLearns(options, ports, cout);
+    }
+    if (options.repair)
+    {
+        benchRepair(cout);
+    }
+    cout << endl << "peak RSS: " << peakRss() << endl;
+
+    return EXIT_SUCCESS;
+}
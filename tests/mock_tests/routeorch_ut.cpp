@@ -4,12 +4,19 @@
 #define protected public
 #include "orch.h"
 #undef protected
+#define private public // make NeighOrch::m_syncdNextHops available
+#include "neighorch.h"
+#undef private
 #include "ut_helper.h"
 #include "mock_orchagent_main.h"
 #include "mock_table.h"
 #include "bulker.h"
 
 extern string gMySwitchType;
+extern uint32_t gParseThreads;
+extern bool gNhgInPlaceUpdate;
+extern bool gRoutePic;
+extern sai_next_hop_group_api_t *sai_next_hop_group_api;
 
 
 namespace routeorch_test
@@ -89,6 +96,37 @@ namespace routeorch_test
         return old_set_route_entries_attribute(object_count, route_entry, attr_list, mode, object_statuses);
     }
 
+    sai_status_t _ut_stub_sai_bulk_create_next_hops_fail(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_INSUFFICIENT_RESOURCES;
+        }
+        return SAI_STATUS_FAILURE;
+    }
+
+    /* Retries the next hops it fails to create instead of exiting */
+    struct RetryNextHopNeighOrch : public NeighOrch
+    {
+        using NeighOrch::NeighOrch;
+
+        task_process_status handleSaiCreateStatus(sai_api_t api, sai_status_t status, void *context) override
+        {
+            if (api == SAI_API_NEXT_HOP)
+            {
+                return task_need_retry;
+            }
+            return NeighOrch::handleSaiCreateStatus(api, status, context);
+        }
+    };
+
     struct RouteOrchTest : public ::testing::Test
     {
         RouteOrchTest()
@@ -211,7 +249,7 @@ namespace routeorch_test
             gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, stateMclagDbFdb, gPortsOrch);
 
             ASSERT_EQ(gNeighOrch, nullptr);
-            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+            gNeighOrch = new RetryNextHopNeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
 
             TunnelDecapOrch *tunnel_decap_orch = new TunnelDecapOrch(m_app_db.get(), APP_TUNNEL_DECAP_TABLE_NAME);
             vector<string> mux_tables = {
@@ -422,4 +460,521 @@ namespace routeorch_test
         ASSERT_EQ(current_set_count + 1, set_route_count);
         ASSERT_EQ(sai_fail_count, 0);
     }
+
+    TEST_F(RouteOrchTest, RouteOrchTestResyncSweepsStaleRoutes)
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"2.2.2.0/24", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.2"}}});
+        entries.push_back({"2.2.3.0/24", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.2"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // All routes but 2.2.3.0/24 are sent again during the resync
+        entries.clear();
+        entries.push_back({"resync", "SET", { {} }});
+        for (auto prefix : { "0.0.0.0/0", "1.1.1.0/24", "2.2.2.0/24" })
+        {
+            entries.push_back({prefix, "SET", { {"ifname", "Ethernet0"},
+                                                {"nexthop", "10.0.0.2"}}});
+        }
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        entries.clear();
+        entries.push_back({"resync", "DEL", { {} }});
+        consumer->addToSync(entries);
+        auto current_remove_count = remove_route_count;
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // Stale routes are left to the sweep timer
+        auto &routes = gRouteOrch->getSyncdRoutes().at(gVirtualRouterId);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(current_remove_count, remove_route_count);
+        ASSERT_EQ(routes.count(IpPrefix("2.2.3.0/24")), 1);
+
+        auto sweep = dynamic_cast<ExecutableTimer *>(gRouteOrch->getExecutor("ROUTE_RESYNC_SWEEP"));
+        ASSERT_NE(sweep, nullptr);
+        sweep->execute();
+
+        ASSERT_EQ(current_remove_count + 1, remove_route_count);
+        ASSERT_EQ(routes.count(IpPrefix("2.2.3.0/24")), 0);
+        ASSERT_EQ(routes.at(IpPrefix("2.2.2.0/24")).nhg_key.to_string(), "10.0.0.2@Ethernet0");
+        ASSERT_EQ(sai_fail_count, 0);
+
+        // The sweep is over, another slice does not remove anything
+        sweep->execute();
+        ASSERT_EQ(current_remove_count + 1, remove_route_count);
+    }
+
+    TEST(RouteParseTest, ParseRoute)
+    {
+        ParsedRoute route;
+        RouteOrch::parseRoute({"Vrf1:1.1.1.0/24", "SET", { {"ifname", "Ethernet0,Ethernet4"},
+                                                           {"nexthop", "10.0.0.2,10.0.0.3"},
+                                                           {"weight", "1,3"} }}, route);
+        ASSERT_TRUE(route.prefix_parsed);
+        ASSERT_EQ(route.vrf_name, "Vrf1");
+        ASSERT_EQ(route.ip_prefix, IpPrefix("1.1.1.0/24"));
+        ASSERT_TRUE(route.nhg_parsed);
+        ASSERT_EQ(route.nhg.getSize(), 2);
+        ASSERT_EQ(route.nhg.getNextHops().begin()->weight, 1);
+
+        // Empty next hop IPs are set to zero
+        route = ParsedRoute();
+        RouteOrch::parseRoute({"2001::/64", "SET", { {"ifname", "Ethernet0,Ethernet4"},
+                                                     {"nexthop", ","} }}, route);
+        ASSERT_EQ(route.ipv_size, 1);
+        ASSERT_EQ(route.empty_ips, 2);
+        ASSERT_EQ(route.ipv, vector<string>({"::", "::"}));
+
+        // Next hops depending on IntfsOrch are left to doTask()
+        route = ParsedRoute();
+        RouteOrch::parseRoute({"1.1.1.0/24", "SET", { {"ifname", "tun0"},
+                                                      {"nexthop", "10.0.0.2"} }}, route);
+        ASSERT_FALSE(route.nhg_parsed);
+
+        route = ParsedRoute();
+        RouteOrch::parseRoute({"1.1.1.0/24", "SET", { {"ifname", "Loopback0"},
+                                                      {"nexthop", "0.0.0.0"} }}, route);
+        ASSERT_TRUE(route.excp_intfs);
+        ASSERT_FALSE(route.nhg_parsed);
+
+        route = ParsedRoute();
+        RouteOrch::parseRoute({"1.1.1.0/24", "SET", { {"nexthop_group", "group1"} }}, route);
+        ASSERT_EQ(route.nhg_index, "group1");
+        ASSERT_TRUE(route.ipv.empty());
+        ASSERT_FALSE(route.nhg_parsed);
+
+        route = ParsedRoute();
+        RouteOrch::parseRoute({"1.1.1.0/33", "SET", { {"ifname", "Ethernet0"},
+                                                      {"nexthop", "10.0.0.2"} }}, route);
+        ASSERT_FALSE(route.prefix_parsed);
+    }
+
+    TEST(ParsePoolTest, RunEachIndexOnce)
+    {
+        ParsePool pool(3);
+        for (size_t count : vector<size_t>({ 0, 10, 1000 }))
+        {
+            vector<int> calls(count);
+            pool.run(count, [&](size_t i) { calls[i]++; });
+            ASSERT_EQ(count_if(calls.begin(), calls.end(), [](int c) { return c != 1; }), 0);
+        }
+    }
+
+    struct RouteOrchParsePoolTest : public RouteOrchTest
+    {
+        void SetUp() override
+        {
+            gParseThreads = 2;
+            RouteOrchTest::SetUp();
+            gParseThreads = 0;
+        }
+    };
+
+    TEST_F(RouteOrchParsePoolTest, PreParsedRoutes)
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        for (int i = 0; i < 100; i++)
+        {
+            entries.push_back({"3.3." + to_string(i) + ".0/24", "SET", { {"ifname", "Ethernet0"},
+                                                                         {"nexthop", "10.0.0.2"}}});
+        }
+
+        // The entries of a key are still applied in order
+        entries.push_back({"1.1.1.0/24", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.2"}}});
+        entries.push_back({"1.1.1.0/24", "DEL", { {} }});
+        entries.push_back({"1.1.1.0/24", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.3"}}});
+
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        auto &routes = gRouteOrch->getSyncdRoutes().at(gVirtualRouterId);
+        ASSERT_EQ(routes.at(IpPrefix("3.3.99.0/24")).nhg_key.to_string(), "10.0.0.2@Ethernet0");
+        ASSERT_EQ(routes.at(IpPrefix("1.1.1.0/24")).nhg_key.to_string(), "10.0.0.3@Ethernet0");
+        ASSERT_EQ(sai_fail_count, 0);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchTestLongestMatchRoute)
+    {
+        IpPrefix prefix;
+        RouteNhg route_nhg;
+
+        ASSERT_TRUE(gRouteOrch->getLongestMatchRoute(gVirtualRouterId, IpAddress("1.1.1.5"), prefix, route_nhg));
+        ASSERT_EQ(prefix.to_string(), "1.1.1.0/24");
+        ASSERT_TRUE(gRouteOrch->getLongestMatchRoute(gVirtualRouterId, IpAddress("2.2.2.2"), prefix, route_nhg));
+        ASSERT_EQ(prefix.to_string(), "0.0.0.0/0");
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"1.1.1.0/28", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.3"}}});
+        entries.push_back({"1.1.1.0/24", "DEL", {}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_TRUE(gRouteOrch->getLongestMatchRoute(gVirtualRouterId, IpAddress("1.1.1.5"), prefix, route_nhg));
+        ASSERT_EQ(prefix.to_string(), "1.1.1.0/28");
+        ASSERT_EQ(route_nhg.nhg_key.to_string(), "10.0.0.3@Ethernet0");
+        ASSERT_TRUE(gRouteOrch->getLongestMatchRoute(gVirtualRouterId, IpAddress("1.1.1.100"), prefix, route_nhg));
+        ASSERT_EQ(prefix.to_string(), "0.0.0.0/0");
+    }
+
+    TEST_F(RouteOrchTest, RouteOnNewMplsNextHopsIsProgrammedInOneDoTask)
+    {
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"3.3.3.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3"},
+                                                  {"mpls_nh", "push300,push400"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // The next hops are created and the route parked on them is woken and programmed
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey("push300+10.0.0.2@Ethernet0")));
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey("push400+10.0.0.3@Ethernet0")));
+        ASSERT_EQ(consumer->getParkedTaskCount(), 0);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(NextHopGroupKey(
+            "push300+10.0.0.2@Ethernet0,push400+10.0.0.3@Ethernet0")));
+    }
+
+    TEST_F(RouteOrchTest, RouteWaitingOnFailedMplsNextHopsIsWoken)
+    {
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        auto create_next_hops = gNeighOrch->gNextHopBulker.create_entries;
+        gNeighOrch->gNextHopBulker.create_entries = _ut_stub_sai_bulk_create_next_hops_fail;
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"2.2.2.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3"},
+                                                  {"mpls_nh", "push100,push200"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // The route waits on both MPLS next hops, which failed to be created
+        NextHopKey nh1("push100+10.0.0.2@Ethernet0");
+        NextHopKey nh2("push200+10.0.0.3@Ethernet0");
+        ASSERT_FALSE(gNeighOrch->hasNextHop(nh1));
+        ASSERT_FALSE(gNeighOrch->hasNextHop(nh2));
+        ASSERT_TRUE(consumer->isParked("2.2.2.0/24"));
+
+        // The failure woke the route, it queues the next hops again and is
+        // programmed in the same flush as them
+        gNeighOrch->gNextHopBulker.create_entries = create_next_hops;
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_TRUE(gNeighOrch->hasNextHop(nh1));
+        ASSERT_TRUE(gNeighOrch->hasNextHop(nh2));
+        ASSERT_EQ(consumer->getParkedTaskCount(), 0);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(NextHopGroupKey(
+            "push100+10.0.0.2@Ethernet0,push200+10.0.0.3@Ethernet0")));
+    }
+
+    struct RouteOrchNhgInPlaceTest : public RouteOrchTest
+    {
+        void SetUp() override
+        {
+            RouteOrchTest::SetUp();
+            gNhgInPlaceUpdate = true;
+
+            Table neighborTable = Table(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+            neighborTable.set("Ethernet0:10.0.0.4", { {"neigh", "00:00:0a:00:00:04"},
+                                                      {"family", "IPv4" }});
+            gNeighOrch->addExistingData(&neighborTable);
+            static_cast<Orch *>(gNeighOrch)->doTask();
+        }
+
+        void TearDown() override
+        {
+            gNhgInPlaceUpdate = false;
+            RouteOrchTest::TearDown();
+        }
+
+        void setRoute(const string &prefix, const string &nexthops)
+        {
+            string ifnames = "Ethernet0";
+            for (auto c : nexthops)
+            {
+                if (c == ',')
+                {
+                    ifnames += ",Ethernet0";
+                }
+            }
+            std::deque<KeyOpFieldsValuesTuple> entries;
+            entries.push_back({prefix, "SET", { {"ifname", ifnames},
+                                                {"nexthop", nexthops}}});
+            auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(gRouteOrch)->doTask();
+        }
+    };
+
+    TEST_F(RouteOrchNhgInPlaceTest, UpdateSingleUserGroupInPlace)
+    {
+        setRoute("4.4.4.0/24", "10.0.0.2,10.0.0.3");
+        auto nhg_count = gRouteOrch->getNhgCount();
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(NextHopGroupKey("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0")));
+
+        // The group gains a member, the route entry is not touched
+        auto current_create_count = create_route_count;
+        auto current_remove_count = remove_route_count;
+        auto current_set_count = set_route_count;
+        setRoute("4.4.4.0/24", "10.0.0.2,10.0.0.3,10.0.0.4");
+
+        ASSERT_EQ(current_create_count, create_route_count);
+        ASSERT_EQ(current_remove_count, remove_route_count);
+        ASSERT_EQ(current_set_count, set_route_count);
+        ASSERT_EQ(nhg_count, gRouteOrch->getNhgCount());
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(NextHopGroupKey("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0")));
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(NextHopGroupKey("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0,10.0.0.4@Ethernet0")));
+
+        auto &routes = gRouteOrch->getSyncdRoutes().at(gVirtualRouterId);
+        ASSERT_EQ(routes.at(IpPrefix("4.4.4.0/24")).nhg_key.to_string(),
+                  "10.0.0.2@Ethernet0,10.0.0.3@Ethernet0,10.0.0.4@Ethernet0");
+
+        // A shared group is left alone and the route moves to a new one
+        setRoute("4.4.5.0/24", "10.0.0.2,10.0.0.3,10.0.0.4");
+        current_set_count = set_route_count;
+        setRoute("4.4.4.0/24", "10.0.0.2,10.0.0.4");
+
+        ASSERT_EQ(current_set_count + 1, set_route_count);
+        ASSERT_EQ(nhg_count + 1, gRouteOrch->getNhgCount());
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(NextHopGroupKey("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0,10.0.0.4@Ethernet0")));
+        ASSERT_EQ(sai_fail_count, 0);
+    }
+
+    TEST_F(RouteOrchNhgInPlaceTest, RecreateGroupWithSharedNextHopId)
+    {
+        setRoute("4.4.4.0/24", "10.0.0.2,10.0.0.3");
+        auto nhg_count = gRouteOrch->getNhgCount();
+
+        // The added next hop has the next hop id of a member, the group is recreated
+        NextHopKey nexthop("10.0.0.4", "Ethernet0");
+        auto next_hop_id = gNeighOrch->m_syncdNextHops[nexthop].next_hop_id;
+        gNeighOrch->m_syncdNextHops[nexthop].next_hop_id =
+            gNeighOrch->getNextHopId(NextHopKey("10.0.0.3", "Ethernet0"));
+
+        auto current_set_count = set_route_count;
+        setRoute("4.4.4.0/24", "10.0.0.2,10.0.0.3,10.0.0.4");
+        gNeighOrch->m_syncdNextHops[nexthop].next_hop_id = next_hop_id;
+
+        ASSERT_EQ(current_set_count + 1, set_route_count);
+        ASSERT_EQ(nhg_count, gRouteOrch->getNhgCount());
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(NextHopGroupKey("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0")));
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(NextHopGroupKey("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0,10.0.0.4@Ethernet0")));
+        ASSERT_EQ(sai_fail_count, 0);
+    }
+
+    int create_nhg_member_count;
+    int remove_nhg_member_count;
+
+    sai_next_hop_group_api_t ut_sai_next_hop_group_api;
+    sai_next_hop_group_api_t *pold_sai_next_hop_group_api;
+
+    sai_status_t _ut_stub_sai_create_next_hop_group_member(
+        _Out_ sai_object_id_t *next_hop_group_member_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        create_nhg_member_count++;
+        return pold_sai_next_hop_group_api->create_next_hop_group_member(next_hop_group_member_id, switch_id, attr_count, attr_list);
+    }
+
+    sai_status_t _ut_stub_sai_remove_next_hop_group_member(
+        _In_ sai_object_id_t next_hop_group_member_id)
+    {
+        remove_nhg_member_count++;
+        return pold_sai_next_hop_group_api->remove_next_hop_group_member(next_hop_group_member_id);
+    }
+
+    sai_status_t _ut_stub_sai_create_next_hop_group_members(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        create_nhg_member_count += (int)object_count;
+        return pold_sai_next_hop_group_api->create_next_hop_group_members(switch_id, object_count, attr_count,
+                                                                          attr_list, mode, object_id, object_statuses);
+    }
+
+    struct RouteOrchPicTest : public RouteOrchNhgInPlaceTest
+    {
+        void SetUp() override
+        {
+            RouteOrchNhgInPlaceTest::SetUp();
+            gRoutePic = true;
+
+            pold_sai_next_hop_group_api = sai_next_hop_group_api;
+            ut_sai_next_hop_group_api = *sai_next_hop_group_api;
+            sai_next_hop_group_api = &ut_sai_next_hop_group_api;
+            sai_next_hop_group_api->create_next_hop_group_member = _ut_stub_sai_create_next_hop_group_member;
+            sai_next_hop_group_api->remove_next_hop_group_member = _ut_stub_sai_remove_next_hop_group_member;
+            sai_next_hop_group_api->create_next_hop_group_members = _ut_stub_sai_create_next_hop_group_members;
+            create_nhg_member_count = 0;
+            remove_nhg_member_count = 0;
+
+            // 10.0.0.4 is a neighbor of a MUX cable
+            gDirectory.get<MuxOrch*>()->addNexthop(NextHopKey("10.0.0.4", "Ethernet0"), "Ethernet0");
+        }
+
+        void TearDown() override
+        {
+            sai_next_hop_group_api = pold_sai_next_hop_group_api;
+            gRoutePic = false;
+            RouteOrchNhgInPlaceTest::TearDown();
+        }
+
+        void delRoutes(const vector<string> &prefixes)
+        {
+            std::deque<KeyOpFieldsValuesTuple> entries;
+            for (auto &prefix : prefixes)
+            {
+                entries.push_back({prefix, "DEL", {}});
+            }
+            auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(gRouteOrch)->doTask();
+            ASSERT_TRUE(consumer->m_toSync.empty());
+        }
+    };
+
+    TEST_F(RouteOrchPicTest, SingleNextHopRoutesShareGroup)
+    {
+        auto nhg_count = gRouteOrch->getNhgCount();
+        NextHopKey nexthop("10.0.0.4", "Ethernet0");
+
+        setRoute("5.5.5.0/24", "10.0.0.4");
+        setRoute("5.5.6.0/24", "10.0.0.4");
+
+        ASSERT_NE(gRouteOrch->getPicNextHopGroupId(nexthop), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhg_count + 1, gRouteOrch->getNhgCount());
+        ASSERT_EQ(create_nhg_member_count, 1);
+
+        // The group does not hold a reference on the next hop, the routes do
+        ASSERT_EQ(gNeighOrch->getNextHopRefCount(nexthop), 2);
+
+        // Repairing with an unchanged next hop is a no-op
+        auto current_set_count = set_route_count;
+        uint32_t num_routes = 0;
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(nexthop, num_routes));
+        ASSERT_EQ(num_routes, 2u);
+        ASSERT_EQ(create_nhg_member_count, 1);
+        ASSERT_EQ(remove_nhg_member_count, 0);
+
+        // A new next hop id replaces the member, the routes are not touched
+        auto local_id = gNeighOrch->m_syncdNextHops[nexthop].next_hop_id;
+        gNeighOrch->m_syncdNextHops[nexthop].next_hop_id =
+            gNeighOrch->getNextHopId(NextHopKey("10.0.0.3", "Ethernet0"));
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(nexthop, num_routes));
+        ASSERT_EQ(num_routes, 2u);
+        ASSERT_EQ(create_nhg_member_count, 2);
+        ASSERT_EQ(remove_nhg_member_count, 1);
+        ASSERT_EQ(current_set_count, set_route_count);
+
+        gNeighOrch->m_syncdNextHops[nexthop].next_hop_id = local_id;
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(nexthop, num_routes));
+        ASSERT_EQ(create_nhg_member_count, 3);
+        ASSERT_EQ(remove_nhg_member_count, 2);
+
+        // The group goes away with the last route
+        delRoutes({ "5.5.5.0/24", "5.5.6.0/24" });
+
+        ASSERT_EQ(gRouteOrch->getPicNextHopGroupId(nexthop), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhg_count, gRouteOrch->getNhgCount());
+        ASSERT_EQ(remove_nhg_member_count, 3);
+        ASSERT_EQ(gNeighOrch->getNextHopRefCount(nexthop), 0);
+        ASSERT_EQ(sai_fail_count, 0);
+    }
+
+    TEST_F(RouteOrchPicTest, OnlyMuxNextHopsShareGroup)
+    {
+        auto nhg_count = gRouteOrch->getNhgCount();
+        NextHopKey nexthop("10.0.0.3", "Ethernet0");
+
+        // Not switched over by MuxOrch, the routes point to the next hop
+        setRoute("5.5.5.0/24", "10.0.0.3");
+        ASSERT_EQ(gRouteOrch->getPicNextHopGroupId(nexthop), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhg_count, gRouteOrch->getNhgCount());
+        ASSERT_EQ(create_nhg_member_count, 0);
+
+        // The members of the groups created by one bulk are created together
+        gDirectory.get<MuxOrch*>()->addNexthop(NextHopKey("10.0.0.2", "Ethernet0"), "Ethernet0");
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"5.5.6.0/24", "SET", { {"ifname", "Ethernet0"}, {"nexthop", "10.0.0.2"} }});
+        entries.push_back({"5.5.7.0/24", "SET", { {"ifname", "Ethernet0"}, {"nexthop", "10.0.0.4"} }});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_NE(gRouteOrch->getPicNextHopGroupId(NextHopKey("10.0.0.2", "Ethernet0")), SAI_NULL_OBJECT_ID);
+        ASSERT_NE(gRouteOrch->getPicNextHopGroupId(NextHopKey("10.0.0.4", "Ethernet0")), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhg_count + 2, gRouteOrch->getNhgCount());
+        ASSERT_EQ(create_nhg_member_count, 2);
+
+        delRoutes({ "5.5.5.0/24", "5.5.6.0/24", "5.5.7.0/24" });
+        ASSERT_EQ(nhg_count, gRouteOrch->getNhgCount());
+        ASSERT_EQ(remove_nhg_member_count, 2);
+        ASSERT_EQ(sai_fail_count, 0);
+    }
+
+    /*
+     * Replays the steps of MuxNbrHandler::disable() and enable(). The tunnel
+     * next hop MuxOrch returns in standby is stood in for by the next hop of
+     * 10.0.0.3.
+     */
+    TEST_F(RouteOrchPicTest, MuxSwitchoverMovesSharedGroupMember)
+    {
+        NextHopKey nexthop("10.0.0.4", "Ethernet0");
+        NeighborEntry neighbor(IpAddress("10.0.0.4"), "Ethernet0");
+
+        setRoute("5.5.5.0/24", "10.0.0.4");
+        setRoute("5.5.6.0/24", "10.0.0.4");
+        auto local_id = gNeighOrch->m_syncdNextHops[nexthop].next_hop_id;
+
+        // Active to standby
+        gNeighOrch->m_syncdNextHops[nexthop].next_hop_id =
+            gNeighOrch->getNextHopId(NextHopKey("10.0.0.3", "Ethernet0"));
+        uint32_t num_routes = 0;
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(nexthop, num_routes));
+        gNeighOrch->m_syncdNextHops[nexthop].next_hop_id = local_id;
+        ASSERT_EQ(num_routes, 2u);
+
+        gNeighOrch->decreaseNextHopRefCount(nexthop, num_routes);
+        ASSERT_EQ(gNeighOrch->getNextHopRefCount(nexthop), 0);
+        ASSERT_TRUE(gNeighOrch->disableNeighbor(neighbor));
+        ASSERT_FALSE(gNeighOrch->hasNextHop(nexthop));
+
+        // Standby to active, the neighbor comes back with a new next hop
+        ASSERT_TRUE(gNeighOrch->enableNeighbor(neighbor));
+        ASSERT_TRUE(gNeighOrch->hasNextHop(nexthop));
+        ASSERT_NE(gNeighOrch->getNextHopId(nexthop), local_id);
+
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(nexthop, num_routes));
+        ASSERT_EQ(num_routes, 2u);
+        gNeighOrch->increaseNextHopRefCount(nexthop, num_routes);
+
+        ASSERT_EQ(create_nhg_member_count, 3);
+        ASSERT_EQ(remove_nhg_member_count, 2);
+        ASSERT_EQ(gNeighOrch->getNextHopRefCount(nexthop), 2);
+
+        delRoutes({ "5.5.5.0/24", "5.5.6.0/24" });
+
+        ASSERT_EQ(gRouteOrch->getPicNextHopGroupId(nexthop), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(gNeighOrch->getNextHopRefCount(nexthop), 0);
+        ASSERT_EQ(sai_fail_count, 0);
+    }
 }
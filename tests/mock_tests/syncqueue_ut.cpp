@@ -0,0 +1,326 @@
+#include "ut_helper.h"
+#include "syncqueue.h"
+
+#include <chrono>
+#include <map>
+
+namespace syncqueue_test
+{
+    using namespace std;
+
+    static KeyOpFieldsValuesTuple makeTask(const string &key, const string &op, const vector<FieldValueTuple> &fvs = {})
+    {
+        return KeyOpFieldsValuesTuple(key, op, fvs);
+    }
+
+    TEST(SyncQueueTest, KeepsInsertionOrder)
+    {
+        SyncQueue q;
+
+        q.emplace("c", makeTask("c", SET_COMMAND));
+        q.emplace("a", makeTask("a", SET_COMMAND));
+        q.emplace("b", makeTask("b", SET_COMMAND));
+
+        vector<string> keys;
+        for (auto &it : q)
+        {
+            keys.push_back(it.first);
+        }
+        EXPECT_EQ(keys, vector<string>({ "c", "a", "b" }));
+
+        keys.clear();
+        for (auto rit = q.rbegin(); rit != q.rend(); ++rit)
+        {
+            keys.push_back(rit->first);
+        }
+        EXPECT_EQ(keys, vector<string>({ "b", "a", "c" }));
+    }
+
+    TEST(SyncQueueTest, SameKeyTasksAreAdjacentAndFifo)
+    {
+        SyncQueue q;
+
+        q.emplace("a", makeTask("a", DEL_COMMAND));
+        q.emplace("b", makeTask("b", SET_COMMAND));
+        q.emplace("a", makeTask("a", SET_COMMAND));
+
+        ASSERT_EQ(q.size(), 3);
+        ASSERT_EQ(q.count("a"), 2);
+
+        auto it = q.begin();
+        EXPECT_EQ(it->first, "a");
+        EXPECT_EQ(kfvOp(it->second), DEL_COMMAND);
+        ++it;
+        EXPECT_EQ(it->first, "a");
+        EXPECT_EQ(kfvOp(it->second), SET_COMMAND);
+        ++it;
+        EXPECT_EQ(it->first, "b");
+    }
+
+    TEST(SyncQueueTest, EraseKeepsIndexConsistent)
+    {
+        SyncQueue q;
+
+        for (int i = 0; i < 1000; i++)
+        {
+            string key = "key" + to_string(i);
+            q.emplace(key, makeTask(key, DEL_COMMAND));
+            q.emplace(key, makeTask(key, SET_COMMAND));
+        }
+        ASSERT_EQ(q.size(), 2000);
+
+        /* Erase the head task of every even key and the whole odd keys */
+        auto it = q.begin();
+        int i = 0;
+        while (it != q.end())
+        {
+            if (i % 2 == 0)
+            {
+                it = q.erase(it);
+                ++it;
+            }
+            else
+            {
+                it = q.erase(it);
+                it = q.erase(it);
+            }
+            i++;
+        }
+
+        ASSERT_EQ(q.size(), 500);
+        for (i = 0; i < 1000; i++)
+        {
+            string key = "key" + to_string(i);
+            if (i % 2 == 0)
+            {
+                auto found = q.find(key);
+                ASSERT_NE(found, q.end());
+                EXPECT_EQ(kfvOp(found->second), SET_COMMAND);
+                EXPECT_EQ(q.count(key), 1);
+            }
+            else
+            {
+                EXPECT_EQ(q.find(key), q.end());
+                EXPECT_EQ(q.count(key), 0);
+            }
+        }
+
+        EXPECT_EQ(q.erase("key0"), 1);
+        EXPECT_EQ(q.size(), 499);
+
+        q.clear();
+        EXPECT_TRUE(q.empty());
+        EXPECT_EQ(q.begin(), q.end());
+        EXPECT_EQ(q.find("key2"), q.end());
+    }
+
+    TEST(SyncQueueTest, AddMergesLikeAddToSync)
+    {
+        SyncQueue q;
+
+        q.add(makeTask("a", SET_COMMAND, { { "f1", "v1" }, { "f2", "v2" } }));
+        q.add(makeTask("b", SET_COMMAND, { { "f1", "v1" } }));
+        q.add(makeTask("a", SET_COMMAND, { { "f1", "v3" } }));
+
+        ASSERT_EQ(q.size(), 2);
+        auto &fvs = kfvFieldsValues(q.find("a")->second);
+        EXPECT_EQ(fvs, vector<FieldValueTuple>({ { "f2", "v2" }, { "f1", "v3" } }));
+
+        /* DEL overwrites, SET is queued after it */
+        q.add(makeTask("a", DEL_COMMAND));
+        q.add(makeTask("a", SET_COMMAND, { { "f4", "v4" } }));
+        q.add(makeTask("a", SET_COMMAND, { { "f5", "v5" } }));
+
+        ASSERT_EQ(q.count("a"), 2);
+        auto range = q.equal_range("a");
+        EXPECT_EQ(kfvOp(range.first->second), DEL_COMMAND);
+        ++range.first;
+        EXPECT_EQ(kfvOp(range.first->second), SET_COMMAND);
+        EXPECT_EQ(kfvFieldsValues(range.first->second), vector<FieldValueTuple>({ { "f4", "v4" }, { "f5", "v5" } }));
+
+        /* The key moved behind "b" when it was deleted */
+        EXPECT_EQ(q.begin()->first, "b");
+    }
+
+    TEST(SyncQueueTest, ReverseIterationFromTask)
+    {
+        SyncQueue q;
+
+        q.emplace("a", makeTask("a", SET_COMMAND));
+        q.emplace("b", makeTask("b", DEL_COMMAND));
+        q.emplace("b", makeTask("b", SET_COMMAND));
+
+        /* Walk back from the SET of "b" and drop the DEL before it, as NeighOrch does */
+        auto it = q.find("b");
+        ++it;
+        auto rit = make_reverse_iterator(it);
+        ASSERT_EQ(kfvOp(rit->second), DEL_COMMAND);
+        q.erase(next(rit).base());
+
+        ASSERT_EQ(q.size(), 2);
+        EXPECT_EQ(q.find("b"), it);
+        EXPECT_EQ(kfvOp(q.find("b")->second), SET_COMMAND);
+
+        const SyncQueue &cq = q;
+        EXPECT_TRUE(cq.find("a") == q.begin());
+    }
+
+    TEST(SyncQueueTest, TransferKeepsQueueTimeAndAttempts)
+    {
+        SyncQueue q;
+        SyncQueue parked;
+
+        EXPECT_EQ(q.oldestQueued(), SyncQueue::time_point::max());
+
+        q.add(makeTask("a", SET_COMMAND, { { "f1", "v1" } }));
+        auto queued = q.queuedAt(q.find("a"));
+        EXPECT_EQ(q.markAttempted(), 0);
+
+        /* A merged SET keeps the queue time and the attempt of the pending one */
+        q.add(makeTask("a", SET_COMMAND, { { "f2", "v2" } }));
+        q.add(makeTask("b", SET_COMMAND));
+        EXPECT_EQ(q.queuedAt(q.find("a")), queued);
+        EXPECT_EQ(q.oldestQueued(), queued);
+
+        /* Park "a" and bring it back behind "b" */
+        auto range = q.equal_range("a");
+        EXPECT_EQ(parked.transfer(q, range.first, range.second), q.find("b"));
+        EXPECT_EQ(q.size(), 1);
+        q.transfer(parked, parked.begin(), parked.end());
+        EXPECT_TRUE(parked.empty());
+        EXPECT_EQ(q.rbegin()->first, "a");
+        EXPECT_EQ(q.queuedAt(q.find("a")), queued);
+        EXPECT_EQ(q.oldestQueued(), queued);
+        EXPECT_EQ(kfvFieldsValues(q.find("a")->second).size(), 2);
+
+        /* Only "a" was handed over before */
+        EXPECT_EQ(q.markAttempted(), 1);
+        EXPECT_EQ(q.markAttempted(), 2);
+
+        /* A DEL replaces the tasks of the key, it was not attempted yet */
+        q.add(makeTask("a", DEL_COMMAND));
+        EXPECT_EQ(q.markAttempted(), 1);
+    }
+
+    /* The Consumer::addToSync() algorithm on the std::multimap SyncMap used to be */
+    static void addToMultimap(multimap<string, KeyOpFieldsValuesTuple> &m, const KeyOpFieldsValuesTuple &entry)
+    {
+        const string &key = kfvKey(entry);
+
+        if (m.find(key) == m.end())
+        {
+            m.emplace(key, entry);
+            return;
+        }
+        if (kfvOp(entry) == DEL_COMMAND)
+        {
+            m.erase(key);
+            m.emplace(key, entry);
+            return;
+        }
+
+        auto ret = m.equal_range(key);
+        auto iter = ret.first;
+        for (; iter != ret.second; ++iter)
+        {
+            if (kfvOp(iter->second) == SET_COMMAND)
+                break;
+        }
+        if (iter == ret.second)
+        {
+            m.emplace(key, entry);
+            return;
+        }
+
+        KeyOpFieldsValuesTuple existing_data = iter->second;
+        auto existing_values = kfvFieldsValues(existing_data);
+        for (auto fv : kfvFieldsValues(entry))
+        {
+            auto iu = existing_values.begin();
+            while (iu != existing_values.end())
+            {
+                if (fvField(*iu) == fvField(fv))
+                    iu = existing_values.erase(iu);
+                else
+                    iu++;
+            }
+            existing_values.push_back(fv);
+        }
+        m.erase(iter);
+        m.emplace(key, KeyOpFieldsValuesTuple(key, SET_COMMAND, existing_values));
+    }
+
+    /*
+     * Compare the task queue with the std::multimap SyncMap at 1M keys:
+     * enqueue a SET per key, merge a second SET into each of them, then drain.
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST(SyncQueueTest, DISABLED_BenchmarkAgainstMultimap)
+    {
+        const size_t count = 1000000;
+        vector<KeyOpFieldsValuesTuple> tasks;
+        vector<KeyOpFieldsValuesTuple> updates;
+        tasks.reserve(count);
+        updates.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            string key = "Ethernet" + to_string(i % 512) + ":10." + to_string(i / 65536) + "." + to_string((i / 256) % 256) + "." + to_string(i % 256) + "/32";
+            tasks.push_back(makeTask(key, SET_COMMAND, { { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } }));
+            updates.push_back(makeTask(key, SET_COMMAND, { { "nexthop", "10.0.0.2" } }));
+        }
+
+        auto elapsed = [](chrono::steady_clock::time_point start)
+        {
+            return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+        };
+
+        auto run = [&](const char *name, function<void(const KeyOpFieldsValuesTuple &)> add, function<void()> drain)
+        {
+            auto start = chrono::steady_clock::now();
+            for (auto &t : tasks)
+            {
+                add(t);
+            }
+            auto enqueue = elapsed(start);
+
+            start = chrono::steady_clock::now();
+            for (auto &t : updates)
+            {
+                add(t);
+            }
+            auto merge = elapsed(start);
+
+            start = chrono::steady_clock::now();
+            drain();
+            cout << name << ": enqueue " << enqueue << " ms, merge " << merge
+                 << " ms, drain " << elapsed(start) << " ms" << endl;
+        };
+
+        multimap<string, KeyOpFieldsValuesTuple> m;
+        run("multimap",
+            [&](const KeyOpFieldsValuesTuple &t) { addToMultimap(m, t); },
+            [&]() {
+                auto it = m.begin();
+                while (it != m.end())
+                {
+                    it = m.erase(it);
+                }
+            });
+
+        SyncQueue q;
+        run("SyncQueue",
+            [&](const KeyOpFieldsValuesTuple &t) { q.add(t); },
+            [&]() {
+                ASSERT_EQ(q.size(), count);
+                ASSERT_EQ(kfvFieldsValues(q.begin()->second).size(), 2);
+                auto it = q.begin();
+                while (it != q.end())
+                {
+                    it = q.erase(it);
+                }
+            });
+
+        EXPECT_TRUE(m.empty());
+        EXPECT_TRUE(q.empty());
+    }
+}